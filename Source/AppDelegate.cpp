@@ -25,9 +25,16 @@
 
 #include "AppDelegate.h"
 #include "GameManager.h"
+#include "LevelCache.h"
 #include "ResourcesLoadingLayer.h"
 #include "external/constants.h"
 #include "GameToolbox/log.h"
+#include "Training/EpisodeSummaryLog.h"
+#include "Training/EventChannel.h"
+#include "Training/InputChannel.h"
+#include "Training/ObservationChannel.h"
+#include "Training/ReplayLog.h"
+#include "Training/TrainingOptions.h"
 
 #include "platform/GLView.h"
 #include "base/Director.h"
@@ -176,6 +183,31 @@ bool AppDelegate::applicationDidFinishLaunching()
 
 	register_all_packages();
 
+	// set by the trainer, see TrainingOptions::parseCommandLine
+	auto options = TrainingOptions::getInstance();
+	if (!options->_observationShm.empty())
+	{
+		ObservationChannel::getInstance()->open(options->_observationShm);
+		ObservationChannel::getInstance()->setActionRepeat(options->_actionRepeat);
+	}
+	if (!options->_inputShm.empty())
+		InputChannel::getInstance()->open(options->_inputShm);
+	if (!options->_eventShm.empty())
+		EventChannel::getInstance()->open(options->_eventShm);
+	if (!options->_summaryFile.empty())
+		EpisodeSummaryLog::getInstance()->open(options->_summaryFile);
+	if (!options->_levelCacheDir.empty())
+		LevelCache::getInstance()->setDirectory(options->_levelCacheDir);
+	if (!options->_replayDir.empty())
+		ReplayLog::getInstance()->open(options->_replayDir);
+
+	// draw as fast as the simulation allows, PlayLayer runs many ticks per frame
+	if (options->_fastForward)
+	{
+		director->setStatsDisplay(false);
+		director->setAnimationInterval(1.0f / 1000.0f);
+	}
+
 	// create a scene. it's an autorelease object
 	director->runWithScene(ResourcesLoadingLayer::scene());
 
@@ -19,6 +19,8 @@
 #include "BaseGameLayer.h"
 #include "EffectGameObject.h"
 #include "GJGameLevel.h"
+#include "LevelCache.h"
+#include "LevelObjectList.h"
 #include "GameToolbox/conv.h"
 #include "GameToolbox/log.h"
 #include "external/benchmark.h"
@@ -73,19 +75,15 @@ void BaseGameLayer::loadLevel()
 {
 	// TODO: find a modern gzip decompress library or write own gzip decompress
 
-	std::string levelStr = _level->_levelString;
-	if (levelStr.empty())
-	{
-		nlohmann::json file =
-			nlohmann::json::parse(FileUtils::getInstance()->getStringFromFile("Custom/mainLevels.json"));
-		std::string levelID = std::to_string(_level->_levelID);
+	std::string_view compressed = _level->_levelString;
+	if (compressed.empty())
+		compressed = LevelCache::getInstance()->getMainLevel(_level->_levelID);
 
-		if (!file.contains(levelID))
-			return; // check if our level actually exists in mainlevels list before doing anything
+	auto cached = LevelCache::getInstance()->get(_level->_levelID, compressed);
+	if (!cached)
+		return; // check if our level actually exists in mainlevels list before doing anything
 
-		levelStr = fmt::format("H4sIAAAAAAAAA{}", file.at(levelID).get<std::string>());
-	}
-	levelStr = GJGameLevel::decompressLvlStr(levelStr);
+	std::string_view levelStr = cached->getLevelString();
 	{
 		auto s = BenchmarkTimer("load level");
 		setupLevel(levelStr);
@@ -217,23 +215,20 @@ void BaseGameLayer::createObjectsFromSetup(std::string_view uncompressedLevelStr
 {
 	//TODO: this function should only recieve vector of game object strings
 	
-	std::vector<std::string_view> objData = GameToolbox::splitByDelimStringView(uncompressedLevelString, ';');
+	size_t headerEnd = uncompressedLevelString.find(';');
+	if (headerEnd == std::string_view::npos)
+		return;
 
-	_allObjects.reserve(objData.size());
+	// parsing runs on every core, creating the sprites has to stay on this thread and in order
+	LevelObjectList objects = LevelObjectList::parse(uncompressedLevelString.substr(headerEnd + 1));
 
-	objData.erase(objData.begin());
+	_allObjects.reserve(objects.size());
 
-	//theres prob a better way to do this but this works for now
-	if(const auto& last = objData.back(); last.front() != '1' || last[1] != ',')
-	{
-		objData.pop_back();
-	}
-	
 	GameToolbox::log("creating & pushing");
 
-	for (const auto& objectDataSpecific : objData)
+	for (size_t i = 0; i < objects.size(); i++)
 	{
-		GameObject* obj = GameObject::createFromString(objectDataSpecific);
+		GameObject* obj = GameObject::createFromDescriptor(objects, i);
 		if (obj)
 		{
 			obj->_uniqueID = static_cast<int>(_allObjects.size());
@@ -481,30 +476,34 @@ void BaseGameLayer::processMoveActions(float dt)
 				if (x != 0)
 				{
 					obj->_startPosOffset.x += x;
-
-					int sectionSize = this->_sectionObjects.size();
-					auto section = BaseGameLayer::sectionForPos(obj->_startPosition.x + obj->_startPosOffset.x);
-					section = section - 1 < 0 ? 0 : section - 1;
-					if (obj->_section != section)
-					{
-						auto vec = &this->_sectionObjects[obj->_section];
-						auto newEnd = std::partition(vec->begin(), vec->end(), [&](GameObject* a) { return a != obj; });
-						vec->resize(newEnd - vec->begin());
-						while (section >= sectionSize)
-						{
-							std::vector<GameObject*> vec;
-							this->_sectionObjects.push_back(vec);
-							sectionSize++;
-						}
-						this->_sectionObjects[section].push_back(obj);
-						obj->_section = section;
-					}
+					updateObjectSection(obj);
 				}
 			}
 		}
 	}
 }
 
+void BaseGameLayer::updateObjectSection(GameObject* obj)
+{
+	int sectionSize = this->_sectionObjects.size();
+	auto section = BaseGameLayer::sectionForPos(obj->_startPosition.x + obj->_startPosOffset.x);
+	section = section - 1 < 0 ? 0 : section - 1;
+	if (obj->_section != section)
+	{
+		auto vec = &this->_sectionObjects[obj->_section];
+		auto newEnd = std::partition(vec->begin(), vec->end(), [&](GameObject* a) { return a != obj; });
+		vec->resize(newEnd - vec->begin());
+		while (section >= sectionSize)
+		{
+			std::vector<GameObject*> vec;
+			this->_sectionObjects.push_back(vec);
+			sectionSize++;
+		}
+		this->_sectionObjects[section].push_back(obj);
+		obj->_section = section;
+	}
+}
+
 void BaseGameLayer::runMoveCommand(float duration, ax::Point offsetPos, int easeType, float easeAmt, int groupID)
 {
 	this->_effectManager->runMoveCommand(duration, offsetPos, easeType, easeAmt, groupID);
@@ -126,6 +126,8 @@ public:
 	void processMoveActions(float dt);
 	void runMoveCommand(float duration, ax::Point offsetPos, int easeType, float easeAmt, int groupID);
 	void processMoveActionsStep(float dt);
+	// moves obj into the _sectionObjects bucket its offset position falls in
+	void updateObjectSection(GameObject* obj);
 
 	ax::Color3B getLightBG(ax::Color3B bg, ax::Color3B p1);
 };
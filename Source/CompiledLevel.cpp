@@ -0,0 +1,410 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "CompiledLevel.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#include "GameToolbox/conv.h"
+#include "GameToolbox/tokenizer.h"
+
+static_assert(sizeof(CompiledLevelHeader) == 52, "CompiledLevelHeader has padding");
+static_assert(sizeof(CompiledColorChannel) == 12, "CompiledColorChannel has padding");
+static_assert(sizeof(LevelObjectProperty) == 20 && std::is_trivially_copyable_v<LevelObjectProperty>);
+static_assert(sizeof(GDHSV) == 16 && std::is_trivially_copyable_v<GDHSV>);
+
+namespace
+{
+CompiledColorChannel* findChannel(std::vector<CompiledColorChannel>& channels, int id)
+{
+	auto it = std::find_if(channels.begin(), channels.end(), [id](const CompiledColorChannel& c) { return c._id == id; });
+	return it == channels.end() ? nullptr : &*it;
+}
+
+// same as PlayLayer::loadLevel: an existing channel is never replaced, only its green and blue change
+void setChannelComponent(std::vector<CompiledColorChannel>& channels, int id, int component, std::string_view value)
+{
+	CompiledColorChannel* channel = findChannel(channels, id);
+	if (component == 1)
+	{
+		if (!channel)
+			channels.push_back({id, 255.f, static_cast<uint8_t>(GameToolbox::stof(value)), 0, 0, 0});
+	}
+	else if (channel)
+		(component == 2 ? channel->_g : channel->_b) = static_cast<uint8_t>(GameToolbox::stof(value));
+}
+
+// kS29 and the other '_' separated channels, see BaseGameLayer::fillColorChannel
+void readChannel(std::vector<CompiledColorChannel>& channels, int id, std::string_view value)
+{
+	for (auto [key, component] : GameToolbox::KeyValues(value, '_'))
+	{
+		int which = GameToolbox::stoi(key);
+		if (which >= 1 && which <= 3)
+			setChannelComponent(channels, id, which, component);
+	}
+}
+
+// the '|' separated kS38 list
+void readChannelList(std::vector<CompiledColorChannel>& channels, std::string_view value)
+{
+	for (std::string_view colorData : GameToolbox::Tokens(value, '|'))
+	{
+		CompiledColorChannel channel = {-1, 255.f, 0, 0, 0, 0};
+		bool hasID = false;
+		for (auto [key, component] : GameToolbox::KeyValues(colorData, '_'))
+		{
+			switch (GameToolbox::stoi(key))
+			{
+			case 1:
+				channel._r = static_cast<uint8_t>(GameToolbox::stof(component));
+				break;
+			case 2:
+				channel._g = static_cast<uint8_t>(GameToolbox::stof(component));
+				break;
+			case 3:
+				channel._b = static_cast<uint8_t>(GameToolbox::stof(component));
+				break;
+			case 5:
+				channel._blending = GameToolbox::stoi(component) != 0;
+				break;
+			case 6:
+				channel._id = GameToolbox::stoi(component);
+				hasID = true;
+				break;
+			case 7:
+				channel._opacity = GameToolbox::stof(component) * 255.f;
+				break;
+			}
+		}
+
+		if (hasID && !findChannel(channels, channel._id))
+			channels.push_back(channel);
+	}
+}
+
+void readHeader(std::string_view header, CompiledLevelHeader& out, std::vector<CompiledColorChannel>& channels)
+{
+	for (auto [key, value] : GameToolbox::KeyValues(header))
+	{
+		if (key.size() < 3 || key[0] != 'k')
+			continue;
+
+		int number = GameToolbox::stoi(key.substr(2));
+		if (key[1] == 'S')
+		{
+			switch (number)
+			{
+			case 1:
+			case 2:
+			case 3:
+				setChannelComponent(channels, 1000, number, value);
+				break;
+			case 4:
+			case 5:
+			case 6:
+				setChannelComponent(channels, 1001, number - 3, value);
+				break;
+			case 29:
+				readChannel(channels, 1000, value);
+				break;
+			case 30:
+				readChannel(channels, 1001, value);
+				break;
+			case 31:
+				readChannel(channels, 1002, value);
+				break;
+			case 32:
+				readChannel(channels, 1004, value);
+				break;
+			case 37:
+				readChannel(channels, 1003, value);
+				break;
+			case 38:
+				readChannelList(channels, value);
+				break;
+			}
+		}
+		else if (key[1] == 'A')
+		{
+			switch (number)
+			{
+			case 2:
+				out._gamemode = GameToolbox::stoi(value);
+				break;
+			case 3:
+				out._mini = GameToolbox::stoi(value) != 0;
+				break;
+			case 4:
+				out._speed = GameToolbox::stoi(value);
+				break;
+			case 6:
+				out._bgID = GameToolbox::stoi(value);
+				if (!out._bgID)
+					out._bgID = 1;
+				break;
+			case 7:
+				out._groundID = GameToolbox::stoi(value);
+				if (!out._groundID)
+					out._groundID = 1;
+				break;
+			case 8:
+				out._dual = GameToolbox::stoi(value) != 0;
+				break;
+			case 10:
+				out._twoPlayer = GameToolbox::stoi(value) != 0;
+				break;
+			case 11:
+				out._flipGravity = GameToolbox::stoi(value) != 0;
+				break;
+			case 13:
+				out._songOffset = GameToolbox::stof(value);
+				break;
+			}
+		}
+	}
+}
+
+template <typename T> void writeSection(std::vector<uint8_t>& out, size_t offset, const std::vector<T>& values)
+{
+	if (!values.empty())
+		std::memcpy(out.data() + offset, values.data(), values.size() * sizeof(T));
+}
+} // namespace
+
+std::vector<uint8_t> CompiledLevel::compile(std::string_view levelString, unsigned threads)
+{
+	size_t headerEnd = levelString.find(';');
+	std::string_view objectString =
+		headerEnd == std::string_view::npos ? std::string_view() : levelString.substr(headerEnd + 1);
+
+	LevelObjectList objects = LevelObjectList::parse(objectString, threads);
+
+	CompiledLevelHeader header;
+	std::memset(&header, 0, sizeof(header));
+	header._magic = kMagic;
+	header._version = kVersion;
+	header._headerSize = sizeof(CompiledLevelHeader);
+	header._bgID = 1;
+	header._groundID = 1;
+
+	std::vector<CompiledColorChannel> channels;
+	readHeader(levelString.substr(0, headerEnd), header, channels);
+
+	size_t count = objects.size();
+	std::vector<int32_t> ids(count), zLayers(count, kNotSet), mainColors(count, kNotSet),
+		secColors(count, kNotSet);
+	std::vector<float> xs(count, 0.f), ys(count, 0.f), rotations(count, 0.f), scaleXs(count, 1.f), scaleYs(count, 1.f);
+	std::vector<uint32_t> groupStart, propertyStart;
+	std::vector<int32_t> groups;
+	std::vector<LevelObjectProperty> properties;
+	groupStart.reserve(count + 1);
+	propertyStart.reserve(count + 1);
+	properties.reserve(objects._properties.size() / 2);
+	groups.reserve(objects._groups.size());
+
+	for (size_t i = 0; i < count; i++)
+	{
+		groupStart.push_back(static_cast<uint32_t>(groups.size()));
+		propertyStart.push_back(static_cast<uint32_t>(properties.size()));
+		ids[i] = objects._objects[i]._objectID;
+
+		// folded the way PlayLayer::loadLevel applies them one after the other
+		for (const LevelObjectProperty& property : objects.getProperties(i))
+		{
+			switch (property._key)
+			{
+			case 1:
+				break;
+			case 2:
+				xs[i] = property._float;
+				break;
+			case 3:
+				ys[i] = property._float + 90.0f;
+				break;
+			case 4:
+				scaleXs[i] = -1.f * property._int;
+				break;
+			case 5:
+				scaleYs[i] = -1.f * property._int;
+				break;
+			case 6:
+				rotations[i] = property._float;
+				break;
+			case 21:
+				mainColors[i] = property._int;
+				break;
+			case 22:
+				secColors[i] = property._int;
+				break;
+			case 24:
+				zLayers[i] = property._int;
+				break;
+			case 32:
+				scaleXs[i] *= property._float;
+				scaleYs[i] *= property._float;
+				break;
+			case 57: {
+				auto objectGroups = objects.getGroups(property);
+				groups.insert(groups.end(), objectGroups.begin(), objectGroups.end());
+				break;
+			}
+			default:
+				properties.push_back(property);
+				break;
+			}
+		}
+	}
+	groupStart.push_back(static_cast<uint32_t>(groups.size()));
+	propertyStart.push_back(static_cast<uint32_t>(properties.size()));
+
+	header._objectCount = static_cast<uint32_t>(count);
+	header._colorCount = static_cast<uint32_t>(channels.size());
+	header._groupCount = static_cast<uint32_t>(groups.size());
+	header._propertyCount = static_cast<uint32_t>(properties.size());
+	header._hsvCount = static_cast<uint32_t>(objects._hsv.size());
+
+	size_t offsets[kSectionCount];
+	std::vector<uint8_t> out(computeLayout(header, offsets), 0);
+
+	std::memcpy(out.data(), &header, sizeof(header));
+	writeSection(out, offsets[kSectionColors], channels);
+	writeSection(out, offsets[kSectionIDs], ids);
+	writeSection(out, offsets[kSectionX], xs);
+	writeSection(out, offsets[kSectionY], ys);
+	writeSection(out, offsets[kSectionRotation], rotations);
+	writeSection(out, offsets[kSectionScaleX], scaleXs);
+	writeSection(out, offsets[kSectionScaleY], scaleYs);
+	writeSection(out, offsets[kSectionZLayer], zLayers);
+	writeSection(out, offsets[kSectionMainColor], mainColors);
+	writeSection(out, offsets[kSectionSecColor], secColors);
+	writeSection(out, offsets[kSectionGroupStart], groupStart);
+	writeSection(out, offsets[kSectionGroups], groups);
+	writeSection(out, offsets[kSectionPropertyStart], propertyStart);
+	writeSection(out, offsets[kSectionProperties], properties);
+
+	// field by field, the padding of GDHSV stays zero and the same level always gives the same file
+	uint8_t* hsvOut = out.data() + offsets[kSectionHSV];
+	for (const GDHSV& hsv : objects._hsv)
+	{
+		std::memcpy(hsvOut + offsetof(GDHSV, h), &hsv.h, sizeof(hsv.h));
+		std::memcpy(hsvOut + offsetof(GDHSV, s), &hsv.s, sizeof(hsv.s));
+		std::memcpy(hsvOut + offsetof(GDHSV, v), &hsv.v, sizeof(hsv.v));
+		std::memcpy(hsvOut + offsetof(GDHSV, sChecked), &hsv.sChecked, sizeof(hsv.sChecked));
+		std::memcpy(hsvOut + offsetof(GDHSV, vChecked), &hsv.vChecked, sizeof(hsv.vChecked));
+		hsvOut += sizeof(GDHSV);
+	}
+
+	return out;
+}
+
+bool CompiledLevel::open(const std::string& path)
+{
+	_buffer.clear();
+	if (!_mapped.open(path))
+		return false;
+
+	if (bind(reinterpret_cast<const uint8_t*>(_mapped.data()), _mapped.size()))
+		return true;
+
+	_mapped.close();
+	return false;
+}
+
+bool CompiledLevel::load(std::vector<uint8_t> data)
+{
+	_mapped.close();
+	_buffer = std::move(data);
+	if (bind(_buffer.data(), _buffer.size()))
+		return true;
+
+	_buffer.clear();
+	return false;
+}
+
+size_t CompiledLevel::computeLayout(const CompiledLevelHeader& header, size_t (&offsets)[kSectionCount])
+{
+	size_t objects = header._objectCount;
+	const size_t sizes[kSectionCount] = {
+		header._colorCount * sizeof(CompiledColorChannel),
+		objects * sizeof(int32_t), // ids
+		objects * sizeof(float),   // x
+		objects * sizeof(float),   // y
+		objects * sizeof(float),   // rotation
+		objects * sizeof(float),   // scale x
+		objects * sizeof(float),   // scale y
+		objects * sizeof(int32_t), // z layer
+		objects * sizeof(int32_t), // main colour
+		objects * sizeof(int32_t), // secondary colour
+		(objects + 1) * sizeof(uint32_t),
+		header._groupCount * sizeof(int32_t),
+		(objects + 1) * sizeof(uint32_t),
+		header._propertyCount * sizeof(LevelObjectProperty),
+		header._hsvCount * sizeof(GDHSV),
+	};
+
+	size_t offset = sizeof(CompiledLevelHeader);
+	for (int i = 0; i < kSectionCount; i++)
+	{
+		offset = (offset + 7) & ~size_t(7);
+		offsets[i] = offset;
+		offset += sizes[i];
+	}
+	return offset;
+}
+
+bool CompiledLevel::bind(const uint8_t* data, size_t size)
+{
+	_data = nullptr;
+	_size = 0;
+
+	if (size < sizeof(CompiledLevelHeader))
+		return false;
+
+	CompiledLevelHeader header;
+	std::memcpy(&header, data, sizeof(header));
+	if (header._magic != kMagic || header._version != kVersion || header._headerSize != sizeof(CompiledLevelHeader) ||
+		computeLayout(header, _offsets) != size)
+		return false;
+
+	_data = data;
+	_size = size;
+
+	// the ranges and HSV indices are used without checks later, a damaged file must not get that far
+	auto checkStarts = [this](Section which, uint32_t total) {
+		auto starts = section<uint32_t>(which, this->size() + 1);
+		return starts.front() == 0 && starts.back() == total && std::is_sorted(starts.begin(), starts.end());
+	};
+	bool valid = checkStarts(kSectionGroupStart, header._groupCount) &&
+				 checkStarts(kSectionPropertyStart, header._propertyCount);
+
+	for (const LevelObjectProperty& property : section<LevelObjectProperty>(kSectionProperties, header._propertyCount))
+	{
+		if ((property._key == 43 || property._key == 44 || property._key == 49) && property._first >= header._hsvCount)
+			valid = false;
+	}
+
+	if (!valid)
+	{
+		_data = nullptr;
+		_size = 0;
+	}
+	return valid;
+}
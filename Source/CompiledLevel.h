@@ -0,0 +1,161 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "GameToolbox/mappedFile.h"
+#include "LevelObjectList.h"
+
+// the level settings PlayLayer::loadLevel reads from the header keys, already converted
+struct CompiledLevelHeader
+{
+	uint32_t _magic;
+	uint16_t _version;
+	uint16_t _headerSize;
+	uint32_t _objectCount;
+	uint32_t _colorCount;
+	uint32_t _groupCount;
+	uint32_t _propertyCount;
+	uint32_t _hsvCount;
+	int32_t _gamemode;	  // kA2
+	int32_t _speed;		  // kA4
+	int32_t _bgID;		  // kA6, 1 when missing or 0
+	int32_t _groundID;	  // kA7, same
+	float _songOffset;	  // kA13
+	uint8_t _mini;		  // kA3
+	uint8_t _dual;		  // kA8
+	uint8_t _twoPlayer;	  // kA10
+	uint8_t _flipGravity; // kA11
+};
+
+// one colour channel of the header, from kS1 to kS6, kS29 to kS37 or the kS38 list
+struct CompiledColorChannel
+{
+	int32_t _id;
+	float _opacity;
+	uint8_t _r, _g, _b;
+	uint8_t _blending;
+};
+
+// A level string converted once into arrays that can be used in place. The file is the header,
+// the colour channels, then one array per object field, each starting on an 8 byte boundary:
+// id, x, y, rotation, scale x, scale y, z layer, main and secondary colour channel, the group
+// ranges and the remaining properties. Loading a level is then mapping the file and walking
+// the arrays, no text is parsed. Files of another version are refused and compiled again.
+class CompiledLevel
+{
+  public:
+	static constexpr uint32_t kMagic = 0x4C44474F; // "OGDL"
+	static constexpr uint16_t kVersion = 2;
+	// z layer and colour channel of an object whose string doesn't set them, it keeps the defaults
+	// customSetup gave it
+	static constexpr int32_t kNotSet = INT32_MIN;
+
+	// the uncompressed level string in the binary form, threads as in LevelObjectList::parse
+	static std::vector<uint8_t> compile(std::string_view levelString, unsigned threads = 0);
+
+	// maps a file written from compile, false if it can't be read or isn't a valid one
+	bool open(const std::string& path);
+	// same for data kept in memory
+	bool load(std::vector<uint8_t> data);
+
+	bool isOpen() const { return _data != nullptr; }
+	const uint8_t* data() const { return _data; }
+	size_t getDataSize() const { return _size; }
+
+	const CompiledLevelHeader& getHeader() const { return *reinterpret_cast<const CompiledLevelHeader*>(_data); }
+	size_t size() const { return getHeader()._objectCount; }
+
+	std::span<const CompiledColorChannel> getColorChannels() const
+	{
+		return section<CompiledColorChannel>(kSectionColors, getHeader()._colorCount);
+	}
+
+	// objects in level string order, the ones without an id (key 1) first are left out
+	std::span<const int32_t> getIDs() const { return section<int32_t>(kSectionIDs, size()); }
+	// key 2 and 3, y with the 90 units PlayLayer adds for the ground, 0 when missing
+	std::span<const float> getX() const { return section<float>(kSectionX, size()); }
+	std::span<const float> getY() const { return section<float>(kSectionY, size()); }
+	std::span<const float> getRotation() const { return section<float>(kSectionRotation, size()); }
+	// key 4 and 5 flip the object, the sign here, multiplied by the key 32 scale
+	std::span<const float> getScaleX() const { return section<float>(kSectionScaleX, size()); }
+	std::span<const float> getScaleY() const { return section<float>(kSectionScaleY, size()); }
+	// kNotSet for keys 24, 21 and 22 when the object doesn't have them
+	std::span<const int32_t> getZLayer() const { return section<int32_t>(kSectionZLayer, size()); }
+	std::span<const int32_t> getMainColor() const { return section<int32_t>(kSectionMainColor, size()); }
+	std::span<const int32_t> getSecColor() const { return section<int32_t>(kSectionSecColor, size()); }
+
+	// key 57 of object i
+	std::span<const int32_t> getGroups(size_t index) const { return range<int32_t>(kSectionGroupStart, kSectionGroups, index); }
+
+	// every other key of object i in string order. HSV values point into getHSV like in LevelObjectList
+	std::span<const LevelObjectProperty> getProperties(size_t index) const
+	{
+		return range<LevelObjectProperty>(kSectionPropertyStart, kSectionProperties, index);
+	}
+	std::span<const GDHSV> getHSV() const { return section<GDHSV>(kSectionHSV, getHeader()._hsvCount); }
+
+  private:
+	enum Section
+	{
+		kSectionColors,
+		kSectionIDs,
+		kSectionX,
+		kSectionY,
+		kSectionRotation,
+		kSectionScaleX,
+		kSectionScaleY,
+		kSectionZLayer,
+		kSectionMainColor,
+		kSectionSecColor,
+		kSectionGroupStart, // size() + 1 offsets into kSectionGroups
+		kSectionGroups,
+		kSectionPropertyStart, // same for kSectionProperties
+		kSectionProperties,
+		kSectionHSV,
+		kSectionCount
+	};
+
+	GameToolbox::MappedFile _mapped;
+	std::vector<uint8_t> _buffer;
+	const uint8_t* _data = nullptr;
+	size_t _size = 0;
+	size_t _offsets[kSectionCount] = {};
+
+	// offset of every section for these counts, returns the size of the whole file
+	static size_t computeLayout(const CompiledLevelHeader& header, size_t (&offsets)[kSectionCount]);
+
+	bool bind(const uint8_t* data, size_t size);
+
+	template <typename T> std::span<const T> section(Section which, size_t count) const
+	{
+		return {reinterpret_cast<const T*>(_data + _offsets[which]), count};
+	}
+	template <typename T> std::span<const T> range(Section starts, Section values, size_t index) const
+	{
+		auto start = section<uint32_t>(starts, size() + 1);
+		return {reinterpret_cast<const T*>(_data + _offsets[values]) + start[index], start[index + 1] - start[index]};
+	}
+};
@@ -19,15 +19,47 @@
 #include "GJGameLevel.h"
 #include "GameToolbox/conv.h"
 
-#include "external/base64.h"
+#include "GameToolbox/base64.h"
+#include "GameToolbox/log.h"
 
-#include <ZipUtils.h>
+#include <algorithm>
+#include <zlib.h>
 
 //the only thing we actually want as normal string is the class members
 static inline std::string _toString(std::string_view s) {
 	return {s.begin(), s.end()};
 }
 
+// base64 characters decoded and handed to zlib at a time
+static constexpr size_t kDecodeBlockSize = 16 * 1024;
+
+// gzip streams (H4sI in base64) end with the uncompressed size, decoded from the last few characters
+// it gives the output its exact size up front. Anything else gets a guess that grows while inflating
+static size_t inflatedSizeHint(std::string_view compressed)
+{
+	size_t guess = std::max<size_t>(compressed.size() * 4, 4096);
+
+	size_t length = std::min(compressed.find('='), compressed.size());
+	if (!compressed.starts_with("H4sI") || length < 32)
+		return guess;
+
+	// whole groups from the start, at least 12 characters so the last 4 bytes are complete
+	size_t start = (length - 12) & ~size_t(3);
+	GameToolbox::Base64Decoder base64;
+	uint8_t tail[GameToolbox::Base64Decoder::maxDecodedSize(16) + 2];
+	size_t decoded = base64.decode(compressed.substr(start, length - start), tail);
+	decoded += base64.finish(tail + decoded);
+	if (base64.isDone() || decoded < 4)
+		return guess;
+
+	uint32_t size = tail[decoded - 4] | tail[decoded - 3] << 8 | tail[decoded - 2] << 16 | uint32_t(tail[decoded - 1]) << 24;
+
+	// deflate can't do better than about 1032:1, a bigger size is a damaged or multi member stream
+	if (size == 0 || size / 1032 > compressed.size())
+		return guess;
+	return size;
+}
+
 GJGameLevel* GJGameLevel::createWithResponse(std::string_view backendResponse)
 {
 	GJGameLevel* level = new GJGameLevel();
@@ -111,23 +143,56 @@ GJGameLevel* GJGameLevel::createWithMinimumData(std::string levelName, std::stri
 	return level;
 }
 
-std::string GJGameLevel::decompressLvlStr(std::string compressedLvlStr)
+std::string GJGameLevel::decompressLvlStr(std::string_view compressedLvlStr)
 {
 	if (compressedLvlStr.empty()) return "";
 
-	std::replace(compressedLvlStr.begin(), compressedLvlStr.end(), '_', '/');
-	std::replace(compressedLvlStr.begin(), compressedLvlStr.end(), '-', '+');
+	z_stream stream{};
+	if (inflateInit2(&stream, 15 + 32) != Z_OK) return "";
+
+	std::string levelString(inflatedSizeHint(compressedLvlStr), '\0');
+	size_t written = 0;
+
+	GameToolbox::Base64Decoder base64;
+	uint8_t block[GameToolbox::Base64Decoder::maxDecodedSize(kDecodeBlockSize) + 2];
+
+	int status = Z_OK;
+	for (size_t pos = 0; pos < compressedLvlStr.size() && status == Z_OK && !base64.isDone(); pos += kDecodeBlockSize)
+	{
+		size_t decoded = base64.decode(compressedLvlStr.substr(pos, kDecodeBlockSize), block);
+		if (pos + kDecodeBlockSize >= compressedLvlStr.size() || base64.isDone())
+			decoded += base64.finish(block + decoded);
+
+		stream.next_in = block;
+		stream.avail_in = static_cast<uInt>(decoded);
 
-	std::string decoded = base64_decode(compressedLvlStr);
+		do
+		{
+			if (written == levelString.size())
+				levelString.resize(levelString.size() * 2);
 
-	unsigned char* data = (unsigned char*)decoded.data();
-	unsigned char* a = nullptr;
-	ssize_t deflatedLen = ax::ZipUtils::inflateMemory(data, decoded.length(), &a);
+			stream.next_out = reinterpret_cast<Bytef*>(levelString.data() + written);
+			stream.avail_out = static_cast<uInt>(std::min<size_t>(levelString.size() - written, UINT32_MAX));
+			size_t before = stream.avail_out;
 
-	std::string levelString = (char *)a;
+			status = inflate(&stream, Z_NO_FLUSH);
+			written += before - stream.avail_out;
+		} while (status == Z_OK && (stream.avail_in != 0 || stream.avail_out == 0));
+
+		// every byte of this block is in zlib's window, the next one continues the stream
+		if (status == Z_BUF_ERROR)
+			status = Z_OK;
+	}
 
-	free(a);
+	inflateEnd(&stream);
+
+	if (status != Z_STREAM_END)
+	{
+		GameToolbox::log("decompressLvlStr: inflate stopped with {} after {} bytes", status, written);
+		return "";
+	}
 
+	levelString.resize(written);
 	return levelString;
 }
 
@@ -88,7 +88,9 @@ public:
 	static GJGameLevel *create();
 
 	static std::string getLevelStrFromID(int gdLevelID);
-	static std::string decompressLvlStr(std::string compressedLvlStr);
+	// Base64 (either alphabet) gzip or zlib data in blocks straight into the returned string, which
+	// gzip data sizes exactly up front. Empty if the data is damaged
+	static std::string decompressLvlStr(std::string_view compressedLvlStr);
 	static std::string compressLvlStr(std::string decompressedLvlStr, int gdLevelID);
 
 	static std::string getDifficultySprite(GJGameLevel* level, DifficultyType type = kLevelCell);
@@ -18,7 +18,6 @@
 
 #include "GJUserScore.h"
 
-#include "external/base64.h"
 #include "GameToolbox/conv.h"
 
 static inline std::string _toString(std::string_view s)
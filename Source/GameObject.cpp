@@ -22,6 +22,7 @@
 #include "EffectGameObject.h"
 #include "GameToolbox/conv.h"
 #include "GameToolbox/log.h"
+#include "LevelObjectList.h"
 #include "PlayLayer.h"
 #include "PlayerObject.h"
 #include "platform/FileUtils.h"
@@ -496,13 +497,18 @@ void GameObject::update()
 GameObject* GameObject::createFromString(std::string_view data)
 {
 	// data = 1,2,3,4,5,6,7 where [key,value,key,value]
-	auto properties = GameToolbox::splitByDelimStringView(data, ',');
+	LevelObjectList objects;
+	if (!objects.append(data))
+		return nullptr;
+
+	return createFromDescriptor(objects, 0);
+}
 
+GameObject* GameObject::createFromDescriptor(const LevelObjectList& objects, size_t index)
+{
 	GameObject* obj = nullptr;
 
-	// index 1 is object id
-	// GameToolbox::log("loading: {}", data);
-	int objectID = GameToolbox::stoi(properties[1]);
+	int objectID = objects._objects[index]._objectID;
 
 	if (!GameObject::_pBlocks.contains(objectID))
 		objectID = 1;
@@ -544,50 +550,49 @@ GameObject* GameObject::createFromString(std::string_view data)
 	// TODO: set uniqueID in base layer
 
 	// iterate over every key
-	for (size_t i = 0; i < properties.size() - 1; i += 2)
+	for (const LevelObjectProperty& property : objects.getProperties(index))
 	{
-		int key = GameToolbox::stoi(properties[i]);
-		switch (key)
+		switch (property._key)
 		{
 		case 2:
-			obj->setPositionX(GameToolbox::stof(properties[i + 1]));
+			obj->setPositionX(property._float);
 			break;
 		case 3:
-			obj->setPositionY(GameToolbox::stof(properties[i + 1]) + 90.0f);
+			obj->setPositionY(property._float + 90.0f);
 			break;
 		case 4:
-			obj->setScaleX(-1.f * GameToolbox::stof(properties[i + 1]));
+			obj->setScaleX(-1.f * property._float);
 			break;
 		case 5:
-			obj->setScaleY(-1.f * GameToolbox::stof(properties[i + 1]));
+			obj->setScaleY(-1.f * property._float);
 			break;
 		case 6:
-			obj->setRotation(GameToolbox::stof(properties[i + 1]));
+			obj->setRotation(property._float);
 			break;
 		case 7:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_color.r = GameToolbox::stoi(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_color.r = property._int;
 			break;
 		case 8:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_color.g = GameToolbox::stoi(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_color.g = property._int;
 			break;
 		case 9:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_color.b = GameToolbox::stoi(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_color.b = property._int;
 			break;
 		case 10:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_duration = GameToolbox::stof(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_duration = property._float;
 			break;
 		case 17:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_blending = GameToolbox::stoi(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_blending = property._int;
 		case 20:
-			obj->_editorLayer = GameToolbox::stoi(properties[i + 1]);
+			obj->_editorLayer = property._int;
 			break;
 		case 21:
-			obj->_mainColorChannel = GameToolbox::stoi(properties[i + 1]);
+			obj->_mainColorChannel = property._int;
 			if (!bgl->_colorChannels.contains(obj->_mainColorChannel))
 			{
 				bgl->_colorChannels.insert({obj->_mainColorChannel, SpriteColor(Color3B::WHITE, 255, 0)});
@@ -595,7 +600,7 @@ GameObject* GameObject::createFromString(std::string_view data)
 			}
 			break;
 		case 22:
-			obj->_secColorChannel = GameToolbox::stoi(properties[i + 1]);
+			obj->_secColorChannel = property._int;
 			if (!bgl->_colorChannels.contains(obj->_secColorChannel))
 			{
 				bgl->_colorChannels.insert({obj->_secColorChannel, SpriteColor(Color3B::WHITE, 255, 0)});
@@ -604,115 +609,96 @@ GameObject* GameObject::createFromString(std::string_view data)
 			break;
 		case 23:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_targetColorId = GameToolbox::stoi(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_targetColorId = property._int;
 			break;
 		case 24:
-			obj->_zLayer = GameToolbox::stoi(properties[i + 1]);
+			obj->_zLayer = property._int;
 			break;
 		case 25:
-			obj->setGlobalZOrder(static_cast<float>(GameToolbox::stoi(properties[i + 1])));
+			obj->setGlobalZOrder(static_cast<float>(property._int));
 			break;
 		case 28:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_offset.x = GameToolbox::stof(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_offset.x = property._float;
 			break;
 		case 29:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_offset.y = GameToolbox::stof(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_offset.y = property._float;
 			break;
 		case 30:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_easing = GameToolbox::stoi(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_easing = property._int;
 			break;
 		case 85:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_easeRate = GameToolbox::stof(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_easeRate = property._float;
 			break;
 		case 32:
-			obj->setScaleX(obj->getScaleX() * GameToolbox::stof(properties[i + 1]));
-			obj->setScaleY(obj->getScaleY() * GameToolbox::stof(properties[i + 1]));
+			obj->setScaleX(obj->getScaleX() * property._float);
+			obj->setScaleY(obj->getScaleY() * property._float);
 			break;
 		case 35:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_opacity = GameToolbox::stof(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_opacity = property._float;
 			break;
 		case 41:
-			obj->_mainHSVEnabled = GameToolbox::stoi(properties[i + 1]);
+			obj->_mainHSVEnabled = property._int;
 			break;
 		case 42:
-			obj->_secondaryHSVEnabled = GameToolbox::stoi(properties[i + 1]);
-			break;
-		case 43: {
-			auto hsv = GameToolbox::splitByDelimStringView(properties[i + 1], 'a');
-			obj->_mainHSV.h = GameToolbox::stof(hsv[0]);
-			obj->_mainHSV.s = GameToolbox::stof(hsv[1]);
-			obj->_mainHSV.v = GameToolbox::stof(hsv[2]);
-			obj->_mainHSV.sChecked = GameToolbox::stoi(hsv[3]);
-			obj->_mainHSV.vChecked = GameToolbox::stoi(hsv[4]);
-		}
-		break;
-		case 44: {
-			auto hsv = GameToolbox::splitByDelimStringView(properties[i + 1], 'a');
-			obj->_secondaryHSV.h = GameToolbox::stof(hsv[0]);
-			obj->_secondaryHSV.s = GameToolbox::stof(hsv[1]);
-			obj->_secondaryHSV.v = GameToolbox::stof(hsv[2]);
-			obj->_secondaryHSV.sChecked = GameToolbox::stoi(hsv[3]);
-			obj->_secondaryHSV.vChecked = GameToolbox::stoi(hsv[4]);
-		}
-		break;
+			obj->_secondaryHSVEnabled = property._int;
+			break;
+		case 43:
+			obj->_mainHSV = objects._hsv[property._first];
+			break;
+		case 44:
+			obj->_secondaryHSV = objects._hsv[property._first];
+			break;
 		case 45:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_fadeIn = GameToolbox::stof(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_fadeIn = property._float;
 			break;
 		case 46:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_hold = GameToolbox::stof(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_hold = property._float;
 			break;
 		case 47:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_fadeOut = GameToolbox::stof(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_fadeOut = property._float;
 			break;
 		case 48:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_pulseMode = GameToolbox::stoi(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_pulseMode = property._int;
 			break;
 		case 49: {
 			if (obj->_isTrigger)
 			{
-				auto hsv = GameToolbox::splitByDelimStringView(properties[i + 1], 'a');
-				auto trigger = dynamic_cast<EffectGameObject*>(obj);
-				trigger->_hsv.h = GameToolbox::stof(hsv[0]);
-				trigger->_hsv.s = GameToolbox::stof(hsv[1]);
-				trigger->_hsv.v = GameToolbox::stof(hsv[2]);
-				trigger->_hsv.sChecked = GameToolbox::stoi(hsv[3]);
-				trigger->_hsv.vChecked = GameToolbox::stoi(hsv[4]);
+				dynamic_cast<EffectGameObject*>(obj)->_hsv = objects._hsv[property._first];
 			}
 			break;
 		}
 
 		case 50:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_copiedColorId = GameToolbox::stoi(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_copiedColorId = property._int;
 			break;
 		case 52:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_pulseType = GameToolbox::stoi(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_pulseType = property._int;
 			break;
 		case 51:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_targetGroupId = GameToolbox::stoi(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_targetGroupId = property._int;
 			break;
 		case 56:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_activateGroup = GameToolbox::stoi(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_activateGroup = property._int;
 			break;
 		case 57: {
-			auto groups = GameToolbox::splitByDelimStringView(properties[i + 1], '.');
+			auto groups = objects.getGroups(property);
 			// pre-allocate
 			obj->_groups.reserve(groups.size());
-			for (std::string_view groupStr : groups)
+			for (int group : groups)
 			{
-				int group = GameToolbox::stoi(groupStr);
 				// TODO add groups in derived class
 				PlayLayer::getInstance()->_groups[group]._objects.push_back(obj);
 				obj->_groups.push_back(group);
@@ -721,19 +707,19 @@ GameObject* GameObject::createFromString(std::string_view data)
 		}
 		case 62:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_spawnTriggered = GameToolbox::stoi(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_spawnTriggered = property._int;
 			break;
 		case 63:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_spawnDelay = GameToolbox::stof(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_spawnDelay = property._float;
 			break;
 		case 65:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_mainOnly = GameToolbox::stoi(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_mainOnly = property._int;
 			break;
 		case 66:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_detailOnly = GameToolbox::stoi(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_detailOnly = property._int;
 			break;
 		case 67: // dont enter
 		case 64: // dont exit
@@ -741,7 +727,7 @@ GameObject* GameObject::createFromString(std::string_view data)
 			break;
 		case 87:
 			if (obj->_isTrigger)
-				dynamic_cast<EffectGameObject*>(obj)->_multiTriggered = GameToolbox::stoi(properties[i + 1]);
+				dynamic_cast<EffectGameObject*>(obj)->_multiTriggered = property._int;
 			break;
 		} // switch end
 	}	  // for end
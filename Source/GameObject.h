@@ -31,61 +31,15 @@
 #include "external/json.hpp"
 #include "GDHSV.h"
 #include "GameToolbox/conv.h"
+#include "Simulation/ObjectData.h"
 
+class LevelObjectList;
 class PlayerObject;
 namespace ax 
 { 
 	class ParticleSystemQuad; 
 }
 
-enum GameObjectType
-{
-	kGameObjectTypeSolid = 0,
-	kGameObjectTypeHazard = 2,
-	kGameObjectTypeInverseGravityPortal = 3,
-	kGameObjectTypeNormalGravityPortal = 4,
-	kGameObjectTypeShipPortal = 5,
-	kGameObjectTypeCubePortal = 6,
-	kGameObjectTypeDecoration = 7,
-	kGameObjectTypeYellowJumpPad = 8,
-	kGameObjectTypePinkJumpPad = 9,
-	kGameObjectTypeGravityPad = 10,
-	kGameObjectTypeYellowJumpRing = 11,
-	kGameObjectTypePinkJumpRing = 12,
-	kGameObjectTypeGravityRing = 13,
-	kGameObjectTypeInverseMirrorPortal = 14,
-	kGameObjectTypeNormalMirrorPortal = 15,
-	kGameObjectTypeBallPortal = 16,
-	kGameObjectTypeRegularSizePortal = 17,
-	kGameObjectTypeMiniSizePortal = 18,
-	kGameObjectTypeUfoPortal = 19,
-	kGameObjectTypeModifier = 20,
-	kGameObjectTypeSecretCoin = 22,
-	kGameObjectTypeDualPortal = 23,
-	kGameObjectTypeSoloPortal = 24,
-	kGameObjectTypeSlope = 25,
-	kGameObjectTypeWavePortal = 26,
-	kGameObjectTypeRobotPortal = 27,
-	kGameObjectTypeTeleportPortal = 28,
-	kGameObjectTypeGreenRing = 29,
-	kGameObjectTypeCollectible = 30,
-	kGameObjectTypeUserCoin = 31,
-	kGameObjectTypeDropRing = 32,
-	kGameObjectTypeSpiderPortal = 33,
-	kGameObjectTypeRedJumpPad = 34,
-	kGameObjectTypeRedJumpRing = 35,
-	kGameObjectTypeCustomRing = 36,
-	kGameObjectTypeDashRing = 37,
-	kGameObjectTypeGravityDashRing = 38,
-	kGameObjectTypeCollisionObject = 39,
-	kGameObjectTypeSpecial = 40
-};
-
-struct Hitbox
-{
-	float h, w, x, y;
-};
-
 class GameObject : public ax::Sprite, public ax::ActionTweenDelegate
 {
   private:
@@ -189,17 +143,19 @@ class GameObject : public ax::Sprite, public ax::ActionTweenDelegate
 
 	ax::ParticleSystemQuad* _particle;
 
-	static const std::unordered_map<int, Hitbox, my_string_hash> _pHitboxes;
-	static const std::unordered_map<int, float, my_string_hash> _pHitboxRadius;
+	static const std::unordered_map<int, Hitbox>& _pHitboxes;
+	static const std::unordered_map<int, float>& _pHitboxRadius;
 	// from https://gist.github.com/absoIute/c8fa23c9b2cb39252755465345bc6e35
 	static const std::unordered_map<int, const char*, my_string_hash> _pBlocks;
 
 	static const std::vector<int> _pSolids;
-	static const std::vector<int> _pTriggers;
+	static const std::vector<int>& _pTriggers;
 
 	static GameObject* create(std::string_view frame, std::string_view glowFrame = "");
 	static GameObject* createObject(std::string_view frame, std::string_view glowFrame = "");
 	static GameObject* createFromString(std::string_view data);
+	// object index of a parsed level, on the main thread
+	static GameObject* createFromDescriptor(const LevelObjectList& objects, size_t index);
 	bool init(std::string_view frame, std::string_view glowFrame = "");
 
 	void customSetup();
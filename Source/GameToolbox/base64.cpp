@@ -0,0 +1,486 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "base64.h"
+
+#include <array>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define BASE64_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define BASE64_TARGET(isa)
+#else
+#define BASE64_TARGET(isa) __attribute__((target(isa)))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define BASE64_NEON
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+constexpr char kStandardAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr char kUrlSafeAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// 6 bit value of every character, -1 outside both alphabets
+constexpr std::array<int8_t, 256> kDecodeTable = [] {
+	std::array<int8_t, 256> table{};
+	table.fill(-1);
+	for (int i = 0; i < 26; i++)
+	{
+		table['A' + i] = static_cast<int8_t>(i);
+		table['a' + i] = static_cast<int8_t>(26 + i);
+	}
+	for (int i = 0; i < 10; i++)
+		table['0' + i] = static_cast<int8_t>(52 + i);
+	table['+'] = table['-'] = 62;
+	table['/'] = table['_'] = 63;
+	return table;
+}();
+
+// Kernels work on whole groups, 4 characters in and 3 bytes out. A decode kernel stops before
+// the first group with a character outside both alphabets, leaving it to Base64Decoder::push.
+// Neither writes past groups * 3 or groups * 4, the SIMD loops stop early enough for their
+// wide stores and finish with the scalar one. Both return how many groups were done
+using DecodeKernel = size_t (*)(const unsigned char* in, size_t groups, uint8_t* out);
+using EncodeKernel = size_t (*)(const uint8_t* in, size_t groups, char* out, const char* alphabet);
+
+size_t decodeScalar(const unsigned char* in, size_t groups, uint8_t* out)
+{
+	for (size_t i = 0; i < groups; i++, in += 4, out += 3)
+	{
+		int a = kDecodeTable[in[0]], b = kDecodeTable[in[1]], c = kDecodeTable[in[2]], d = kDecodeTable[in[3]];
+		if ((a | b | c | d) < 0)
+			return i;
+
+		uint32_t value = static_cast<uint32_t>(a) << 18 | b << 12 | c << 6 | d;
+		out[0] = static_cast<uint8_t>(value >> 16);
+		out[1] = static_cast<uint8_t>(value >> 8);
+		out[2] = static_cast<uint8_t>(value);
+	}
+	return groups;
+}
+
+size_t encodeScalar(const uint8_t* in, size_t groups, char* out, const char* alphabet)
+{
+	for (size_t i = 0; i < groups; i++, in += 3, out += 4)
+	{
+		uint32_t value = static_cast<uint32_t>(in[0]) << 16 | in[1] << 8 | in[2];
+		out[0] = alphabet[value >> 18];
+		out[1] = alphabet[value >> 12 & 63];
+		out[2] = alphabet[value >> 6 & 63];
+		out[3] = alphabet[value & 63];
+	}
+	return groups;
+}
+
+#ifdef BASE64_X86
+
+// Muła and Lemire's method: every character is classified with range compares, both alphabets
+// at once, then pairs of 6 bit values are merged with multiply-adds and shuffled into bytes
+
+// all ones where lo <= v <= hi. Signed compares, bytes from 0x80 up are never in a range
+BASE64_TARGET("sse4.1") inline __m128i inRangeSSE(__m128i v, char lo, char hi)
+{
+	return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(lo - 1)), _mm_cmpgt_epi8(_mm_set1_epi8(hi + 1), v));
+}
+
+BASE64_TARGET("avx2") inline __m256i inRangeAVX2(__m256i v, char lo, char hi)
+{
+	return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(lo - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8(hi + 1), v));
+}
+
+BASE64_TARGET("sse4.1") inline __m128i translateSSE(__m128i v, __m128i& valid)
+{
+	__m128i upper = inRangeSSE(v, 'A', 'Z');
+	__m128i lower = inRangeSSE(v, 'a', 'z');
+	__m128i digit = inRangeSSE(v, '0', '9');
+	__m128i s62 = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('+')), _mm_cmpeq_epi8(v, _mm_set1_epi8('-')));
+	__m128i s63 = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('/')), _mm_cmpeq_epi8(v, _mm_set1_epi8('_')));
+	__m128i symbol = _mm_or_si128(s62, s63);
+	valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, symbol));
+
+	__m128i offset = _mm_or_si128(_mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-65)),
+											   _mm_and_si128(lower, _mm_set1_epi8(-71))),
+								  _mm_and_si128(digit, _mm_set1_epi8(4)));
+	__m128i values = _mm_andnot_si128(symbol, _mm_add_epi8(v, offset));
+	return _mm_or_si128(values, _mm_or_si128(_mm_and_si128(s62, _mm_set1_epi8(62)), _mm_and_si128(s63, _mm_set1_epi8(63))));
+}
+
+BASE64_TARGET("sse4.1") inline __m128i packSSE(__m128i values)
+{
+	__m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+	merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+	return _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+BASE64_TARGET("sse4.1") size_t decodeSSE(const unsigned char* in, size_t groups, uint8_t* out)
+{
+	size_t done = 0;
+	// 16 bytes stored for 12, so at least 6 groups of room
+	for (; groups - done >= 6; done += 4)
+	{
+		__m128i valid;
+		__m128i values = translateSSE(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done * 4)), valid);
+		if (_mm_movemask_epi8(valid) != 0xFFFF)
+			return done + decodeScalar(in + done * 4, groups - done, out + done * 3);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + done * 3), packSSE(values));
+	}
+	return done + decodeScalar(in + done * 4, groups - done, out + done * 3);
+}
+
+BASE64_TARGET("sse4.1") inline __m128i unpackSSE(__m128i bytes)
+{
+	__m128i in = _mm_shuffle_epi8(bytes, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+	__m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+	__m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+	return _mm_or_si128(t0, t1);
+}
+
+// index 0 to 63 to its character: the index range picks an offset from lut
+BASE64_TARGET("sse4.1") inline __m128i lookupSSE(__m128i indices, __m128i lut)
+{
+	__m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+	range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+	return _mm_add_epi8(indices, _mm_shuffle_epi8(lut, range));
+}
+
+BASE64_TARGET("sse4.1") inline __m128i encodeLutSSE(const char* alphabet)
+{
+	return _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+						 '0' - 52, '0' - 52, static_cast<char>(alphabet[62] - 62), static_cast<char>(alphabet[63] - 63),
+						 'A', 0, 0);
+}
+
+BASE64_TARGET("sse4.1") size_t encodeSSE(const uint8_t* in, size_t groups, char* out, const char* alphabet)
+{
+	__m128i lut = encodeLutSSE(alphabet);
+	size_t done = 0;
+	// 16 bytes loaded for 12
+	for (; groups - done >= 6; done += 4)
+	{
+		__m128i indices = unpackSSE(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done * 3)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + done * 4), lookupSSE(indices, lut));
+	}
+	return done + encodeScalar(in + done * 3, groups - done, out + done * 4, alphabet);
+}
+
+BASE64_TARGET("avx2") size_t decodeAVX2(const unsigned char* in, size_t groups, uint8_t* out)
+{
+	size_t done = 0;
+	// 32 bytes stored for 24, so at least 11 groups of room
+	for (; groups - done >= 11; done += 8)
+	{
+		__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + done * 4));
+		__m256i upper = inRangeAVX2(v, 'A', 'Z');
+		__m256i lower = inRangeAVX2(v, 'a', 'z');
+		__m256i digit = inRangeAVX2(v, '0', '9');
+		__m256i s62 = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('+')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('-')));
+		__m256i s63 = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('/')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_')));
+		__m256i symbol = _mm256_or_si256(s62, s63);
+		__m256i valid = _mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, symbol));
+		if (_mm256_movemask_epi8(valid) != -1)
+			return done + decodeSSE(in + done * 4, groups - done, out + done * 3);
+
+		__m256i offset = _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(-65)),
+														 _mm256_and_si256(lower, _mm256_set1_epi8(-71))),
+										 _mm256_and_si256(digit, _mm256_set1_epi8(4)));
+		__m256i values = _mm256_andnot_si256(symbol, _mm256_add_epi8(v, offset));
+		values = _mm256_or_si256(values, _mm256_or_si256(_mm256_and_si256(s62, _mm256_set1_epi8(62)),
+														 _mm256_and_si256(s63, _mm256_set1_epi8(63))));
+
+		__m256i merged = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+		merged = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+		merged = _mm256_shuffle_epi8(merged, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1,
+															  0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+		// 12 bytes in each 128 bit lane, moved together
+		merged = _mm256_permutevar8x32_epi32(merged, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + done * 3), merged);
+	}
+	return done + decodeSSE(in + done * 4, groups - done, out + done * 3);
+}
+
+BASE64_TARGET("avx2") size_t encodeAVX2(const uint8_t* in, size_t groups, char* out, const char* alphabet)
+{
+	__m128i lut128 = encodeLutSSE(alphabet);
+	__m256i lut = _mm256_broadcastsi128_si256(lut128);
+	size_t done = 0;
+	// two 16 byte loads 12 apart, 28 bytes read for 24
+	for (; groups - done >= 10; done += 8)
+	{
+		const uint8_t* p = in + done * 3;
+		__m256i bytes = _mm256_inserti128_si256(
+			_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 12)), 1);
+
+		bytes = _mm256_shuffle_epi8(bytes, _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1,
+															4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+		__m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(bytes, _mm256_set1_epi32(0x0fc0fc00)),
+										_mm256_set1_epi32(0x04000040));
+		__m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(bytes, _mm256_set1_epi32(0x003f03f0)),
+										_mm256_set1_epi32(0x01000010));
+		__m256i indices = _mm256_or_si256(t0, t1);
+
+		__m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+		range = _mm256_or_si256(
+			range, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + done * 4),
+							_mm256_add_epi8(indices, _mm256_shuffle_epi8(lut, range)));
+	}
+	return done + encodeSSE(in + done * 3, groups - done, out + done * 4, alphabet);
+}
+
+bool cpuHas(const char* isa)
+{
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 1);
+	bool sse41 = info[2] & (1 << 19);
+	bool osSavesAVX = (info[2] & (1 << 27)) && (_xgetbv(0) & 6) == 6;
+	if (isa[0] == 's')
+		return sse41;
+
+	__cpuid(info, 0);
+	if (info[0] < 7 || !osSavesAVX)
+		return false;
+	__cpuidex(info, 7, 0);
+	return info[1] & (1 << 5);
+#else
+	__builtin_cpu_init();
+	return isa[0] == 's' ? __builtin_cpu_supports("sse4.1") : __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // BASE64_X86
+
+#ifdef BASE64_NEON
+
+// every aarch64 CPU has NEON, no runtime check. vld4 and vst3 split and join the groups, so the
+// bytes are put together with plain shifts
+
+size_t decodeNEON(const unsigned char* in, size_t groups, uint8_t* out)
+{
+	auto translate = [](uint8x16_t v, uint8x16_t& invalid) {
+		auto range = [&](uint8_t lo, uint8_t hi) { return vandq_u8(vcgeq_u8(v, vdupq_n_u8(lo)), vcleq_u8(v, vdupq_n_u8(hi))); };
+		uint8x16_t upper = range('A', 'Z');
+		uint8x16_t lower = range('a', 'z');
+		uint8x16_t digit = range('0', '9');
+		uint8x16_t s62 = vorrq_u8(vceqq_u8(v, vdupq_n_u8('+')), vceqq_u8(v, vdupq_n_u8('-')));
+		uint8x16_t s63 = vorrq_u8(vceqq_u8(v, vdupq_n_u8('/')), vceqq_u8(v, vdupq_n_u8('_')));
+		uint8x16_t valid = vorrq_u8(vorrq_u8(upper, lower), vorrq_u8(digit, vorrq_u8(s62, s63)));
+		invalid = vorrq_u8(invalid, vmvnq_u8(valid));
+
+		uint8x16_t offset = vorrq_u8(vorrq_u8(vandq_u8(upper, vdupq_n_u8(static_cast<uint8_t>(-65))),
+											  vandq_u8(lower, vdupq_n_u8(static_cast<uint8_t>(-71)))),
+									 vandq_u8(digit, vdupq_n_u8(4)));
+		uint8x16_t values = vaddq_u8(v, offset);
+		values = vbslq_u8(s62, vdupq_n_u8(62), values);
+		return vbslq_u8(s63, vdupq_n_u8(63), values);
+	};
+
+	size_t done = 0;
+	for (; groups - done >= 16; done += 16)
+	{
+		uint8x16x4_t chars = vld4q_u8(in + done * 4);
+		uint8x16_t invalid = vdupq_n_u8(0);
+		uint8x16_t a = translate(chars.val[0], invalid);
+		uint8x16_t b = translate(chars.val[1], invalid);
+		uint8x16_t c = translate(chars.val[2], invalid);
+		uint8x16_t d = translate(chars.val[3], invalid);
+		if (vmaxvq_u8(invalid))
+			break;
+
+		uint8x16x3_t bytes;
+		bytes.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+		bytes.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+		bytes.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+		vst3q_u8(out + done * 3, bytes);
+	}
+	return done + decodeScalar(in + done * 4, groups - done, out + done * 3);
+}
+
+size_t encodeNEON(const uint8_t* in, size_t groups, char* out, const char* alphabet)
+{
+	auto table = reinterpret_cast<const uint8_t*>(alphabet);
+	uint8x16x4_t lut = {{vld1q_u8(table), vld1q_u8(table + 16), vld1q_u8(table + 32), vld1q_u8(table + 48)}};
+	uint8x16_t mask = vdupq_n_u8(63);
+
+	size_t done = 0;
+	for (; groups - done >= 16; done += 16)
+	{
+		uint8x16x3_t bytes = vld3q_u8(in + done * 3);
+		uint8x16x4_t chars;
+		chars.val[0] = vqtbl4q_u8(lut, vshrq_n_u8(bytes.val[0], 2));
+		chars.val[1] = vqtbl4q_u8(lut, vandq_u8(vorrq_u8(vshlq_n_u8(bytes.val[0], 4), vshrq_n_u8(bytes.val[1], 4)), mask));
+		chars.val[2] = vqtbl4q_u8(lut, vandq_u8(vorrq_u8(vshlq_n_u8(bytes.val[1], 2), vshrq_n_u8(bytes.val[2], 6)), mask));
+		chars.val[3] = vqtbl4q_u8(lut, vandq_u8(bytes.val[2], mask));
+		vst4q_u8(reinterpret_cast<uint8_t*>(out + done * 4), chars);
+	}
+	return done + encodeScalar(in + done * 3, groups - done, out + done * 4, alphabet);
+}
+
+#endif // BASE64_NEON
+
+struct Kernels
+{
+	const char* _name;
+	DecodeKernel _decode;
+	EncodeKernel _encode;
+};
+
+const Kernels& getKernels()
+{
+	static const Kernels kernels = [] {
+#if defined(BASE64_X86)
+		if (cpuHas("avx2"))
+			return Kernels{"avx2", decodeAVX2, encodeAVX2};
+		if (cpuHas("sse4.1"))
+			return Kernels{"sse4.1", decodeSSE, encodeSSE};
+#elif defined(BASE64_NEON)
+		return Kernels{"neon", decodeNEON, encodeNEON};
+#endif
+		return Kernels{"scalar", decodeScalar, encodeScalar};
+	}();
+	return kernels;
+}
+} // namespace
+
+namespace GameToolbox
+{
+	size_t Base64Decoder::decode(std::string_view input, uint8_t* out)
+	{
+		auto p = reinterpret_cast<const unsigned char*>(input.data());
+		auto begin = p;
+		auto end = p + input.size();
+		size_t written = 0;
+
+		// finish the group the last call stopped in
+		while (_pendingCount != 0 && p < end && !_done)
+		{
+			written += push(*p, out + written);
+			p += !_done;
+		}
+
+		// whole groups, the one with an invalid character is left to push
+		if (!_done)
+		{
+			size_t groups = getKernels()._decode(p, (end - p) / 4, out + written);
+			p += groups * 4;
+			written += groups * 3;
+		}
+
+		while (p < end && !_done)
+		{
+			written += push(*p, out + written);
+			p += !_done;
+		}
+
+		_consumed += p - begin;
+		return written;
+	}
+
+	size_t Base64Decoder::finish(uint8_t* out)
+	{
+		size_t written = 0;
+		if (_pendingCount == 2)
+		{
+			out[written++] = static_cast<uint8_t>(_pending >> 4);
+		}
+		else if (_pendingCount == 3)
+		{
+			out[written++] = static_cast<uint8_t>(_pending >> 10);
+			out[written++] = static_cast<uint8_t>(_pending >> 2);
+		}
+
+		_pending = 0;
+		_pendingCount = 0;
+		return written;
+	}
+
+	size_t Base64Decoder::push(unsigned char c, uint8_t* out)
+	{
+		int value = kDecodeTable[c];
+		if (value < 0)
+		{
+			_done = true;
+			_error = c != '=';
+			return 0;
+		}
+
+		_pending = _pending << 6 | value;
+		if (++_pendingCount < 4)
+			return 0;
+
+		out[0] = static_cast<uint8_t>(_pending >> 16);
+		out[1] = static_cast<uint8_t>(_pending >> 8);
+		out[2] = static_cast<uint8_t>(_pending);
+		_pending = 0;
+		_pendingCount = 0;
+		return 3;
+	}
+
+	bool base64Decode(std::string_view encoded, std::string& out)
+	{
+		out.resize(Base64Decoder::maxDecodedSize(encoded.size()));
+		auto data = reinterpret_cast<uint8_t*>(out.data());
+
+		Base64Decoder decoder;
+		size_t written = decoder.decode(encoded, data);
+		written += decoder.finish(data + written);
+		out.resize(written);
+
+		// a lone character in the last group is 6 bits, finish drops it
+		size_t rest = decoder.getConsumed() % 4;
+		if (decoder.hasError() || rest == 1)
+			return false;
+
+		// padding can only end the string
+		std::string_view padding = encoded.substr(decoder.getConsumed());
+		return padding.size() <= 2 && padding.find_first_not_of('=') == std::string_view::npos;
+	}
+
+	std::string base64Encode(std::string_view data, bool urlSafe, bool padding)
+	{
+		const char* alphabet = urlSafe ? kUrlSafeAlphabet : kStandardAlphabet;
+		auto in = reinterpret_cast<const uint8_t*>(data.data());
+
+		size_t groups = data.size() / 3;
+		size_t rest = data.size() - groups * 3;
+		std::string out(groups * 4 + (rest == 0 ? 0 : padding ? 4 : rest + 1), '=');
+
+		getKernels()._encode(in, groups, out.data(), alphabet);
+
+		if (rest != 0)
+		{
+			uint32_t value = static_cast<uint32_t>(in[groups * 3]) << 16 | (rest == 2 ? in[groups * 3 + 1] << 8 : 0);
+			char* tail = out.data() + groups * 4;
+			tail[0] = alphabet[value >> 18];
+			tail[1] = alphabet[value >> 12 & 63];
+			if (rest == 2)
+				tail[2] = alphabet[value >> 6 & 63];
+		}
+		return out;
+	}
+
+	const char* getBase64Kernel()
+	{
+		return getKernels()._name;
+	}
+}
@@ -0,0 +1,71 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace GameToolbox
+{
+	// Base64 decoded in pieces of any size, so a level string can go to zlib a block at a time
+	// without a decoded copy of the whole thing. Takes the standard and the URL-safe alphabet
+	// alike. Like base64_decode it stops at the first '=' or character outside them, and a last
+	// group of 2 or 3 characters gives 1 or 2 bytes. Whole groups go through the widest SIMD
+	// kernel the CPU has, see getBase64Kernel.
+	class Base64Decoder
+	{
+	  public:
+		// most bytes decode can write for n characters, counting the ones held back from the call before
+		static constexpr size_t maxDecodedSize(size_t n) { return (n + 3) / 4 * 3; }
+
+		// every whole group of 4 characters, an incomplete one at the end is held back for the next
+		// call. Returns how many bytes were written to out
+		size_t decode(std::string_view input, uint8_t* out);
+		// the held back characters once the input is over, at most 2 bytes
+		size_t finish(uint8_t* out);
+
+		// an '=' or invalid character was reached, later input is ignored
+		bool isDone() const { return _done; }
+		// it was an invalid one
+		bool hasError() const { return _error; }
+		// characters decoded over every call, the stopping one isn't counted
+		size_t getConsumed() const { return _consumed; }
+
+	  private:
+		uint32_t _pending = 0;
+		int _pendingCount = 0;
+		bool _done = false;
+		bool _error = false;
+		size_t _consumed = 0;
+
+		size_t push(unsigned char c, uint8_t* out);
+	};
+
+	// a whole string of either alphabet. false if it has a character outside both, anything but up
+	// to two '=' after padding starts or a last group of a single character, out then has what was
+	// decoded before that
+	bool base64Decode(std::string_view encoded, std::string& out);
+	// RobTop's level strings and save data use the URL-safe alphabet with padding
+	std::string base64Encode(std::string_view data, bool urlSafe = true, bool padding = true);
+
+	// the kernel picked for this CPU: "avx2", "sse4.1", "neon" or "scalar"
+	const char* getBase64Kernel();
+}
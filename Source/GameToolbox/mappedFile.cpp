@@ -0,0 +1,104 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "mappedFile.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <sstream>
+#endif
+
+namespace GameToolbox
+{
+	MappedFile::~MappedFile()
+	{
+		close();
+	}
+
+#ifndef _WIN32
+
+	bool MappedFile::open(const std::string& path)
+	{
+		close();
+
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return false;
+
+		struct stat st;
+		if (fstat(fd, &st) != 0 || st.st_size <= 0)
+		{
+			::close(fd);
+			return false;
+		}
+
+		void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (data == MAP_FAILED)
+			return false;
+
+		_data = static_cast<const char*>(data);
+		_size = st.st_size;
+		return true;
+	}
+
+	void MappedFile::close()
+	{
+		if (_data && _fallback.empty())
+			munmap(const_cast<char*>(_data), _size);
+
+		_data = nullptr;
+		_size = 0;
+		_fallback.clear();
+	}
+
+#else
+
+	bool MappedFile::open(const std::string& path)
+	{
+		close();
+
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+			return false;
+
+		std::stringstream contents;
+		contents << file.rdbuf();
+		_fallback = contents.str();
+		if (_fallback.empty())
+			return false;
+
+		_data = _fallback.data();
+		_size = _fallback.size();
+		return true;
+	}
+
+	void MappedFile::close()
+	{
+		_data = nullptr;
+		_size = 0;
+		_fallback.clear();
+	}
+
+#endif
+}
@@ -0,0 +1,51 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace GameToolbox
+{
+	// A whole file mapped read-only, every process mapping the same file shares its pages.
+	// Where mmap isn't available the file is read into memory instead.
+	class MappedFile
+	{
+	  public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool open(const std::string& path);
+		void close();
+
+		const char* data() const { return _data; }
+		size_t size() const { return _size; }
+		std::string_view view() const { return {_data, _size}; }
+		bool isOpen() const { return _data != nullptr; }
+
+	  private:
+		const char* _data = nullptr;
+		size_t _size = 0;
+		std::string _fallback;
+	};
+}
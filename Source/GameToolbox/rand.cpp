@@ -17,14 +17,15 @@
 *************************************************************************/
 
 #include "rand.h"
+#include "rng.h"
 #include <random>
 
+// cosmetic randomness only, anything the simulation draws comes from SimWorld::_rng. One generator
+// per thread so environments stepped on a pool don't share or lock one
 int GameToolbox::randomInt(int min, int max) {
-	static std::random_device device;
-	static std::mt19937 generator(device());
-	std::uniform_int_distribution<int> distribution(min, max);
+	thread_local GameToolbox::Rng generator(std::random_device{}() | static_cast<uint64_t>(std::random_device{}()) << 32);
 
-	return distribution(generator);
+	return generator.nextInt(min, max);
 }
 
 int GameToolbox::randomInt(int max) {
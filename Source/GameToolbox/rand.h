@@ -19,6 +19,7 @@
 #pragma once
 #include "Types.h"
 
+// unseeded, for menus and effects. Seeded gameplay randomness is GameToolbox::Rng in rng.h
 namespace GameToolbox
 {
 	int randomInt(int min, int max);
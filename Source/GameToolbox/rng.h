@@ -0,0 +1,70 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace GameToolbox
+{
+	// Small seedable generator (SplitMix64) whose whole state is one integer, so it can live in a
+	// SimWorld, be copied into snapshots and be replayed exactly. Also a UniformRandomBitGenerator
+	// for the <random> distributions.
+	class Rng
+	{
+	  public:
+		using result_type = uint64_t;
+
+		explicit Rng(uint64_t seed = 0) : _state(seed) {}
+
+		void seed(uint64_t seed) { _state = seed; }
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return UINT64_MAX; }
+
+		result_type operator()()
+		{
+			uint64_t z = (_state += 0x9E3779B97F4A7C15ull);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			return z ^ (z >> 31);
+		}
+
+		// [min, max], both ends included like GameToolbox::randomInt
+		int nextInt(int min, int max)
+		{
+			uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+			return static_cast<int>(min + static_cast<int64_t>(((*this)() >> 32) * range >> 32));
+		}
+
+		// [0, 1)
+		float nextFloat() { return static_cast<float>((*this)() >> 40) * 0x1.0p-24f; }
+		float nextFloat(float min, float max) { return min + (max - min) * nextFloat(); }
+
+		// a seed for the index-th of many generators started from one seed, neighbouring
+		// indices give unrelated streams
+		static uint64_t derive(uint64_t seed, uint64_t index)
+		{
+			Rng rng(seed ^ (index * 0xD1B54A32D192ED03ull));
+			return rng();
+		}
+
+	  private:
+		uint64_t _state;
+	};
+}
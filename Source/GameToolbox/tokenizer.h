@@ -0,0 +1,173 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+
+namespace GameToolbox
+{
+	// first delim in [begin, end), end if there is none. memchr is the libc's vectorised scan,
+	// it checks 16 to 64 bytes per instruction where a plain loop checks one
+	inline const char* findDelim(const char* begin, const char* end, char delim)
+	{
+		auto found = static_cast<const char*>(std::memchr(begin, delim, end - begin));
+		return found ? found : end;
+	}
+
+	// The delim separated tokens of a string as views into it, found one at a time while iterating:
+	//   for (std::string_view object : GameToolbox::Tokens(levelString, ';'))
+	// Yields what splitByDelimStringView would without building the vector: nothing for an empty
+	// string and no empty token after a trailing delim.
+	class Tokens
+	{
+	  public:
+		class iterator
+		{
+		  public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = std::string_view;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const std::string_view*;
+			using reference = const std::string_view&;
+
+			iterator() = default;
+			iterator(const char* begin, const char* end, char delim) : _end(end), _delim(delim) { find(begin); }
+
+			reference operator*() const { return _token; }
+			pointer operator->() const { return &_token; }
+
+			iterator& operator++()
+			{
+				find(_token.data() + _token.size() + 1);
+				return *this;
+			}
+			iterator operator++(int)
+			{
+				iterator ret = *this;
+				++*this;
+				return ret;
+			}
+
+			bool operator==(const iterator& other) const { return _token.data() == other._token.data(); }
+
+		  private:
+			std::string_view _token;
+			const char* _end = nullptr;
+			char _delim = 0;
+
+			void find(const char* begin)
+			{
+				if (begin >= _end)
+				{
+					_token = {};
+					return;
+				}
+				_token = std::string_view(begin, findDelim(begin, _end, _delim) - begin);
+			}
+		};
+
+		Tokens(std::string_view str, char delim) : _str(str), _delim(delim) {}
+
+		iterator begin() const { return iterator(_str.data(), _str.data() + _str.size(), _delim); }
+		iterator end() const { return iterator(); }
+
+	  private:
+		std::string_view _str;
+		char _delim;
+	};
+
+	// Alternating keys and values like "1,8,2,45,3,15" as pairs: (1, 8), (2, 45), (3, 15).
+	// A key without a value at the end is dropped, like the i < size() - 1 loops used to.
+	class KeyValues
+	{
+	  public:
+		struct Pair
+		{
+			std::string_view key;
+			std::string_view value;
+		};
+
+		class iterator
+		{
+		  public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = Pair;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const Pair*;
+			using reference = const Pair&;
+
+			iterator() = default;
+			iterator(Tokens::iterator token, Tokens::iterator end) : _token(token), _tokenEnd(end) { read(); }
+
+			reference operator*() const { return _pair; }
+			pointer operator->() const { return &_pair; }
+
+			iterator& operator++()
+			{
+				read();
+				return *this;
+			}
+
+			bool operator==(const iterator& other) const { return _done == other._done && (_done || _token == other._token); }
+
+		  private:
+			Tokens::iterator _token, _tokenEnd;
+			Pair _pair;
+			bool _done = true;
+
+			void read()
+			{
+				_done = _token == _tokenEnd;
+				if (_done)
+					return;
+				_pair.key = *_token++;
+
+				_done = _token == _tokenEnd;
+				if (_done)
+					return;
+				_pair.value = *_token++;
+			}
+		};
+
+		KeyValues(std::string_view str, char delim = ',') : _tokens(str, delim) {}
+
+		iterator begin() const { return iterator(_tokens.begin(), _tokens.end()); }
+		iterator end() const { return iterator(); }
+
+	  private:
+		Tokens _tokens;
+	};
+
+	// the first max tokens into out, for fixed size fields like HSV ("0a1a1a0a0"). Returns how many
+	// there were, the rest of out is left alone
+	inline size_t splitInto(std::string_view str, char delim, std::string_view* out, size_t max)
+	{
+		size_t count = 0;
+		for (std::string_view token : Tokens(str, delim))
+		{
+			if (count == max)
+				break;
+			out[count++] = token;
+		}
+		return count;
+	}
+} // namespace GameToolbox
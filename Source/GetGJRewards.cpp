@@ -18,7 +18,6 @@
 
 #include "GetGJRewards.h"
 
-#include "external/base64.h"
 
 GetGJRewards* GetGJRewards::create() 
 {
@@ -22,7 +22,7 @@
 #include "MenuItemSpriteExtra.h"
 #include <ui/CocosGUI.h>
 #include <ui/UITextField.h>
-#include "external/base64.h"
+#include "GameToolbox/base64.h"
 #include "ButtonSprite.h"
 #include "Director.h"
 #include "2d/Menu.h"
@@ -93,7 +93,10 @@ bool InfoLayer::init(GJGameLevel* level)
 	this->_mainLayer->addChild(levelCreator);
 
 
-	auto desc = level->_description.empty() ? "(No description provided)" : base64_decode(level->_description);
+	// descriptions are URL-safe base64, a damaged one shows what decoded before the damage
+	std::string desc = "(No description provided)";
+	if (!level->_description.empty())
+		GameToolbox::base64Decode(level->_description, desc);
 	
 	auto descField = ax::ui::UICCTextField::createWithBMFont(GameToolbox::getTextureString("chatFont.fnt"), desc, TextHAlignment::CENTER, 380.f);
 	descField->setPosition({ winSize.width / 2, (winSize.height / 2) + 10.f /*+ 20.f */});
@@ -0,0 +1,227 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "LevelCache.h"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+#include "CompiledLevel.h"
+#include "GJGameLevel.h"
+#include "GameToolbox/log.h"
+#include "Simulation/SimLevel.h"
+#include "external/json.hpp"
+#include "platform/FileUtils.h"
+
+LevelCache* LevelCache::getInstance()
+{
+	static LevelCache instance;
+	return &instance;
+}
+
+void LevelCache::setDirectory(std::string_view directory)
+{
+	std::lock_guard lock(_mutex);
+	_directory = directory;
+
+	std::error_code error;
+	if (!_directory.empty() && !std::filesystem::create_directories(_directory, error) && error)
+	{
+		GameToolbox::log("LevelCache: could not create {}, keeping levels in memory", _directory);
+		_directory.clear();
+	}
+}
+
+std::string_view LevelCache::getMainLevel(int levelID)
+{
+	std::lock_guard lock(_mutex);
+
+	if (!_mainLevelsLoaded)
+	{
+		_mainLevelsLoaded = true;
+
+		auto file = nlohmann::json::parse(ax::FileUtils::getInstance()->getStringFromFile("Custom/mainLevels.json"),
+										  nullptr, false);
+		if (file.is_object())
+		{
+			for (auto& [key, value] : file.items())
+			{
+				if (value.is_string())
+					_mainLevels[std::atoi(key.c_str())] = fmt::format("H4sIAAAAAAAAA{}", value.get<std::string>());
+			}
+		}
+	}
+
+	auto it = _mainLevels.find(levelID);
+	return it == _mainLevels.end() ? std::string_view() : it->second;
+}
+
+std::shared_ptr<const CachedLevel> LevelCache::get(int levelID, std::string_view levelString)
+{
+	if (levelString.empty())
+		return nullptr;
+
+	uint64_t contentHash = hash(levelString);
+
+	std::lock_guard lock(_mutex);
+
+	auto it = _levels.find(levelID);
+	if (it != _levels.end() && it->second->_hash == contentHash)
+		return it->second;
+
+	auto level = std::make_shared<CachedLevel>();
+	level->_levelID = levelID;
+	level->_hash = contentHash;
+
+	// another process may already have decompressed it
+	std::string path = _directory.empty() ? std::string() : getCachePath(levelID, contentHash, "txt");
+	if (path.empty() || !level->_mapped.open(path))
+	{
+		level->_levelString =
+			levelString[0] == 'k' ? std::string(levelString) : GJGameLevel::decompressLvlStr(levelString);
+
+		if (!path.empty() && !level->_levelString.empty())
+		{
+			writeCacheFile(path, level->_levelString);
+			if (level->_mapped.open(path))
+				std::string().swap(level->_levelString);
+		}
+	}
+
+	if (it != _levels.end())
+	{
+		removeCacheFile(levelID, it->second->_hash, "txt");
+		it->second = level;
+	}
+	else
+		_levels.emplace(levelID, level);
+	return level;
+}
+
+std::shared_ptr<const CompiledLevel> LevelCache::getCompiled(int levelID, std::string_view levelString)
+{
+	if (levelString.empty())
+		return nullptr;
+
+	uint64_t contentHash = hash(levelString);
+	std::string path;
+	{
+		std::lock_guard lock(_mutex);
+		if (auto it = _compiledLevels.find(levelID); it != _compiledLevels.end() && it->second.first == contentHash)
+			return it->second.second;
+		if (!_directory.empty())
+			path = getCachePath(levelID, contentHash, "ogdl");
+	}
+
+	// an older version or a damaged file fails to open and is compiled again over it
+	auto level = std::make_shared<CompiledLevel>();
+	if (path.empty() || !level->open(path))
+	{
+		auto cached = get(levelID, levelString);
+		if (!cached)
+			return nullptr;
+
+		std::vector<uint8_t> data = CompiledLevel::compile(cached->getLevelString());
+		if (!path.empty())
+			writeCacheFile(path, {reinterpret_cast<const char*>(data.data()), data.size()});
+		if ((path.empty() || !level->open(path)) && !level->load(std::move(data)))
+			return nullptr;
+	}
+
+	std::lock_guard lock(_mutex);
+	auto& entry = _compiledLevels[levelID];
+	// another thread may have compiled the same version in the meantime
+	if (entry.second && entry.first == contentHash)
+		return entry.second;
+	if (entry.second)
+		removeCacheFile(levelID, entry.first, "ogdl");
+	entry = {contentHash, std::move(level)};
+	return entry.second;
+}
+
+std::shared_ptr<const SimLevel> LevelCache::getSimLevel(int levelID)
+{
+	{
+		std::lock_guard lock(_mutex);
+		if (auto it = _simLevels.find(levelID); it != _simLevels.end())
+			return it->second;
+
+		if (_objectTypes.empty())
+			_objectTypes = ObjectData::parseObjectTypes(
+				ax::FileUtils::getInstance()->getStringFromFile("Custom/object.json"));
+	}
+
+	auto compiled = getCompiled(levelID, getMainLevel(levelID));
+	if (!compiled)
+		return nullptr;
+
+	auto level = SimLevel::createFromCompiled(*compiled, _objectTypes);
+
+	std::lock_guard lock(_mutex);
+	return _simLevels.emplace(levelID, std::move(level)).first->second;
+}
+
+uint64_t LevelCache::hash(std::string_view data)
+{
+	uint64_t hash = 0xcbf29ce484222325ull;
+	for (unsigned char c : data)
+	{
+		hash ^= c;
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+std::string LevelCache::getCachePath(int levelID, uint64_t hash, std::string_view extension) const
+{
+	return fmt::format("{}/{}-{:016x}.{}", _directory, levelID, hash, extension);
+}
+
+void LevelCache::writeCacheFile(const std::string& path, std::string_view contents) const
+{
+	// written under a private name and renamed, a reader never maps a half written file
+	std::string temp = fmt::format("{}.{:08x}.tmp", path, std::random_device{}());
+	{
+		std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+		file.write(contents.data(), contents.size());
+		if (!file)
+		{
+			GameToolbox::log("LevelCache: could not write {}", temp);
+			return;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(temp, path, error);
+	if (error)
+	{
+		GameToolbox::log("LevelCache: could not move {} into place", temp);
+		std::filesystem::remove(temp, error);
+	}
+}
+
+void LevelCache::removeCacheFile(int levelID, uint64_t hash, std::string_view extension) const
+{
+	if (_directory.empty())
+		return;
+
+	// a process that still has it mapped keeps its pages
+	std::error_code error;
+	std::filesystem::remove(getCachePath(levelID, hash, extension), error);
+}
@@ -0,0 +1,97 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "GameToolbox/mappedFile.h"
+#include "Simulation/ObjectData.h"
+
+class CompiledLevel;
+class SimLevel;
+
+// One decompressed level string. Never changes once it is in the cache.
+class CachedLevel
+{
+  public:
+	int _levelID = 0;
+	uint64_t _hash = 0; // LevelCache::hash of the string it was decompressed from
+
+	std::string_view getLevelString() const { return _mapped.isOpen() ? _mapped.view() : _levelString; }
+
+  private:
+	friend class LevelCache;
+	std::string _levelString;
+	GameToolbox::MappedFile _mapped;
+};
+
+// Process-wide store of decompressed levels, one per level id, so replaying a level skips reading
+// mainLevels.json, base64 and inflate. A level string with a different content hash replaces the
+// entry for its id, so playtesting an edited level doesn't keep every version. With a directory set,
+// every decompressed level is also written there and mapped back read-only, so all game processes
+// on a machine share one copy, and the file of a replaced version is removed.
+class LevelCache
+{
+  public:
+	static LevelCache* getInstance();
+
+	// empty keeps levels in memory only, see TrainingOptions::_levelCacheDir
+	void setDirectory(std::string_view directory);
+
+	// compressed data of a main level from Custom/mainLevels.json, parsed on the first call.
+	// empty when the id isn't one
+	std::string_view getMainLevel(int levelID);
+
+	// the uncompressed form of a level string, compressed or not. nullptr for an empty string
+	std::shared_ptr<const CachedLevel> get(int levelID, std::string_view levelString);
+
+	// a level string, compressed or not, as a CompiledLevel. With a directory set it is mapped from
+	// the file another process compiled, without decompressing or parsing anything. nullptr for an
+	// empty string
+	std::shared_ptr<const CompiledLevel> getCompiled(int levelID, std::string_view levelString);
+
+	// a main level ready for headless SimWorlds, built from its level string the first time.
+	// nullptr when the id isn't one
+	std::shared_ptr<const SimLevel> getSimLevel(int levelID);
+
+	// 64 bit FNV-1a
+	static uint64_t hash(std::string_view data);
+
+  private:
+	std::mutex _mutex;
+	std::string _directory;
+	bool _mainLevelsLoaded = false;
+	std::unordered_map<int, std::string> _mainLevels;
+	std::unordered_map<int, std::shared_ptr<const CachedLevel>> _levels;
+	std::unordered_map<int, GameObjectType> _objectTypes; // from Custom/object.json, loaded with the first SimLevel
+	std::unordered_map<int, std::pair<uint64_t, std::shared_ptr<const CompiledLevel>>> _compiledLevels; // content hash, level
+	std::unordered_map<int, std::shared_ptr<const SimLevel>> _simLevels;
+
+	// extension is txt for level strings and ogdl for compiled levels
+	std::string getCachePath(int levelID, uint64_t hash, std::string_view extension) const;
+	void writeCacheFile(const std::string& path, std::string_view contents) const;
+	// drops the file of a version that was replaced in memory
+	void removeCacheFile(int levelID, uint64_t hash, std::string_view extension) const;
+};
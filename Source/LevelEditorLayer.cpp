@@ -156,6 +156,7 @@ void LevelEditorLayer::onEnter() {
 
 void LevelEditorLayer::destroyPlayer(PlayerObject* player) {
 	if (_inPlaybackMode) PlayLayer::destroyPlayer(player);
+	else player->setIsDead(false);
 };
 
 void LevelEditorLayer::onKeyPressed(ax::EventKeyboard::KeyCode keyCode, ax::Event* event)
@@ -397,6 +398,9 @@ void LevelEditorLayer::update(float delta) {
 }
 
 void LevelEditorLayer::resetLevel() {
+	// objects may have been added or moved since the last attempt
+	buildSimulation();
+
 	PlayLayer::resetLevel();
 
 	if (!_inPlaybackMode) ax::AudioEngine::stopAll();
@@ -463,8 +467,8 @@ bool LevelEditorLayer::init(GJGameLevel* level) {
 	_bottomGround->setLocalZOrder(grid->getLocalZOrder() + 1);
 	_ceiling->setLocalZOrder(grid->getLocalZOrder() + 1);
 
-	_player1->noclip = true;
-	_player2->noclip = true;
+	_player1->setNoclip(true);
+	_player2->setNoclip(true);
 
 	auto dir = ax::Director::getInstance();
 	auto listener = ax::EventListenerTouchOneByOne::create();
@@ -779,4 +783,4 @@ void LevelEditorLayer::onTouchEnded(ax::Touch* touch, ax::Event* event) {
 		if (_isDualMode) _player2->releaseButton();
 	}
 	_inSwapMode = false;
-}
\ No newline at end of file
+}
\ No newline at end of file
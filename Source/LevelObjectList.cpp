@@ -0,0 +1,161 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "LevelObjectList.h"
+
+#include <algorithm>
+
+#include "GameToolbox/conv.h"
+#include "GameToolbox/tokenizer.h"
+#include "Simulation/ThreadPool.h"
+
+LevelObjectList LevelObjectList::parse(std::string_view objectString, unsigned threads)
+{
+	LevelObjectList list;
+
+	size_t chunkCount = objectString.size() / kChunkSize;
+	if (chunkCount < 2)
+	{
+		list.appendAll(objectString);
+		return list;
+	}
+
+	// cut right after the first ';' past every chunkCount'th of the string
+	std::vector<std::string_view> chunks;
+	chunks.reserve(chunkCount);
+	const char* begin = objectString.data();
+	const char* end = begin + objectString.size();
+	for (size_t i = 1; i <= chunkCount && begin < end; i++)
+	{
+		const char* cut = objectString.data() + objectString.size() * i / chunkCount;
+		if (cut < end)
+			cut = std::min(GameToolbox::findDelim(std::max(cut, begin), end, ';') + 1, end);
+		chunks.emplace_back(begin, cut - begin);
+		begin = cut;
+	}
+
+	std::vector<LevelObjectList> parsed(chunks.size());
+	ThreadPool pool(threads);
+	pool.parallelFor(chunks.size(), [&](size_t i) { parsed[i].appendAll(chunks[i]); });
+
+	size_t objects = 0, properties = 0, hsv = 0, groups = 0;
+	for (const LevelObjectList& chunk : parsed)
+	{
+		objects += chunk._objects.size();
+		properties += chunk._properties.size();
+		hsv += chunk._hsv.size();
+		groups += chunk._groups.size();
+	}
+	list._objects.reserve(objects);
+	list._properties.reserve(properties);
+	list._hsv.reserve(hsv);
+	list._groups.reserve(groups);
+
+	for (const LevelObjectList& chunk : parsed)
+		list.appendList(chunk);
+	return list;
+}
+
+void LevelObjectList::appendAll(std::string_view objects)
+{
+	// objects are a bit over 32 bytes with 5 to 6 properties
+	_objects.reserve(_objects.size() + objects.size() / 32);
+	_properties.reserve(_properties.size() + objects.size() / 6);
+
+	for (std::string_view object : GameToolbox::Tokens(objects, ';'))
+		append(object);
+}
+
+bool LevelObjectList::append(std::string_view object)
+{
+	LevelObjectDescriptor descriptor = {-1, static_cast<uint32_t>(_properties.size()), 0};
+
+	for (auto [key, value] : GameToolbox::KeyValues(object))
+	{
+		LevelObjectProperty property = {GameToolbox::stoi(key), GameToolbox::stoi(value), GameToolbox::stof(value), 0, 0};
+
+		if (descriptor._objectID == -1)
+		{
+			if (property._key != 1)
+				break;
+			descriptor._objectID = property._int;
+		}
+
+		switch (property._key)
+		{
+		case 43:
+		case 44:
+		case 49: {
+			std::string_view fields[5];
+			GameToolbox::splitInto(value, 'a', fields, 5);
+
+			GDHSV& hsv = _hsv.emplace_back();
+			hsv.h = GameToolbox::stof(fields[0]);
+			hsv.s = GameToolbox::stof(fields[1]);
+			hsv.v = GameToolbox::stof(fields[2]);
+			hsv.sChecked = GameToolbox::stoi(fields[3]);
+			hsv.vChecked = GameToolbox::stoi(fields[4]);
+
+			property._first = static_cast<uint32_t>(_hsv.size() - 1);
+			property._count = 1;
+			break;
+		}
+		case 57:
+			property._first = static_cast<uint32_t>(_groups.size());
+			for (std::string_view group : GameToolbox::Tokens(value, '.'))
+				_groups.push_back(GameToolbox::stoi(group));
+			property._count = static_cast<uint32_t>(_groups.size() - property._first);
+			break;
+		}
+
+		_properties.push_back(property);
+	}
+
+	if (descriptor._objectID == -1)
+	{
+		_properties.resize(descriptor._firstProperty);
+		return false;
+	}
+
+	descriptor._propertyCount = static_cast<uint32_t>(_properties.size() - descriptor._firstProperty);
+	_objects.push_back(descriptor);
+	return true;
+}
+
+void LevelObjectList::appendList(const LevelObjectList& other)
+{
+	uint32_t propertyBase = static_cast<uint32_t>(_properties.size());
+	uint32_t hsvBase = static_cast<uint32_t>(_hsv.size());
+	uint32_t groupBase = static_cast<uint32_t>(_groups.size());
+
+	for (LevelObjectDescriptor object : other._objects)
+	{
+		object._firstProperty += propertyBase;
+		_objects.push_back(object);
+	}
+	for (LevelObjectProperty property : other._properties)
+	{
+		if (property._key == 57)
+			property._first += groupBase;
+		else if (property._count)
+			property._first += hsvBase;
+		_properties.push_back(property);
+	}
+	_hsv.insert(_hsv.end(), other._hsv.begin(), other._hsv.end());
+	_groups.insert(_groups.end(), other._groups.begin(), other._groups.end());
+}
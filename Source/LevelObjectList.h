@@ -0,0 +1,84 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "GDHSV.h"
+
+// one key,value pair of an object string, the value already converted
+struct LevelObjectProperty
+{
+	int _key;
+	int _int;	  // the value as GameToolbox::stoi reads it
+	float _float; // and as GameToolbox::stof does
+	// keys 43, 44 and 49: the HSV at LevelObjectList::_hsv[_first], _count is 1.
+	// key 57: _count group ids from LevelObjectList::_groups[_first]
+	uint32_t _first;
+	uint32_t _count;
+};
+
+// an object of the level string, its properties in the order they were written
+struct LevelObjectDescriptor
+{
+	int _objectID;
+	uint32_t _firstProperty;
+	uint32_t _propertyCount;
+};
+
+// The objects of a level string as plain data. Parsing it touches nothing but the string, so big
+// levels are cut into chunks parsed on every core, then the sprites are created from it in one
+// ordered pass on the main thread. Objects keep the order of the string, so _uniqueID and group
+// membership come out the same as parsing them one by one.
+class LevelObjectList
+{
+  public:
+	std::vector<LevelObjectDescriptor> _objects;
+	std::vector<LevelObjectProperty> _properties;
+	std::vector<GDHSV> _hsv;
+	std::vector<int> _groups;
+
+	// objectString is everything after the level header. threads as in ThreadPool, short strings
+	// are parsed on the calling thread
+	static LevelObjectList parse(std::string_view objectString, unsigned threads = 0);
+
+	// adds one object, false if it doesn't start with its id (key 1) and was left out
+	bool append(std::string_view object);
+
+	size_t size() const { return _objects.size(); }
+	std::span<const LevelObjectProperty> getProperties(size_t index) const
+	{
+		const LevelObjectDescriptor& object = _objects[index];
+		return {_properties.data() + object._firstProperty, object._propertyCount};
+	}
+	std::span<const int> getGroups(const LevelObjectProperty& property) const
+	{
+		return {_groups.data() + property._first, property._count};
+	}
+
+  private:
+	// about this many bytes of the string per parallel chunk
+	static constexpr size_t kChunkSize = 64 * 1024;
+
+	void appendAll(std::string_view objects);
+	void appendList(const LevelObjectList& other);
+};
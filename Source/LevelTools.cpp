@@ -17,7 +17,6 @@
 *************************************************************************/
 
 #include "LevelTools.h"
-#include "base64.h"
 #include "external/constants.h"
 #include <cstring>
 
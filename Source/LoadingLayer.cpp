@@ -19,6 +19,9 @@
 #include "LoadingLayer.h"
 
 #include "MenuLayer.h"
+#include "PlayLayer.h"
+#include "GJGameLevel.h"
+#include "Training/TrainingOptions.h"
 #include "CocosExplorer.h"
 #include "GameManager.h"
 
@@ -237,6 +240,13 @@ void LoadingLayer::assetLoaded(ax::Object*)
 	_pBar->setPercentage((m_nAssetsLoaded / m_nTotalAssets)*100.f);
 
 	if(m_nAssetsLoaded == m_nTotalAssets) {
+		// the trainer starts its level from the command line instead of clicking through the menus
+		if (int levelID = TrainingOptions::getInstance()->_playLevel; levelID > 0)
+		{
+			auto level = GJGameLevel::createWithMinimumData("", "RobTop", levelID);
+			Director::getInstance()->replaceScene(PlayLayer::scene(level));
+			return;
+		}
 		Director::getInstance()->replaceScene(MenuLayer::scene());
 	}
 }
@@ -19,451 +19,10 @@
 #include "GameObject.h"
 #include "GameToolbox/conv.h"
 
-
-const std::unordered_map<int, Hitbox, my_string_hash> GameObject::_pHitboxes = std::unordered_map<int, Hitbox, my_string_hash>{{0, {30, 30, -15, -15}},
-																		   {1, {30, 30, -15, -15}},
-																		   {2, {30, 30, -15, -15}},
-																		   {3, {30, 30, -15, -15}},
-																		   {4, {30, 30, -15, -15}},
-																		   {6, {30, 30, -15, -15}},
-																		   {7, {30, 30, -15, -15}},
-																		   {8, {12, 6, -3, -6}},
-																		   {9, {10.8, 9, -4.5, -5.4}},
-																		   {10, {75, 25, -12.5, -37.5}},
-																		   {11, {75, 25, -12.5, -37.5}},
-																		   {12, {86, 34, -17, -43}},
-																		   {13, {86, 34, -17, -43}},
-																		   {22, {30, 30, -15, -15}},
-																		   {23, {30, 30, -15, -15}},
-																		   {24, {30, 30, -15, -15}},
-																		   {25, {30, 30, -15, -15}},
-																		   {26, {30, 30, -15, -15}},
-																		   {27, {30, 30, -15, -15}},
-																		   {28, {30, 30, -15, -15}},
-																		   {29, {30, 30, -15, -15}},
-																		   {30, {30, 30, -15, -15}},
-																		   {32, {30, 30, -15, -15}},
-																		   {33, {30, 30, -15, -15}},
-																		   {34, {23, 37, -18.5, -11.5}},
-																		   {35, {4, 25, -12.5, -2}},
-																		   {36, {36, 36, -18, -18}},
-																		   {39, {5.6, 6, -3, -2.8}},
-																		   {40, {14, 30, -15, -7}},
-																		   {45, {92, 44, -22, -46}},
-																		   {46, {92, 44, -22, -46}},
-																		   {47, {86, 34, -17, -43}},
-																		   {55, {20, 20, -10, -10}},
-																		   {56, {30, 30, -15, -15}},
-																		   {57, {30, 30, -15, -15}},
-																		   {58, {30, 30, -15, -15}},
-																		   {59, {30, 30, -15, -15}},
-																		   {61, {7.2, 9, -4.5, -3.6}},
-																		   {62, {16, 30, -15, -8}},
-																		   {63, {30, 30, -15, -15}},
-																		   {64, {15, 15, -7.5, -7.5}},
-																		   {65, {16, 30, -15, -8}},
-																		   {66, {16, 30, -15, -8}},
-																		   {67, {6, 25, -12.5, -3}},
-																		   {68, {16, 30, -15, -8}},
-																		   {69, {30, 30, -15, -15}},
-																		   {70, {30, 30, -15, -15}},
-																		   {71, {30, 30, -15, -15}},
-																		   {72, {30, 30, -15, -15}},
-																		   {74, {30, 30, -15, -15}},
-																		   {75, {30, 30, -15, -15}},
-																		   {76, {30, 30, -15, -15}},
-																		   {77, {30, 30, -15, -15}},
-																		   {78, {30, 30, -15, -15}},
-																		   {81, {30, 30, -15, -15}},
-																		   {82, {30, 30, -15, -15}},
-																		   {83, {30, 30, -15, -15}},
-																		   {84, {36, 36, -18, -18}},
-																		   {88, {85, 44, -22, -42.5}},
-																		   {89, {60, 60, -30, -30}},
-																		   {90, {30, 30, -15, -15}},
-																		   {91, {30, 30, -15, -15}},
-																		   {92, {30, 30, -15, -15}},
-																		   {93, {30, 30, -15, -15}},
-																		   {94, {30, 30, -15, -15}},
-																		   {95, {30, 30, -15, -15}},
-																		   {96, {30, 30, -15, -15}},
-																		   {98, {40, 40, -20, -20}},
-																		   {99, {90, 31, -15.5, -45}},
-																		   {101, {90, 31, -15.5, -45}},
-																		   {103, {7.6, 4, -2, -3.8}},
-																		   {105, {30, 30, -15, -15}},
-																		   {111, {86, 34, -17, -43}},
-																		   {116, {30, 30, -15, -15}},
-																		   {117, {30, 30, -15, -15}},
-																		   {118, {30, 30, -15, -15}},
-																		   {119, {30, 30, -15, -15}},
-																		   {121, {30, 30, -15, -15}},
-																		   {122, {30, 30, -15, -15}},
-																		   {135, {20, 14.1, -7.05, -10}},
-																		   {140, {5, 25, -12.5, -2.5}},
-																		   {141, {36, 36, -18, -18}},
-																		   {143, {30, 30, -15, -15}},
-																		   {144, {12, 6, -3, -6}},
-																		   {145, {7.6, 4, -2, -3.8}},
-																		   {146, {30, 30, -15, -15}},
-																		   {147, {14, 30, -15, -7}},
-																		   {160, {30, 30, -15, -15}},
-																		   {161, {30, 30, -15, -15}},
-																		   {162, {30, 30, -15, -15}},
-																		   {163, {30, 30, -15, -15}},
-																		   {165, {30, 30, -15, -15}},
-																		   {166, {30, 30, -15, -15}},
-																		   {167, {30, 30, -15, -15}},
-																		   {168, {30, 30, -15, -15}},
-																		   {169, {30, 30, -15, -15}},
-																		   {170, {21, 30, -15, -10.5}},
-																		   {171, {21, 30, -15, -10.5}},
-																		   {172, {21, 30, -15, -10.5}},
-																		   {173, {30, 30, -15, -15}},
-																		   {174, {21, 30, -15, -10.5}},
-																		   {175, {30, 30, -15, -15}},
-																		   {176, {21, 14, -7, -10.5}},
-																		   {177, {12, 6, -3, -6}},
-																		   {178, {6.4, 6, -3, -3.2}},
-																		   {179, {8, 4, -2, -4}},
-																		   {183, {43, 43, -21.5, -21.5}},
-																		   {184, {53, 60, -30, -26.5}},
-																		   {185, {40, 10, -5, -20}},
-																		   {186, {43, 43, -21.5, -21.5}},
-																		   {187, {61, 61, -30.5, -30.5}},
-																		   {188, {42, 42, -21, -21}},
-																		   {192, {21, 30, -15, -10.5}},
-																		   {194, {21, 21, -10.5, -10.5}},
-																		   {195, {15, 15, -7.5, -7.5}},
-																		   {196, {8, 15, -7.5, -4}},
-																		   {197, {21, 22, -11, -10.5}},
-																		   {200, {44, 35, -17.5, -22}},
-																		   {201, {56, 33, -16.5, -28}},
-																		   {202, {56, 51, -25.5, -28}},
-																		   {203, {56, 65, -32.5, -28}},
-																		   {204, {8, 15, -7.5, -4}},
-																		   {205, {5.6, 6, -3, -2.8}},
-																		   {206, {15, 15, -7.5, -7.5}},
-																		   {207, {30, 30, -15, -15}},
-																		   {208, {30, 30, -15, -15}},
-																		   {209, {30, 30, -15, -15}},
-																		   {210, {30, 30, -15, -15}},
-																		   {212, {30, 30, -15, -15}},
-																		   {213, {30, 30, -15, -15}},
-																		   {215, {14, 30, -15, -7}},
-																		   {216, {12, 6, -3, -6}},
-																		   {217, {5.6, 6, -3, -2.8}},
-																		   {218, {7.6, 4, -2, -3.8}},
-																		   {219, {8, 15, -7.5, -4}},
-																		   {220, {15, 15, -7.5, -7.5}},
-																		   {243, {7.2, 6, -8, -3.6}},
-																		   {244, {6.8, 6, 2, -3.4}},
-																		   {247, {30, 30, -15, -15}},
-																		   {248, {30, 30, -15, -15}},
-																		   {249, {30, 30, -15, -15}},
-																		   {250, {30, 30, -15, -15}},
-																		   {252, {30, 30, -15, -15}},
-																		   {253, {30, 30, -15, -15}},
-																		   {254, {30, 30, -15, -15}},
-																		   {255, {30, 30, -15, -15}},
-																		   {256, {30, 30, -15, -15}},
-																		   {257, {30, 30, -15, -15}},
-																		   {258, {30, 30, -15, -15}},
-																		   {260, {30, 30, -15, -15}},
-																		   {261, {30, 30, -15, -15}},
-																		   {263, {30, 30, -15, -15}},
-																		   {264, {30, 30, -15, -15}},
-																		   {265, {30, 30, -15, -15}},
-																		   {267, {30, 30, -15, -15}},
-																		   {268, {30, 30, -15, -15}},
-																		   {269, {30, 30, -15, -15}},
-																		   {270, {30, 30, -15, -15}},
-																		   {271, {30, 30, -15, -15}},
-																		   {272, {30, 30, -15, -15}},
-																		   {274, {30, 30, -15, -15}},
-																		   {275, {30, 30, -15, -15}},
-																		   {286, {91, 41, -20.5, -45.5}},
-																		   {287, {91, 41, -20.5, -45.5}},
-																		   {289, {30, 30, -15, -15}},
-																		   {291, {30, 60, -30, -15}},
-																		   {294, {30, 30, -15, -15}},
-																		   {295, {30, 60, -30, -15}},
-																		   {299, {30, 30, -15, -15}},
-																		   {301, {30, 60, -30, -15}},
-																		   {305, {30, 30, -15, -15}},
-																		   {307, {30, 60, -30, -15}},
-																		   {309, {30, 30, -15, -15}},
-																		   {311, {30, 60, -30, -15}},
-																		   {315, {30, 30, -15, -15}},
-																		   {317, {30, 60, -30, -15}},
-																		   {321, {30, 30, -15, -15}},
-																		   {323, {30, 60, -30, -15}},
-																		   {326, {30, 30, -15, -15}},
-																		   {327, {30, 60, -30, -15}},
-																		   {328, {22, 22, -11, -11}},
-																		   {329, {22, 43, -21.5, -11}},
-																		   {331, {30, 30, -15, -15}},
-																		   {333, {30, 60, -30, -15}},
-																		   {337, {30, 30, -15, -15}},
-																		   {339, {30, 60, -30, -15}},
-																		   {343, {30, 30, -15, -15}},
-																		   {345, {30, 60, -30, -15}},
-																		   {349, {30, 30, -15, -15}},
-																		   {351, {30, 60, -30, -15}},
-																		   {353, {30, 30, -15, -15}},
-																		   {355, {30, 60, -30, -15}},
-																		   {363, {30, 30, -15, -15}},
-																		   {364, {30, 60, -30, -15}},
-																		   {365, {6, 9, -4.5, -3}},
-																		   {366, {30, 30, -15, -15}},
-																		   {367, {30, 60, -30, -15}},
-																		   {368, {4, 9, -4.5, -2}},
-																		   {369, {14, 30, -15, -7}},
-																		   {370, {14, 30, -15, -7}},
-																		   {371, {30, 30, -15, -15}},
-																		   {372, {30, 60, -30, -15}},
-																		   {392, {4.8, 2.6, -1.3, -2.4}},
-																		   {397, {43, 43, -21.5, -21.5}},
-																		   {398, {63, 55, -27.5, -31.5}},
-																		   {399, {43, 43, -21.5, -21.5}},
-																		   {421, {5.2, 9, -4.5, -2.6}},
-																		   {422, {4.4, 6, -8, -2.2}},
-																		   {446, {7.2, 9, -4.5, -3.6}},
-																		   {447, {7.2, 5.2, -7.6, -3.6}},
-																		   {458, {4.8, 2.6, -1.3, -2.4}},
-																		   {459, {4.8, 2.6, -1.3, -2.4}},
-																		   {467, {30, 30, -15, -15}},
-																		   {468, {1.5, 30, -15, -0.75}},
-																		   {469, {30, 30, -15, -15}},
-																		   {470, {30, 30, -15, -15}},
-																		   {471, {30, 30, -15, -15}},
-																		   {475, {1.5, 30, -15, -0.75}},
-																		   {483, {30, 30, -15, -15}},
-																		   {484, {30, 60, -30, -15}},
-																		   {492, {30, 30, -15, -15}},
-																		   {493, {30, 60, -30, -15}},
-																		   {651, {30, 30, -15, -15}},
-																		   {652, {30, 60, -30, -15}},
-																		   {660, {86, 34, -17, -43}},
-																		   {661, {15, 15, -7.5, -7.5}},
-																		   {662, {15, 30, -15, -7.5}},
-																		   {663, {15, 30, -15, -7.5}},
-																		   {664, {15, 30, -15, -7.5}},
-																		   {665, {30, 30, -15, -15}},
-																		   {666, {30, 60, -30, -15}},
-																		   {667, {6, 9, -4.5, -3}},
-																		   {673, {30, 30, -15, -15}},
-																		   {674, {30, 60, -30, -15}},
-																		   {675, {41, 41, -20.5, -20.5}},
-																		   {676, {53, 52, -26, -26.5}},
-																		   {677, {39, 39, -19.5, -19.5}},
-																		   {678, {41, 40, -20, -20.5}},
-																		   {679, {54, 52, -26, -27}},
-																		   {680, {36, 36, -18, -18}},
-																		   {709, {30, 30, -15, -15}},
-																		   {710, {30, 60, -30, -15}},
-																		   {711, {30, 30, -15, -15}},
-																		   {712, {30, 60, -30, -15}},
-																		   {720, {3.2, 2.4, -1.2, -1.6}},
-																		   {726, {30, 30, -15, -15}},
-																		   {727, {30, 60, -30, -15}},
-																		   {728, {30, 30, -15, -15}},
-																		   {729, {30, 60, -30, -15}},
-																		   {740, {43, 43, -21.5, -21.5}},
-																		   {741, {61, 61, -30.5, -30.5}},
-																		   {742, {42, 42, -21, -21}},
-																		   {744, {30, 30, -15, -15}},
-																		   {745, {86, 34, -17, -43}},
-																		   {747, {90, 25, -0.5, -45}},
-																		   {768, {5.2, 4.5, -2.25, -2.6}},
-																		   {886, {30, 30, -15, -15}},
-																		   {887, {30, 60, -30, -15}},
-																		   {899, {30, 30, -15, -15}},
-																		   {900, {30, 30, -15, -15}},
-																		   {901, {30, 30, -15, -15}},
-																		   {915, {30, 30, -15, -15}},
-																		   {918, {48, 48, -24, -24}},
-																		   {919, {6, 25, -12.5, -3}},
-																		   {925, {70, 70, -70, 0}},
-																		   {926, {130, 130, -130, 0}},
-																		   {989, {12, 9, -4.5, -6}},
-																		   {991, {3.2, 2.4, -1.2, -1.6}},
-																		   {1006, {30, 30, -15, -15}},
-																		   {1007, {30, 30, -15, -15}},
-																		   {1019, {112, 112, -56, -56}},
-																		   {1020, {90, 90, -45, -45}},
-																		   {1021, {64, 64, -32, -32}},
-																		   {1022, {36, 36, -18, -18}},
-																		   {1049, {30, 30, -15, -15}},
-																		   {1120, {30, 30, -15, -15}},
-																		   {1122, {30, 30, -15, -15}},
-																		   {1123, {30, 30, -15, -15}},
-																		   {1124, {30, 30, -15, -15}},
-																		   {1125, {30, 30, -15, -15}},
-																		   {1126, {30, 30, -15, -15}},
-																		   {1127, {30, 30, -15, -15}},
-																		   {1132, {30, 30, -15, -15}},
-																		   {1133, {30, 30, -15, -15}},
-																		   {1134, {30, 30, -15, -15}},
-																		   {1135, {30, 30, -15, -15}},
-																		   {1136, {30, 30, -15, -15}},
-																		   {1137, {30, 30, -15, -15}},
-																		   {1138, {15, 15, -7.5, -7.5}},
-																		   {1139, {15, 15, -7.5, -7.5}},
-																		   {1154, {1.5, 15, -7.5, -0.75}},
-																		   {1155, {15, 15, -7.5, -7.5}},
-																		   {1156, {15, 15, -7.5, -7.5}},
-																		   {1157, {15, 15, -7.5, -7.5}},
-																		   {1202, {3, 30, -15, -1.5}},
-																		   {1203, {30, 30, -15, -15}},
-																		   {1204, {30, 30, -15, -15}},
-																		   {1208, {15, 15, -7.5, -7.5}},
-																		   {1209, {30, 30, -15, -15}},
-																		   {1210, {30, 30, -15, -15}},
-																		   {1220, {6, 30, -15, -3}},
-																		   {1221, {30, 30, -15, -15}},
-																		   {1222, {30, 30, -15, -15}},
-																		   {1226, {30, 30, -15, -15}},
-																		   {1227, {7, 30, -15, -3.5}},
-																		   {1241, {15, 15, -7.5, -7.5}},
-																		   {1242, {15, 15, -7.5, -7.5}},
-																		   {1243, {15, 15, -7.5, -7.5}},
-																		   {1244, {15, 15, -7.5, -7.5}},
-																		   {1245, {15, 15, -7.5, -7.5}},
-																		   {1246, {15, 15, -7.5, -7.5}},
-																		   {1260, {1.5, 30, -15, -0.75}},
-																		   {1262, {3, 30, -15, -1.5}},
-																		   {1264, {6, 30, -15, -3}},
-																		   {1268, {30, 30, -15, -15}},
-																		   {1275, {20, 25, -12.5, -10}},
-																		   {1304, {30, 30, -15, -15}},
-																		   {1327, {8, 8, -4, -4}},
-																		   {1328, {15, 8, -4, -7.5}},
-																		   {1329, {40, 40, -20, -20}},
-																		   {1330, {36, 36, -18, -18}},
-																		   {1331, {86, 34, -17, -43}},
-																		   {1332, {7, 29, -14.5, -3.5}},
-																		   {1333, {36, 36, -18, -18}},
-																		   {1334, {56, 69, -34.5, -28}},
-																		   {1338, {30, 30, -15, -15}},
-																		   {1339, {30, 60, -30, -15}},
-																		   {1340, {2, 27, -13.5, -1}},
-																		   {1341, {30, 30, -15, -15}},
-																		   {1342, {30, 60, -30, -15}},
-																		   {1343, {3, 25, -12.5, -1.5}},
-																		   {1344, {30, 30, -15, -15}},
-																		   {1345, {30, 60, -30, -15}},
-																		   {1346, {30, 30, -15, -15}},
-																		   {1347, {30, 30, -15, -15}},
-																		   {1520, {30, 30, -15, -15}},
-																		   {1561, {10, 30, -15, -5}},
-																		   {1562, {2, 30, -15, -1}},
-																		   {1563, {2, 15, -7.5, -1}},
-																		   {1564, {12, 12, -6, -6}},
-																		   {1565, {17, 17, -8.5, -8.5}},
-																		   {1566, {12, 12, -6, -6}},
-																		   {1567, {10, 15, -7.5, -5}},
-																		   {1568, {32, 62, -31, -16}},
-																		   {1569, {32, 32, -16, -16}},
-																		   {1582, {26, 27, -13.5, -13}},
-																		   {1583, {23, 31, -15.5, -11.5}},
-																		   {1584, {8, 8, -4, -4}},
-																		   {1585, {30, 30, -15, -15}},
-																		   {1587, {20, 25, -12.5, -10}},
-																		   {1589, {20, 25, -12.5, -10}},
-																		   {1594, {36, 36, -18, -18}},
-																		   {1595, {30, 30, -15, -15}},
-																		   {1598, {20, 25, -12.5, -10}},
-																		   {1611, {30, 30, -15, -15}},
-																		   {1612, {30, 30, -15, -15}},
-																		   {1613, {30, 30, -15, -15}},
-																		   {1614, {20, 25, -12.5, -10}},
-																		   {1616, {30, 30, -15, -15}},
-																		   {1619, {39, 49, -24.5, -19.5}},
-																		   {1620, {32, 32, -16, -16}},
-																		   {1701, {28, 20, -10, -14}},
-																		   {1702, {29, 15, -7.5, -14.5}},
-																		   {1703, {22, 13, -6.5, -11}},
-																		   {1704, {36, 36, -18, -18}},
-																		   {1705, {85, 44, -22, -42.5}},
-																		   {1706, {60, 60, -30, -30}},
-																		   {1707, {40, 40, -20, -20}},
-																		   {1708, {43, 43, -21.5, -21.5}},
-																		   {1709, {63, 55, -27.5, -31.5}},
-																		   {1710, {43, 43, -21.5, -21.5}},
-																		   {1711, {20, 14.1, -7.05, -10}},
-																		   {1712, {22.4, 13.5, -6.75, -11.2}},
-																		   {1713, {20, 11.7, -5.85, -10}},
-																		   {1714, {16.4, 11.4, -5.7, -8.2}},
-																		   {1715, {10.8, 9, -4.5, -5.4}},
-																		   {1716, {6, 9, -4.5, -3}},
-																		   {1717, {30, 30, -15, -15}},
-																		   {1718, {30, 60, -30, -15}},
-																		   {1719, {7.2, 9, -4.5, -3.6}},
-																		   {1720, {7.2, 6, -8, -3.6}},
-																		   {1721, {6.8, 6, 2, -3.4}},
-																		   {1722, {4, 9, -4.5, -2}},
-																		   {1723, {30, 30, -15, -15}},
-																		   {1724, {30, 60, -30, -15}},
-																		   {1725, {5.2, 9, -4.5, -2.6}},
-																		   {1726, {4.4, 6, -8, -2.2}},
-																		   {1727, {5.2, 4.5, -2.25, -2.6}},
-																		   {1728, {7.2, 9, -4.5, -3.6}},
-																		   {1729, {7.2, 5.2, -7.6, -3.6}},
-																		   {1730, {6, 9, -4.5, -3}},
-																		   {1731, {3.2, 2.4, -1.2, -1.6}},
-																		   {1732, {12, 9, -4.5, -6}},
-																		   {1733, {3.2, 2.4, -1.2, -1.6}},
-																		   {1734, {41, 41, -20.5, -20.5}},
-																		   {1735, {53, 52, -26, -26.5}},
-																		   {1736, {39, 39, -19.5, -19.5}},
-																		   {1743, {30, 30, -15, -15}},
-																		   {1744, {30, 60, -30, -15}},
-																		   {1745, {30, 30, -15, -15}},
-																		   {1746, {30, 60, -30, -15}},
-																		   {1747, {30, 30, -15, -15}},
-																		   {1748, {30, 60, -30, -15}},
-																		   {1749, {30, 30, -15, -15}},
-																		   {1750, {30, 60, -30, -15}},
-																		   {1751, {36, 36, -18, -18}},
-																		   {1755, {30, 30, -15, -15}},
-																		   {1811, {30, 30, -15, -15}},
-																		   {1812, {30, 30, -15, -15}},
-																		   {1813, {30, 30, -15, -15}},
-																		   {1814, {30, 30, -15, -15}},
-																		   {1815, {30, 30, -15, -15}},
-																		   {1817, {30, 30, -15, -15}},
-																		   {1818, {30, 30, -15, -15}},
-																		   {1819, {30, 30, -15, -15}},
-																		   {1829, {30, 30, -15, -15}},
-																		   {1831, {30, 30, -30, 0}},
-																		   {1832, {15, 15, -15, 0}},
-																		   {1833, {30, 30, -30, 0}},
-																		   {1834, {15, 15, -15, 0}},
-																		   {1839, {60, 60, -30, -30}},
-																		   {1840, {30, 30, -15, -15}},
-																		   {1841, {60, 60, -30, -30}},
-																		   {1842, {30, 30, -15, -15}},
-																		   {1859, {30, 30, -15, -15}},
-																		   {1886, {40, 40, -20, -20}},
-																		   {1887, {20, 20, -10, -10}},
-																		   {1888, {60, 60, -30, -30}},
-																		   {1903, {14, 30, -15, -7}},
-																		   {1904, {14, 30, -15, -7}},
-																		   {1905, {14, 30, -15, -7}},
-																		   {1906, {30, 30, -15, -15}},
-																		   {1907, {30, 60, -30, -15}},
-																		   {1910, {15, 15, -7.5, -7.5}},
-																		   {1911, {8, 15, -7.5, -4}}};
-
-
-
-const std::unordered_map<int, float, my_string_hash> GameObject::_pHitboxRadius = std::unordered_map<int, float, my_string_hash>{
-	{88, 32.3},	  {89, 21.6},	{98, 12},	  {183, 15.48}, {184, 20.4},   {185, 3},	 {186, 32.3},  {187, 21.96},
-	{188, 12.6},  {397, 28.9},	{398, 17.6},  {399, 12.9},	{675, 32},	   {676, 17.68}, {677, 12.48}, {678, 30.4},
-	{679, 18.72}, {680, 10.8},	{740, 32.3},  {741, 21.96}, {742, 12.6},   {918, 24},	 {1582, 4},	   {1583, 4},
-	{1619, 25},	  {1620, 15},	{1701, 6},	  {1702, 6},	{1703, 6},	   {1705, 32.3}, {1706, 21.6}, {1707, 12},
-	{1708, 28.9}, {1709, 17.6}, {1710, 12.9}, {1734, 32},	{1735, 17.68}, {1736, 12.48}};
+// the collision tables live in the simulation core so it can be built without axmol
+const std::unordered_map<int, Hitbox>& GameObject::_pHitboxes = ObjectData::hitboxes;
+const std::unordered_map<int, float>& GameObject::_pHitboxRadius = ObjectData::hitboxRadius;
+const std::vector<int>& GameObject::_pTriggers = ObjectData::triggers;
 
 const std::unordered_map<int, const char*, my_string_hash> GameObject::_pBlocks = std::unordered_map<int, const char*, my_string_hash>{
 	
@@ -2095,9 +1654,4 @@ const std::vector<int> GameObject::_pSolids = std::vector<int>{
 	305, 307, 309, 311, 315, 317, 321, 323, 326, 327, 328, 329, 331, 333, 337, 339, 343, 345, 349, 351, 353,
 	355, 369, 370, 371, 372, 374, 467, 468, 469, 470, 471, 475, 483, 484, 492, 493};
 
-const std::vector<int> GameObject::_pTriggers = std::vector<int>{
-	29,	  30,	31,	  32,	33,	  34,	104,  105,	221,  717,	718,  743,	744,  899,	900,  915,	901,
-	1006, 1007, 1049, 1268, 1346, 1347, 1520, 1585, 1595, 1611, 1612, 1613, 1616, 1811, 1812, 1814, 1815,
-	1817, 1818, 1819, 22,	24,	  23,	25,	  26,	27,	  28,	55,	  56,	57,	  58,	59,	  1912, 1913,
-	1914, 1916, 1917, 1931, 1932, 1934, 1935, 2015, 2016, 2062, 2067, 2068, 2701, 2702};
 
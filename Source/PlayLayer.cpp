@@ -25,6 +25,9 @@
 #include "LevelInfoLayer.h"
 #include "LevelPage.h"
 #include "LevelSelectLayer.h"
+#include "CompiledLevel.h"
+#include "LevelCache.h"
+#include "LevelObjectList.h"
 #include "LevelTools.h"
 #include "MenuItemSpriteExtra.h"
 
@@ -47,7 +50,12 @@
 #include "GameToolbox/math.h"
 #include "GameToolbox/conv.h"
 #include "GameToolbox/nodes.h"
-#include <fstream>
+#include "Training/EpisodeSummaryLog.h"
+#include "Training/EventChannel.h"
+#include "Training/InputChannel.h"
+#include "Training/ReplayLog.h"
+#include "Training/ObservationChannel.h"
+#include "Training/TrainingOptions.h"
 
 
 USING_NS_AX;
@@ -62,6 +70,11 @@ int monitorN = 0;
 
 static PlayLayer* Instance = nullptr;
 
+static ax::Rect toRect(const SimRect& rect)
+{
+	return {rect.x, rect.y, rect.width, rect.height};
+}
+
 Scene* PlayLayer::scene(GJGameLevel* level)
 {
 	// return LevelDebugLayer::scene(level);
@@ -73,15 +86,18 @@ Scene* PlayLayer::scene(GJGameLevel* level)
 void PlayLayer::showCompleteText()
 {
 	m_bEndAnimation = true;
+	publishEpisodeEvent(kEpisodeEventComplete, 0, -1);
+	finishEpisode();
 
 	auto size = Director::getInstance()->getWinSize();
 
 	float scale = 1.1f;
 	const char* spr = "GJ_levelComplete_001.png";
-	/*if (m_isPracticeMode) {
+	if (_practiceMode)
+	{
 		spr = "GJ_practiceComplete_001.png";
 		scale = 1;
-	}*/
+	}
 
 	auto sprite = Sprite::createWithSpriteFrameName(spr);
 	sprite->setScale(0.01f);
@@ -174,12 +190,13 @@ PlayLayer* PlayLayer::create(GJGameLevel* level)
 void PlayLayer::loadLevel(std::string_view levelStr)
 {
 
-	std::vector<std::string_view> objData = GameToolbox::splitByDelimStringView(levelStr, ';');
-	std::vector<std::string_view> levelData = GameToolbox::splitByDelimStringView(objData[0], ',');
-	
-	objData.erase(objData.begin());
+	size_t headerEnd = levelStr.find(';');
+	std::vector<std::string_view> levelData = GameToolbox::splitByDelimStringView(levelStr.substr(0, headerEnd), ',');
+	std::string_view objectString = headerEnd == std::string_view::npos ? std::string_view() : levelStr.substr(headerEnd + 1);
+
+	// every core parses a chunk of the objects, the sprites are then created from them below in level order
+	LevelObjectList objects = LevelObjectList::parse(objectString);
 	
-	std::thread t_colorChannels([&]()
 	{
 		for (size_t i = 0; i < levelData.size() - 1; i += 2)
 		{
@@ -309,209 +326,268 @@ void PlayLayer::loadLevel(std::string_view levelStr)
 			
 		} //for (size_t i = 0; i < levelData.size() - 1; i += 2)
 		
-	}); //thread
-	
-	t_colorChannels.join();
+	}
+
+	setupDefaultColors();
+
+	for (size_t index = 0; index < objects.size(); index++)
+	{
+		GameObject* obj = createLevelObject(objects._objects[index]._objectID);
+		if (!obj)
+			continue;
+
+		for (const LevelObjectProperty& property : objects.getProperties(index))
+			applyObjectProperty(obj, property, objects._hsv, objects._groups);
 
+		finishLevelObject(obj);
+	}
+}
+
+void PlayLayer::loadCompiledLevel(const CompiledLevel& level)
+{
+	const CompiledLevelHeader& header = level.getHeader();
+
+	for (const CompiledColorChannel& channel : level.getColorChannels())
+	{
+		_colorChannels.insert(
+			{channel._id, SpriteColor(ax::Color3B(channel._r, channel._g, channel._b), channel._opacity, channel._blending)});
+	}
+
+	_bgID = header._bgID;
+	_groundID = header._groundID;
+	_levelSettings.gamemode = (PlayerGamemode)header._gamemode;
+	_levelSettings.mini = header._mini;
+	_levelSettings.speed = header._speed;
+	_levelSettings.dual = header._dual;
+	_levelSettings.twoPlayer = header._twoPlayer;
+	_levelSettings.flipGravity = header._flipGravity;
+	_levelSettings.songOffset = header._songOffset;
+
+	setupDefaultColors();
+
+	auto ids = level.getIDs();
+	auto xs = level.getX();
+	auto ys = level.getY();
+	auto rotations = level.getRotation();
+	auto scaleXs = level.getScaleX();
+	auto scaleYs = level.getScaleY();
+	auto zLayers = level.getZLayer();
+	auto mainColors = level.getMainColor();
+	auto secColors = level.getSecColor();
+	auto hsv = level.getHSV();
+
+	for (size_t index = 0; index < level.size(); index++)
+	{
+		GameObject* obj = createLevelObject(ids[index]);
+		if (!obj)
+			continue;
+
+		obj->setPosition(xs[index], ys[index]);
+		obj->setScaleX(scaleXs[index]);
+		obj->setScaleY(scaleYs[index]);
+		obj->setRotation(rotations[index]);
+		// only what the string set, the rest keeps customSetup's defaults from object.json
+		if (zLayers[index] != CompiledLevel::kNotSet)
+			obj->_zLayer = zLayers[index];
+		if (mainColors[index] != CompiledLevel::kNotSet)
+			obj->_mainColorChannel = mainColors[index];
+		if (secColors[index] != CompiledLevel::kNotSet)
+			obj->_secColorChannel = secColors[index];
+
+		auto groups = level.getGroups(index);
+		obj->_groups.reserve(groups.size());
+		for (int g : groups)
+		{
+			_groups[g]._objects.push_back(obj);
+			obj->_groups.push_back(g);
+		}
+
+		for (const LevelObjectProperty& property : level.getProperties(index))
+			applyObjectProperty(obj, property, hsv, {});
+
+		finishLevelObject(obj);
+	}
+}
+
+void PlayLayer::setupDefaultColors()
+{
 	if (!_colorChannels.contains(1004)) {
 		_colorChannels[1004] = {ax::Color3B::WHITE, 255, false};
 	}
-	
-	//STOP
-	std::thread t_gameObjects([&]() {
-		_colorChannels[1005]._color = _player1->getMainColor();
-		_colorChannels[1005]._blending = true;
-		_colorChannels[1006]._color = _player1->getSecondaryColor();
-		_colorChannels[1006]._blending = true;
-		_colorChannels[1010]._color = Color3B::BLACK;
-		_colorChannels[1007]._color = getLightBG();
-
-		_originalColors = _colorChannels;
-
-		for (std::string_view data : objData)
-		{
-			auto d = GameToolbox::splitByDelimStringView(data, ',');
 
-			GameObject* obj = nullptr;
+	_colorChannels[1005]._color = _player1->getMainColor();
+	_colorChannels[1005]._blending = true;
+	_colorChannels[1006]._color = _player1->getSecondaryColor();
+	_colorChannels[1006]._blending = true;
+	_colorChannels[1010]._color = Color3B::BLACK;
+	_colorChannels[1007]._color = getLightBG();
 
-			Hitbox hb = {0, 0, 0, 0};
+	_originalColors = _colorChannels;
+}
 
-			for (size_t i = 0; i < d.size() - 1; i += 2)
-			{
-				int key = GameToolbox::stoi(d[i]);
+GameObject* PlayLayer::createLevelObject(int id)
+{
+	if (!GameObject::_pBlocks.contains(id))
+		return nullptr;
 
-				if (key != 1 && obj == nullptr)
-					break;
+	std::string_view frame = GameObject::_pBlocks.at(id);
 
-				switch (key)
-				{
-				case 1:
-				{
-					int id = GameToolbox::stoi(d[i + 1]);
+	GameObject* obj;
+	if (std::find(std::begin(GameObject::_pTriggers), std::end(GameObject::_pTriggers), id) !=
+		std::end(GameObject::_pTriggers))
+	{
+		obj = EffectGameObject::create(frame);
+		if (obj)
+			obj->_isTrigger = true;
+	}
+	else
+		obj = GameObject::create(frame, GameObject::getGlowFrame(id));
 
-					if (!GameObject::_pBlocks.contains(id))
-						continue;
+	if (obj == nullptr)
+		return nullptr;
 
-					std::string_view frame = GameObject::_pBlocks.at(id);
+	AX_SAFE_RETAIN(obj);
 
-					if (std::find(std::begin(GameObject::_pTriggers), std::end(GameObject::_pTriggers), id) !=
-						std::end(GameObject::_pTriggers))
-					{
-						obj = EffectGameObject::create(frame);
-						obj->_isTrigger = true;
-					}
-					else
-						obj = GameObject::create(frame, GameObject::getGlowFrame(id));
+	obj->setStretchEnabled(false);
+	obj->setActive(true);
+	obj->setID(id);
 
-					if (obj == nullptr)
-						break;
+	// obj->setupColors();
 
-					AX_SAFE_RETAIN(obj);
+	obj->customSetup();
 
-					obj->setStretchEnabled(false);
-					obj->setActive(true);
-					obj->setID(id);
+	if (GameObject::_pHitboxRadius.contains(id))
+		obj->_radius = GameObject::_pHitboxRadius.at(id);
 
-					// obj->setupColors();
+	obj->_uniqueID = _pObjects.size();
 
-					obj->customSetup();
+	_pObjects.push_back(obj);
+	return obj;
+}
 
-					if (GameObject::_pHitboxes.contains(id))
-						hb = GameObject::_pHitboxes.at(id);
-					if (GameObject::_pHitboxRadius.contains(id))
-						obj->_radius = GameObject::_pHitboxRadius.at(id);
+void PlayLayer::applyObjectProperty(GameObject* obj, const LevelObjectProperty& property, std::span<const GDHSV> hsv,
+									std::span<const int> groups)
+{
+	switch (property._key)
+	{
+	case 2:
+		obj->setPositionX(property._float);
+		break;
+	case 3:
+		obj->setPositionY(property._float + 90.0f);
+		break;
+	case 4:
+		obj->setScaleX(-1.f * property._int);
+		break;
+	case 5:
+		obj->setScaleY(-1.f * property._int);
+		break;
+	case 6:
+		obj->setRotation(property._float);
+		break;
+	case 7:
+		dynamic_cast<EffectGameObject*>(obj)->_color.r = property._float;
+		break;
+	case 8:
+		dynamic_cast<EffectGameObject*>(obj)->_color.g = property._float;
+		break;
+	case 9:
+		dynamic_cast<EffectGameObject*>(obj)->_color.b = property._float;
+		break;
+	case 10:
+		dynamic_cast<EffectGameObject*>(obj)->_duration = property._float;
+		break;
+	case 21:
+		obj->_mainColorChannel = property._int;
+		break;
+	case 22:
+		obj->_secColorChannel = property._int;
+		break;
+	case 23:
+		dynamic_cast<EffectGameObject*>(obj)->_targetColorId = property._float;
+		break;
+	case 24:
+		obj->_zLayer = property._int;
+		break;
+	case 25:
+		obj->setGlobalZOrder(property._int);
+		break;
+	case 32:
+		obj->setScaleX(obj->getScaleX() * property._float);
+		obj->setScaleY(obj->getScaleY() * property._float);
+		break;
+	case 35:
+		dynamic_cast<EffectGameObject*>(obj)->_opacity = property._float;
+		break;
+	case 45:
+		dynamic_cast<EffectGameObject*>(obj)->_fadeIn = property._float;
+		break;
+	case 46:
+		dynamic_cast<EffectGameObject*>(obj)->_hold = property._float;
+		break;
+	case 47:
+		dynamic_cast<EffectGameObject*>(obj)->_fadeOut = property._float;
+		break;
+	case 48:
+		dynamic_cast<EffectGameObject*>(obj)->_pulseMode = property._int;
+		break;
+	case 49:
+		dynamic_cast<EffectGameObject*>(obj)->_hsv = hsv[property._first];
+		break;
+	case 50:
+		dynamic_cast<EffectGameObject*>(obj)->_copiedColorId = property._int;
+		break;
+	case 52:
+		dynamic_cast<EffectGameObject*>(obj)->_pulseType = property._int;
+		break;
+	case 51:
+		if (obj->_isTrigger)
+			dynamic_cast<EffectGameObject*>(obj)->_targetGroupId = property._int;
+		break;
+	case 57: {
+		for (int g : groups.subspan(property._first, property._count))
+		{
+			_groups[g]._objects.push_back(obj);
+			obj->_groups.push_back(g);
+		}
+		break;
+	}
+	case 67: // dont enter
+	case 64: // dont exit
+		obj->setDontTransform(true);
+		break;
+	}
+}
 
-					obj->_uniqueID = _pObjects.size();
+void PlayLayer::finishLevelObject(GameObject* obj)
+{
+	Hitbox hb = {0, 0, 0, 0};
+	if (GameObject::_pHitboxes.contains(obj->getID()))
+		hb = GameObject::_pHitboxes.at(obj->getID());
 
-					_pObjects.push_back(obj);
-				}
-				break;
-				case 2:
-					obj->setPositionX(GameToolbox::stof(d[i + 1]));
-					break;
-				case 3:
-					obj->setPositionY(GameToolbox::stof(d[i + 1]) + 90.0f);
-					break;
-				case 4:
-					obj->setScaleX(-1.f * GameToolbox::stoi(d[i + 1]));
-					break;
-				case 5:
-					obj->setScaleY(-1.f * GameToolbox::stoi(d[i + 1]));
-					break;
-				case 6:
-					obj->setRotation(GameToolbox::stof(d[i + 1]));
-					break;
-				case 7:
-					dynamic_cast<EffectGameObject*>(obj)->_color.r = GameToolbox::stof(d[i + 1]);
-					break;
-				case 8:
-					dynamic_cast<EffectGameObject*>(obj)->_color.g = GameToolbox::stof(d[i + 1]);
-					break;
-				case 9:
-					dynamic_cast<EffectGameObject*>(obj)->_color.b = GameToolbox::stof(d[i + 1]);
-					break;
-				case 10:
-					dynamic_cast<EffectGameObject*>(obj)->_duration = GameToolbox::stof(d[i + 1]);
-					break;
-				case 21:
-					obj->_mainColorChannel = GameToolbox::stoi(d[i + 1]);
-					break;
-				case 22:
-					obj->_secColorChannel = GameToolbox::stoi(d[i + 1]);
-					break;
-				case 23:
-					dynamic_cast<EffectGameObject*>(obj)->_targetColorId = GameToolbox::stof(d[i + 1]);
-					break;
-				case 24:
-					obj->_zLayer = GameToolbox::stoi(d[i + 1]);
-					break;
-				case 25:
-					obj->setGlobalZOrder(GameToolbox::stoi(d[i + 1]));
-					break;
-				case 32:
-					obj->setScaleX(obj->getScaleX() * GameToolbox::stof(d[i + 1]));
-					obj->setScaleY(obj->getScaleY() * GameToolbox::stof(d[i + 1]));
-					break;
-				case 35:
-					dynamic_cast<EffectGameObject*>(obj)->_opacity = GameToolbox::stof(d[i + 1]);
-					break;
-				case 45:
-					dynamic_cast<EffectGameObject*>(obj)->_fadeIn = GameToolbox::stof(d[i + 1]);
-					break;
-				case 46:
-					dynamic_cast<EffectGameObject*>(obj)->_hold = GameToolbox::stof(d[i + 1]);
-					break;
-				case 47:
-					dynamic_cast<EffectGameObject*>(obj)->_fadeOut = GameToolbox::stof(d[i + 1]);
-					break;
-				case 48:
-					dynamic_cast<EffectGameObject*>(obj)->_pulseMode = GameToolbox::stoi(d[i + 1]);
-					break;
-				case 49: {
-					auto hsv = GameToolbox::splitByDelimStringView(d[i + 1], 'a');
-					auto trigger = dynamic_cast<EffectGameObject*>(obj);
-					trigger->_hsv.h = GameToolbox::stof(hsv[0]);
-					trigger->_hsv.s = GameToolbox::stof(hsv[1]);
-					trigger->_hsv.v = GameToolbox::stof(hsv[2]);
-					trigger->_hsv.sChecked = GameToolbox::stof(hsv[3]);
-					trigger->_hsv.vChecked = GameToolbox::stof(hsv[4]);
-				}
-				break;
-				case 50:
-					dynamic_cast<EffectGameObject*>(obj)->_copiedColorId = GameToolbox::stoi(d[i + 1]);
-					break;
-				case 52:
-					dynamic_cast<EffectGameObject*>(obj)->_pulseType = GameToolbox::stoi(d[i + 1]);
-					break;
-				case 51:
-					if (obj->_isTrigger)
-						dynamic_cast<EffectGameObject*>(obj)->_targetGroupId = GameToolbox::stoi(d[i + 1]);
-					break;
-				case 57: {
-					auto groups = GameToolbox::splitByDelimStringView(data, '.');
-					for (auto group : groups)
-					{
-						int g = GameToolbox::stoi(group);
-						_groups[g]._objects.push_back(obj);
-						obj->_groups.push_back(g);
-					}
-					break;
-				}
-				case 67: // dont enter
-				case 64: // dont exit
-					obj->setDontTransform(true);
-					break;
-				}
-			}
-			if (obj)
-			{
-				ax::Mat4 tr;
-				ax::Rect rec = {hb.x, hb.y, hb.w, hb.h};
-				switch (obj->getGameObjectType())
-				{
-				default:
+	ax::Mat4 tr;
+	ax::Rect rec = {hb.x, hb.y, hb.w, hb.h};
+	switch (obj->getGameObjectType())
+	{
+	default:
 
-					tr.rotate(obj->getRotationQuat());
+		tr.rotate(obj->getRotationQuat());
 
-					tr.scale(obj->getScaleX() * (obj->isFlippedX() ? -1.f : 1.f),
-							obj->getScaleY() * (obj->isFlippedY() ? -1.f : 1.f), 1);
+		tr.scale(obj->getScaleX() * (obj->isFlippedX() ? -1.f : 1.f),
+				obj->getScaleY() * (obj->isFlippedY() ? -1.f : 1.f), 1);
 
-					rec = RectApplyTransform(rec, tr);
+		rec = RectApplyTransform(rec, tr);
 
-					obj->setOuterBounds(Rect(obj->getPosition() + Vec2(rec.origin.x, rec.origin.y) + Vec2(15, 15),
-											{rec.size.width, rec.size.height}));
-					break;
-				case kGameObjectTypeDecoration:
-				case kGameObjectTypeSpecial:
-					break;
-				}
-				obj->setStartPosition(obj->getPosition());
-				obj->setStartScaleX(obj->getScaleX());
-				obj->setStartScaleY(obj->getScaleY());
-			}
-		}
-	});
-	t_gameObjects.join();
+		obj->setOuterBounds(Rect(obj->getPosition() + Vec2(rec.origin.x, rec.origin.y) + Vec2(15, 15),
+								{rec.size.width, rec.size.height}));
+		break;
+	case kGameObjectTypeDecoration:
+	case kGameObjectTypeSpecial:
+		break;
+	}
+	obj->setStartPosition(obj->getPosition());
+	obj->setStartScaleX(obj->getScaleX());
+	obj->setStartScaleY(obj->getScaleY());
 }
 
 void PlayLayer::setInstance() {
@@ -558,23 +634,18 @@ bool PlayLayer::init(GJGameLevel* level)
 	_player2->setSecondaryColor({0, 255, 255});
 
 	// std::string levelStr = FileUtils::getInstance()->getStringFromFile("level.txt");
-	std::string levelStr = level->_levelString;
+	std::string_view levelStr = level->_levelString;
 
 	if (levelStr.empty())
-	{
-		nlohmann::json file = nlohmann::json::parse(FileUtils::getInstance()->getStringFromFile("Custom/mainLevels.json"));
-		if (file.contains(std::to_string(level->_levelID))) {
-			levelStr = fmt::format("H4sIAAAAAAAAA{}", file[std::to_string(level->_levelID)].get<std::string>());
-		}
-	}
+		levelStr = LevelCache::getInstance()->getMainLevel(level->_levelID);
 
 	// scope based timer
 	{
 		auto s = BenchmarkTimer("load level");
-		if (!levelStr.empty()) {
-			if (levelStr.at(0) != 'k') levelStr = GJGameLevel::decompressLvlStr(levelStr);
-			loadLevel(levelStr);
-		}
+		// compiled once, every attempt after the first and every process sharing the cache directory
+		// builds the objects straight from the mapped arrays
+		if (auto compiled = LevelCache::getInstance()->getCompiled(level->_levelID, levelStr))
+			loadCompiledLevel(*compiled);
 	}
 
 	this->_bottomGround = GroundLayer::create(_groundID);
@@ -648,6 +719,23 @@ bool PlayLayer::init(GJGameLevel* level)
 		}
 	}
 
+	buildSimulation();
+	_practiceMode = TrainingOptions::getInstance()->_practiceMode;
+
+	if (auto& genome = TrainingOptions::getInstance()->_genomePath; !genome.empty())
+	{
+		NeatNetwork network;
+		if (network.loadFromFile(genome))
+		{
+			_controller = std::make_unique<NeatController>(std::move(network));
+			if (!_controller->isValid())
+			{
+				GameToolbox::log("genome {} doesn't take {} inputs, ignoring it", genome, NeatController::kInputCount);
+				_controller.reset();
+			}
+		}
+	}
+
 	m_pHudLayer = UILayer::create();
 
 	m_pBar = SimpleProgressBar::create();
@@ -697,7 +785,7 @@ bool PlayLayer::init(GJGameLevel* level)
 
 void PlayLayer::createLevelEnd()
 {
-	_jumps = _player1->_jumpedTimes;
+	_jumps = _player1->getJumpedTimes();
 	auto levelend = EndLevelLayer::create(this);
 	addChild(levelend);
 }
@@ -718,9 +806,6 @@ void PlayLayer::update(float dt)
 {
     BaseGameLayer::update(dt);
     
-    // Write player position every frame
-    this->writePlayerPositionToFile();
-    
     if (m_freezePlayer)
 	{
 		AudioEngine::pauseAll();
@@ -733,9 +818,9 @@ void PlayLayer::update(float dt)
 
 	float step = std::min(2.0f, dt * 60.0f);
 
-	_player1->m_bIsPlatformer = m_platformerMode;
-	_player1->noclip = noclip;
-	_player2->noclip = noclip;
+	_player1->setPlatformer(m_platformerMode);
+	_player1->setNoclip(noclip);
+	_player2->setNoclip(noclip);
 
 	auto winSize = Director::getInstance()->getWinSize();
 
@@ -744,38 +829,88 @@ void PlayLayer::update(float dt)
 
 	_colorChannels[1007]._color = getLightBG();
 
+	// the camera and the ship rotation move once per frame, by the time the frame simulated
+	auto follow = [this](float frameStep) {
+		this->updateCamera(frameStep);
+		if (_player1->_currentGamemode == PlayerGamemodeShip)
+			_player1->updateShipRotation(frameStep);
+		if (_isDualMode && _player2->_currentGamemode == PlayerGamemodeShip)
+			_player2->updateShipRotation(frameStep);
+	};
+
+	auto options = TrainingOptions::getInstance();
+	// ticks fast forward has simulated since it last moved them
+	int unfollowedTicks = 0;
+
 	if (!m_freezePlayer && (!this->_player1->isDead() || !this->_player2->isDead()))
 	{
-		step /= 4.0f;
-		lastY = _player1->getYVel();
-		for (int i = 0; i < 4; i++)
+		auto observations = ObservationChannel::getInstance();
+		auto inputs = InputChannel::getInstance();
+
+		// variable mode splits the frame into 4 substeps, fixed mode runs however many whole
+		// ticks of real time have passed, so the physics never sees the frame pacing
+		int substeps = 4;
+		float substep = step / 4.0f;
+		if (options->_fastForward)
 		{
-			this->_player1->update(step);
-
-			_player1->setOuterBounds(Rect(_player1->getPosition(), Vec2(30, 30)));
-			_player1->setInnerBounds(Rect(_player1->getPosition() + Vec2(11.25f, 11.25f), Vec2(7.5, 7.5)));
-
-			this->checkCollisions(_player1, step);
-
-			if (this->_player1->isDead())
-				break;
-
-			if (!_isDualMode)
-				continue;
-
-			this->_player2->update(step);
-
-			_player2->setOuterBounds(Rect(_player1->getPosition(), Vec2(30, 30)));
-			_player2->setInnerBounds(Rect(_player1->getPosition() + Vec2(11.25f, 11.25f), Vec2(7.5, 7.5)));
+			// real time doesn't matter, only how many frames to simulate before the next draw
+			substeps = options->_renderEvery * (SimWorld::kTickRate / 60);
+			substep = SimWorld::kTickStep;
+		}
+		else if (options->_fixedTimestep)
+		{
+			// same 2 frame cap as above, past that the leftover time is dropped
+			constexpr int maxTicks = SimWorld::kTickRate / 30;
+			_tickAccumulator += dt;
+			substeps = static_cast<int>(_tickAccumulator * SimWorld::kTickRate);
+			if (substeps > maxTicks)
+			{
+				substeps = maxTicks;
+				_tickAccumulator = 0.0;
+			}
+			else
+				_tickAccumulator -= static_cast<double>(substeps) / SimWorld::kTickRate;
+			substep = SimWorld::kTickStep;
+			step = substeps * SimWorld::kTickStep;
+		}
 
-			this->checkCollisions(_player2, step);
+		lastY = _player1->getYVel();
+		for (int i = 0; i < substeps; i++)
+		{
+			InputRecord command;
+			while (inputs->isOpen() && inputs->apply(*_world, command))
+				runInputCommand(command);
+			if (_controller && _world->_tick % options->_actionRepeat == 0)
+				_controller->apply(*_world);
+
+			_world->step(substep);
+			_episodeStats.update(*_world);
+			if (_world->_recordInputs)
+				_replayRecorder.afterStep(*_world);
+			processSimulationEvents(substep);
+
+			if (observations->isOpen())
+				observations->publish(*_world);
+
+			this->_player1->update(substep);
+			if (_isDualMode && !this->_player1->isDead())
+				this->_player2->update(substep);
+
+			// fast forward draws once per many frames, in between the camera and rotation follow
+			// every simulated 60 fps frame like they would in fixed mode
+			if (options->_fastForward && ++unfollowedTicks == SimWorld::kTickRate / 60)
+			{
+				follow(unfollowedTicks * SimWorld::kTickStep);
+				unfollowedTicks = 0;
+			}
 
-			if (this->_player2->isDead())
+			if (this->_player1->isDead() || (_isDualMode && this->_player2->isDead()))
 				break;
 		}
-		step *= 4.0f;
 	}
 
+	drawHitboxes();
+
 	m_pBar->setPercentage(_player1->getPositionX() / this->m_lastObjXPos * 100.f);
 	float val = m_pBar->getPercentage();
 	m_pPercentage->setString(StringUtils::format("%.02f%%", val > 100 ? 100 : val < 0 ? 0 : val));
@@ -784,39 +919,15 @@ void PlayLayer::update(float dt)
 		this->showCompleteText();
 
 	this->updateVisibility();
-	this->updateCamera(step);
-	if (_player1->_currentGamemode == PlayerGamemodeShip)
-		_player1->updateShipRotation(step);
-	if (_isDualMode && _player2->_currentGamemode == PlayerGamemodeShip)
-		_player2->updateShipRotation(step);
+	if (!options->_fastForward)
+		follow(step);
+	else if (unfollowedTicks > 0)
+		follow(unfollowedTicks * SimWorld::kTickStep);
 
 	_colorChannels[1005]._color = _player1->getMainColor();
 	_colorChannels[1006]._color = _player1->getSecondaryColor();
 }
 
-void PlayLayer::writePlayerPositionToFile() {
-    // Make sure we have a player
-    if (!this->_player1) return;
-    
-    // Get player position and state
-    auto pos = this->_player1->getPosition();
-    
-    // Use the correct member variables or accessor methods
-    // Since we don't know the exact names, let's use safer alternatives
-    float y_vel = 0.0f;  // Default value
-    bool on_ground = false;  // Default value
-    bool is_dead = this->_player1->isDead();
-    
-    // Open file in write mode
-    std::ofstream file("player_position.txt");
-    if (file.is_open()) {
-        // Write x,y coordinates, y velocity, ground state, and death state
-        file << pos.x << "," << pos.y << "," << y_vel << "," 
-             << (on_ground ? "1" : "0") << "," << (is_dead ? "1" : "0");
-        file.close();
-    }
-}
-
 ax::Color3B PlayLayer::getLightBG()
 {
 	return _colorChannels[1000]._color;
@@ -824,15 +935,43 @@ ax::Color3B PlayLayer::getLightBG()
 
 void PlayLayer::destroyPlayer(PlayerObject* player)
 {
-	if (player->isDead() || player->noclip)
-		return;
-
-	player->setIsDead(true);
+	// SimWorld already marked the player dead, this is the death effect and the restart
 	player->playDeathEffect();
 	player->stopRotation();
 	player->setVisible(false);
 
-	scheduleOnce([&](float d) { resetLevel(); }, 1.f, "playlayer_restart");
+	// nobody is watching the death effect when fast forwarding
+	float delay = TrainingOptions::getInstance()->_fastForward ? 0.f : 1.f;
+	scheduleOnce([&](float d) { resetLevel(); }, delay, "playlayer_restart");
+}
+
+void PlayLayer::publishEpisodeEvent(EpisodeEventType type, int player, int object)
+{
+	auto events = EventChannel::getInstance();
+	if (!events->isOpen())
+		return;
+
+	EpisodeEvent event{};
+	event._tick = _world->_tick;
+	event._attempt = _attempts;
+	event._object = object;
+	event._x = _world->getPlayer(player)._position.x;
+	event._percentage = _world->getPercentage();
+	event._type = type;
+	event._player = player;
+	events->publish(event);
+}
+
+void PlayLayer::finishEpisode()
+{
+	if (_episodeFinished || _episodeStats._ticks == 0)
+		return;
+	_episodeFinished = true;
+
+	if (auto log = EpisodeSummaryLog::getInstance(); log->isOpen())
+		log->write(EpisodeSummaryLog::makeSummary(_episodeStats, *_world->_level, _attempts));
+	if (_world->_recordInputs)
+		ReplayLog::getInstance()->write(_replayRecorder.finish(*_world), _attempts);
 }
 
 void PlayLayer::updateCamera(float dt)
@@ -878,7 +1017,7 @@ void PlayLayer::updateCamera(float dt)
 	cam.y = clampf(cam.y, 0.0f, 1140.f - winSize.height);
 
 	if (pPos.x >= winSize.width / 2.5f && !_player1->isDead() && !_player2->isDead() &&
-		!player->m_bIsPlatformer) // wrong but works for now
+		!player->isPlatformer()) // wrong but works for now
 	{
 		this->m_pBG->setPositionX(this->m_pBG->getPositionX() -
 								  dt * player->getPlayerSpeed() * _bottomGround->getSpeed() * 0.1175f);
@@ -886,7 +1025,7 @@ void PlayLayer::updateCamera(float dt)
 		_ceiling->update(dt * player->getPlayerSpeed());
 		cam.x = pPos.x - (winSize.width / 2.5f);
 	}
-	else if (player->m_bIsPlatformer)
+	else if (player->isPlatformer())
 		cam.x = pPos.x - winSize.width / 2.f;
 
 	if (this->m_pBG->getPosition().x <= cam.x - 1024.f)
@@ -1209,30 +1348,16 @@ void PlayLayer::updateVisibility()
 	this->_nextSection = nextSection;
 }
 
-void PlayLayer::changeGameMode(GameObject* obj, PlayerObject* player, PlayerGamemode gameMode)
+void PlayLayer::changeGameMode(PlayerObject* player, PlayerGamemode gameMode)
 {
-	obj->triggerActivated(player);
 	switch (gameMode)
 	{
 	case PlayerGamemodeShip:
 	case PlayerGamemodeUFO:
 	case PlayerGamemodeWave:
-		if (obj->getPositionY() < 270)
-			m_fCameraYCenter = 240.0f;
-		else
-			m_fCameraYCenter = (floorf(obj->getPositionY() / 30.0f) * 30.0f);
-
-		tweenBottomGround(-68);
-		tweenCeiling(388);
-		break;
 	case PlayerGamemodeBall:
-		if (obj->getPositionY() < 240.0f)
-			m_fCameraYCenter = 210.0f;
-		else
-			m_fCameraYCenter = (floorf(obj->getPositionY() / 30.0f) * 30.0f);
-
-		tweenBottomGround(-38);
-		tweenCeiling(358);
+		tweenBottomGround(_world->_bottomGroundY);
+		tweenCeiling(_world->_ceilingY);
 		break;
 	default:
 		break;
@@ -1262,277 +1387,138 @@ void PlayLayer::moveCameraToPos(Vec2 pos)
 	moveY(pos.y, 1.2f, 1.8f);
 }
 
-void PlayLayer::checkCollisions(PlayerObject* player, float dt)
+void PlayLayer::buildSimulation()
 {
-	auto playerOuterBounds = player->_mini ? player->getOuterBounds(0.6f, 0.6f) : player->getOuterBounds();
-	if (player->getPositionY() < (player->_mini ? 99.f : 105.0f) && player->_currentGamemode == PlayerGamemodeCube)
-	{
-		if (player->isGravityFlipped())
-		{
-			this->destroyPlayer(player);
-			return;
-		}
+	// checkpoints are snapshots of the old world, its object indices may not mean anything anymore
+	clearCheckpoints();
 
-		player->setPositionY((player->_mini ? 99.f : 105.0f));
+	std::vector<SimObject> objects;
+	objects.reserve(_pObjects.size());
 
-		player->hitGround(false);
-	}
-
-	else if (player->getPositionY() > 1290.0f)
+	for (size_t i = 0; i < _pObjects.size(); i++)
 	{
-		this->destroyPlayer(player);
-		return;
-	}
+		GameObject* obj = _pObjects[i];
+		if (!obj)
+			continue;
 
-	if (player->_currentGamemode != PlayerGamemodeCube)
-	{
-		if (player->getPositionY() <
-			_bottomGround->getPositionY() + cameraFollow->getPositionY() + (player->_mini ? 87.f : 93.0f))
-		{
-			player->setPositionY(_bottomGround->getPositionY() + cameraFollow->getPositionY() +
-								 (player->_mini ? 87.f : 93.0f));
+		Rect bounds = obj->getOuterBounds();
+		Vec2 pos = obj->getStartPosition();
+
+		SimObject simObject;
+		simObject._id = obj->getID();
+		simObject._uniqueID = i;
+		simObject._type = obj->getGameObjectType();
+		simObject._isTrigger = obj->_isTrigger;
+		simObject._position = {pos.x, pos.y};
+		simObject._outerBounds = {bounds.origin.x, bounds.origin.y, bounds.size.width, bounds.size.height};
+		simObject._radius = obj->_radius;
+		objects.push_back(simObject);
+	}
 
-			if (!player->isGravityFlipped())
-				player->hitGround(false);
+	SimLevelSettings settings;
+	settings.gamemode = _levelSettings.gamemode;
+	settings.mini = _levelSettings.mini;
+	settings.dual = _levelSettings.dual;
+	settings.flipGravity = _levelSettings.flipGravity;
+	settings.speed = _levelSettings.speed;
+
+	_world = std::make_unique<SimWorld>(SimLevel::create(std::move(objects), settings, m_lastObjXPos));
+
+	_world->_seed = TrainingOptions::getInstance()->_seed;
+	// a replay only plays back the same with fixed ticks
+	_world->_recordInputs = ReplayLog::getInstance()->isOpen() && TrainingOptions::getInstance()->_fixedTimestep;
+
+	_player1->bindState(&_world->_player1);
+	_player2->bindState(&_world->_player2);
+
+	// built from the loaded level rather than saved, the editor rebuilds in the middle of a session
+	_startSnapshot._colorChannels = _originalColors;
+	_startSnapshot._groups.clear();
+	const GroupProperties defaults;
+	for (const auto& [id, group] : _groups)
+		_startSnapshot._groups.push_back({id, defaults._alpha, defaults._color, defaults.groupState});
+	_startSnapshot._objectOffsets.assign(_pObjects.size(), Vec2::ZERO);
+	_startSnapshot._cameraPos = Vec2::ZERO;
+	_startSnapshot._enterEffectID = 0;
+}
 
-			player->setYVel(0.f);
-		}
-		if (player->getPositionY() >
-			_ceiling->getPositionY() - (player->_mini ? 234.f : 240.f) + m_fCameraYCenter - 12.f)
-		{
-			player->setPositionY(_ceiling->getPositionY() - (player->_mini ? 234.f : 240.f) + m_fCameraYCenter - 12.f);
+void PlayLayer::processSimulationEvents(float dt)
+{
+	m_fCameraYCenter = _world->_cameraYCenter;
 
-			if (player->isGravityFlipped())
-				player->hitGround(true);
+	for (const SimEvent& event : _world->_events)
+	{
+		PlayerObject* player = event._player == 0 ? _player1 : _player2;
+		GameObject* obj = event._object < 0 ? nullptr : _pObjects[_world->_level->_objects[event._object]._uniqueID];
 
-			player->setYVel(0.f);
+		switch (event._type)
+		{
+		case kSimEventObjectTouched: {
+			auto pos = obj->getPosition();
+			if (obj->getGameObjectType() == kGameObjectTypeGravityPad)
+				pos.y -= 10;
+			player->setPortalP(pos);
+			player->setPortalObject(obj);
+			break;
+		}
+		case kSimEventObjectActivated:
+			obj->triggerActivated(player);
+			break;
+		case kSimEventGamemodeChanged:
+			changeGameMode(player, player->getState()->_gamemode);
+			break;
+		case kSimEventTriggerCrossed:
+			if (auto trigger = dynamic_cast<EffectGameObject*>(obj))
+				trigger->triggerActivated(dt);
+			break;
+		case kSimEventPlayerDied:
+			publishEpisodeEvent(kEpisodeEventDeath, event._player, event._object);
+			finishEpisode();
+			destroyPlayer(player);
+			break;
 		}
 	}
+}
 
+void PlayLayer::drawHitboxes()
+{
 	dn->setVisible(showDn);
 
-	if (showDn)
-	{
-		dn->clear();
-		renderRect(playerOuterBounds, ax::Color4B::RED);
-		renderRect(player->getInnerBounds(), ax::Color4B::GREEN);
-	}
+	if (!showDn)
+		return;
 
-	int current_section = this->sectionForPos(player->getPositionX());
+	dn->clear();
 
-	std::deque<GameObject*> m_pHazards;
+	const SimLevel& level = *_world->_level;
 
-	for (int i = current_section - 2; i < current_section + 1; i++)
+	for (int p = 0; p < (_isDualMode ? 2 : 1); p++)
 	{
-		if (i < _sectionObjects.size() && i >= 0)
-		{
-			std::vector<GameObject*> section = _sectionObjects[i];
-
-			for (int j = 0; j < section.size(); j++)
-			{
-				GameObject* obj = section[j];
-
-				if (!obj)
-					continue;
-
-				auto objBounds = obj->getOuterBounds();
-
-				if ((objBounds.size.width <= 0 || objBounds.size.height <= 0))
-					continue;
-
-				if (obj->getGameObjectType() == kGameObjectTypeHazard)
-				{
-					m_pHazards.push_back(obj);
-					if (showDn)
-					{
-						if (obj->_radius <= 0)
-							renderRect(objBounds, ax::Color4B::RED);
-						else
-							dn->drawCircle(obj->getPosition() + Vec2(15, 15), obj->_radius, 0, 20, 0, ax::Color4B::RED);
-					}
-				}
-				else if (obj->isActive())
-				{
-					if (obj->_isTrigger)
-					{
-						auto trigger = dynamic_cast<EffectGameObject*>(obj);
-						if (!trigger->_wasTriggerActivated && trigger->getPositionX() <= player->getPositionX())
-						{
-							trigger->triggerActivated(dt);
-						}
-					}
-					if (showDn)
-					{
-						renderRect(objBounds, ax::Color4B::BLUE);
-					}
-
-					if (playerOuterBounds.intersectsRect(objBounds) && !obj->hasBeenActivatedByPlayer(player))
-					{
-						switch (obj->getGameObjectType())
-						{
-						case kGameObjectTypeInverseGravityPortal:
-							// if (!player->isGravityFlipped())
-							//	 this->playGravityEffect(true);
-							obj->triggerActivated(player);
-							player->setPortalP(obj->getPosition());
-							player->setPortalObject(obj);
-
-							changeGravity(true);
-							break;
-
-						case kGameObjectTypeNormalGravityPortal:
-							// if (player->isGravityFlipped())
-							//	 this->playGravityEffect(false);
-							obj->triggerActivated(player);
-							player->setPortalP(obj->getPosition());
-							player->setPortalObject(obj);
-
-							changeGravity(false);
-							break;
-
-						case kGameObjectTypeShipPortal:
-							player->setPortalP(obj->getPosition());
-							player->setPortalObject(obj);
+		const SimPlayer& player = _world->getPlayer(p);
 
-							this->changeGameMode(obj, player, PlayerGamemodeShip);
-							break;
-
-						case kGameObjectTypeBallPortal:
-							player->setPortalP(obj->getPosition());
-							player->setPortalObject(obj);
-
-							this->changeGameMode(obj, player, PlayerGamemodeBall);
-							break;
-
-						case kGameObjectTypeUfoPortal:
-							player->setPortalP(obj->getPosition());
-							player->setPortalObject(obj);
-
-							this->changeGameMode(obj, player, PlayerGamemodeUFO);
-							break;
-
-						case kGameObjectTypeCubePortal:
+		renderRect(toRect(player.getCollisionBounds()), ax::Color4B::RED);
+		renderRect(toRect(player._innerBounds), ax::Color4B::GREEN);
 
-							player->setPortalP(obj->getPosition());
-							player->setPortalObject(obj);
+		int current_section = SimLevel::sectionForPos(player._position.x);
 
-							this->changeGameMode(obj, player, PlayerGamemodeCube);
-							break;
-
-						case kGameObjectTypeYellowJumpPad:
-							player->setPortalP(obj->getPosition());
-							player->setPortalObject(obj);
-							obj->triggerActivated(player);
-							player->propellPlayer(1);
-							player->_touchedPadObject = obj;
-							break;
-
-						case kGameObjectTypeGravityPad: {
-							if (player->_touchedPadObject)
-								break;
-							auto pos = obj->getPosition();
-							pos.y -= 10;
-							player->setPortalP(pos);
-							player->setPortalObject(obj);
-							obj->triggerActivated(player);
-							player->propellPlayer(0.8);
-							player->_touchedPadObject = obj;
-							changeGravity(!player->isGravityFlipped());
-							break;
-						}
-
-						case kGameObjectTypePinkJumpPad:
-							player->setPortalP(obj->getPosition());
-							player->setPortalObject(obj);
-							obj->triggerActivated(player);
-							player->propellPlayer(0.65);
-							player->_touchedPadObject = obj;
-							break;
-
-						case kGameObjectTypeRedJumpPad:
-							player->setPortalP(obj->getPosition());
-							player->setPortalObject(obj);
-							obj->triggerActivated(player);
-							player->propellPlayer(1.25);
-							player->_touchedPadObject = obj;
-							break;
-
-						case kGameObjectTypeYellowJumpRing:
-						case kGameObjectTypeDashRing:
-						case kGameObjectTypeGravityRing:
-						case kGameObjectTypeRedJumpRing:
-						case kGameObjectTypePinkJumpRing:
-						case kGameObjectTypeDropRing:
-						case kGameObjectTypeGreenRing:
-							player->setPortalP(obj->getPosition());
-							player->setPortalObject(obj);
+		for (int i = current_section - 2; i < current_section + 1; i++)
+		{
+			if (i < 0 || i >= level.getSectionCount())
+				continue;
 
-							player->setTouchedRing(obj);
+			for (uint32_t j = level._sectionStart[i]; j < level._sectionStart[i + 1]; j++)
+			{
+				const SimObject& obj = level._objects[level._sectionObjects[j]];
 
-							player->ringJump(obj);
-							break;
-						case kGameObjectTypeModifier:
-							switch (obj->getID())
-							{
-							case 201:
-								changePlayerSpeed(0);
-								break;
-							case 200:
-								changePlayerSpeed(1);
-								break;
-							case 202:
-								changePlayerSpeed(2);
-								break;
-							case 203:
-								changePlayerSpeed(3);
-								break;
-							case 1334:
-								changePlayerSpeed(4);
-								break;
-							}
-							break;
-						case kGameObjectTypeSpecial:
-						case kGameObjectTypeNormalMirrorPortal:
-						case kGameObjectTypeInverseMirrorPortal:
-							break;
-						case kGameObjectTypeMiniSizePortal:
-							obj->triggerActivated(player);
-							player->setPortalP(obj->getPosition());
-							player->setPortalObject(obj);
-							player->toggleMini(true);
-							break;
-						case kGameObjectTypeRegularSizePortal:
-							obj->triggerActivated(player);
-							player->setPortalP(obj->getPosition());
-							player->setPortalObject(obj);
-							player->toggleMini(false);
-							break;
-						default:
-							player->collidedWithObject(dt, obj);
-							break;
-						}
-					}
-				}
+				if (obj._type != kGameObjectTypeHazard)
+					renderRect(toRect(obj._outerBounds), ax::Color4B::BLUE);
+				else if (obj._radius <= 0)
+					renderRect(toRect(obj._outerBounds), ax::Color4B::RED);
+				else
+					dn->drawCircle(Vec2(obj._position.x, obj._position.y) + Vec2(15, 15), obj._radius, 0, 20, 0,
+								   ax::Color4B::RED);
 			}
 		}
 	}
-	for (unsigned int i = 0; i < m_pHazards.size(); ++i)
-	{
-		GameObject* hazard = m_pHazards[i];
-		if (hazard->_radius > 0)
-		{
-			if (playerOuterBounds.intersectsCircle(hazard->getPosition() + Vec2(15, 15), hazard->_radius))
-				destroyPlayer(player);
-		}
-		else if (playerOuterBounds.intersectsRect(hazard->getOuterBounds()))
-		{
-			destroyPlayer(player);
-		}
-	}
-	m_pHazards.clear();
-
-	if (player->_currentGamemode == PlayerGamemodeShip)
-		player->_queuedHold = false;
 }
 
 void PlayLayer::onDrawImGui()
@@ -1544,10 +1530,12 @@ void PlayLayer::onDrawImGui()
 
 	ImGui::Begin("PlayLayer Debug");
 
-	ImGui::Text("%s", std::to_string(_player1->_queuedHold).c_str());
+	ImGui::Text("%s", std::to_string(_player1->getState()->_queuedHold).c_str());
 
 	ImGui::Checkbox("Freeze Player", &m_freezePlayer);
 	ImGui::Checkbox("Platformer Mode (Basic)", &m_platformerMode);
+	if (ImGui::Checkbox("Practice Mode", &_practiceMode) && !_practiceMode)
+		clearCheckpoints();
 
 #ifdef AX_PLATFORM_PC
 	if (ImGui::Checkbox("Fullscreen", &fullscreen))
@@ -1616,6 +1604,19 @@ void PlayLayer::onDrawImGui()
 
 void PlayLayer::resetLevel()
 {
+	// the trainer's inputs still waiting were for the attempt that just ended
+	InputChannel::getInstance()->clear();
+
+	if (_practiceMode && !_checkpoints.empty())
+		startFromCheckpoint(-1);
+	else
+		startFromX(0.f);
+}
+
+void PlayLayer::startFromX(float x)
+{
+	// a restart before dying or finishing still ends the attempt
+	finishEpisode();
 	_attempts++;
 	auto dir = Director::getInstance();
 	_player1->setPosition({2, 105});
@@ -1625,147 +1626,301 @@ void PlayLayer::resetLevel()
 	_player2->setRotation(0);
 	_player2->setVisible(false);
 	_player2->setActive(false);
-	m_obCamPos.x = 0;
-	m_obCamPos.y = 0;
 	_bottomGround->setPositionX(0);
 	_ceiling->setPositionX(0);
 	_player1->reset();
 	_player2->reset();
 	m_pBG->setPositionX(dir->getWinSize().x / 2);
-	_enterEffectID = 0;
 	m_bEndAnimation = false;
 	_isDualMode = false;
 	_secondsSinceStart = 0;
 
-	for (size_t i = 0; i < _groups.size(); i++)
-		_groups[i]._alpha = 1.f;
+	// the scene goes back to the level as loaded, only the sections on screen are touched
+	restoreScene(_startSnapshot);
 
-	for (size_t i = 0; i < _groups.size(); i++)
-		_groups[i]._alpha = 1.f;
+	if (this->_colorChannels.contains(1000))
+		this->m_pBG->setColor(this->_colorChannels.at(1000)._color);
+	else {
+		this->m_pBG->setColor(ax::Color3B::GRAY);
+		this->_colorChannels[1000]._color = ax::Color3B::GRAY;
+	}
+	this->_bottomGround->update(0);
+	this->_ceiling->update(0);
+
+	AudioEngine::stopAll();
+	AudioEngine::setCurrentTime(AudioEngine::play2d(LevelTools::getAudioFilename(getLevel()->_musicID), false, 0.1f),
+								_levelSettings.songOffset);
 
-	for (auto obj : this->_pObjects)
+	_world->resetAt(x);
+	_episodeStats.reset(*_world);
+	_replayRecorder.begin(*_world, getLevel()->_levelID);
+	_episodeFinished = false;
+	_tickAccumulator = 0.0;
+	if (_controller)
+		_controller->reset();
+	publishEpisodeEvent(kEpisodeEventReset, 0, -1);
+	processSimulationEvents(0.f);
+	_player1->syncWithState();
+	_player2->syncWithState();
+	m_obCamPos.x = std::max(0.f, _player1->getPositionX() - dir->getWinSize().width / 2.5f);
+	m_obCamPos.y = m_fCameraYCenter;
+	_isDualMode = _world->_isDualMode;
+	if (_isDualMode)
 	{
-		if (!obj)
-			continue;
-		if (obj->_isTrigger)
+		// toggle dual
+	}
+	scheduleUpdate();
+}
+
+void PlayLayer::saveSnapshot(PlayLayerSnapshot& snapshot) const
+{
+	_world->saveSnapshot(snapshot._sim);
+	snapshot._colorChannels = _colorChannels;
+
+	snapshot._groups.clear();
+	for (const auto& [id, group] : _groups)
+		snapshot._groups.push_back({id, group._alpha, group._color, group.groupState});
+
+	snapshot._objectOffsets.resize(_pObjects.size());
+	for (size_t i = 0; i < _pObjects.size(); i++)
+		snapshot._objectOffsets[i] = _pObjects[i] ? _pObjects[i]->_startPosOffset : Vec2::ZERO;
+
+	snapshot._cameraPos = m_obCamPos;
+	snapshot._enterEffectID = _enterEffectID;
+}
+
+void PlayLayer::hideObject(GameObject* obj)
+{
+	obj->setActive(false);
+	if (obj->getParent() == nullptr)
+		return;
+
+	if (obj->_particle)
+	{
+		AX_SAFE_RETAIN(obj->_particle);
+		removeChild(obj->_particle, true);
+	}
+	if (obj->_glowSprite)
+	{
+		AX_SAFE_RETAIN(obj->_glowSprite);
+		_glowBatchNode->removeChild(obj->_glowSprite, true);
+	}
+	AX_SAFE_RETAIN(obj);
+	//_mainBatchNode->removeChild(obj, true);
+	if (isObjectBlending(obj))
+	{
+		switch (obj->_zLayer)
 		{
-			auto trigger = dynamic_cast<EffectGameObject*>(obj);
-			trigger->_wasTriggerActivated = false;
+		case -3:
+			_blendingBatchNodeB4->removeChild(obj, true);
+			break;
+		case -1:
+			_blendingBatchNodeB3->removeChild(obj, true);
+			break;
+		case 1:
+			_blendingBatchNodeB2->removeChild(obj, true);
+			break;
+		case 3:
+			_blendingBatchNodeB1->removeChild(obj, true);
+			break;
+		default:
+		case 5:
+			_blendingBatchNodeT1->removeChild(obj, true);
+			break;
+		case 7:
+			_blendingBatchNodeT2->removeChild(obj, true);
+			break;
+		case 9:
+			_blendingBatchNodeT3->removeChild(obj, true);
+			break;
 		}
-		obj->_hasBeenActivatedP1 = false;
-		obj->_hasBeenActivatedP2 = false;
-		obj->_effectOpacityMultipler = 1.f;
-		obj->setActive(false);
-		if (obj->getParent() != nullptr)
+	}
+	else
+	{
+		if (obj->_texturePath == _mainBatchNodeTexture)
 		{
-			if (obj->_particle)
-			{
-				AX_SAFE_RETAIN(obj->_particle);
-				removeChild(obj->_particle, true);
-			}
-			if (obj->_glowSprite)
-			{
-				AX_SAFE_RETAIN(obj->_glowSprite);
-				_glowBatchNode->removeChild(obj->_glowSprite, true);
-			}
-			AX_SAFE_RETAIN(obj);
-			//_mainBatchNode->removeChild(obj, true);
-			if (isObjectBlending(obj))
+			switch (obj->_zLayer)
 			{
-				switch (obj->_zLayer)
-				{
-				case -3:
-					_blendingBatchNodeB4->removeChild(obj, true);
-					break;
-				case -1:
-					_blendingBatchNodeB3->removeChild(obj, true);
-					break;
-				case 1:
-					_blendingBatchNodeB2->removeChild(obj, true);
-					break;
-				case 3:
-					_blendingBatchNodeB1->removeChild(obj, true);
-					break;
-				default:
-				case 5:
-					_blendingBatchNodeT1->removeChild(obj, true);
-					break;
-				case 7:
-					_blendingBatchNodeT2->removeChild(obj, true);
-					break;
-				case 9:
-					_blendingBatchNodeT3->removeChild(obj, true);
-					break;
-				}
-			}
-			else
-			{
-				if (obj->_texturePath == _mainBatchNodeTexture)
-				{
-					switch (obj->_zLayer)
-					{
-					case -3:
-						_mainBatchNodeB4->removeChild(obj, true);
-						break;
-					case -1:
-						_mainBatchNodeB3->removeChild(obj, true);
-						break;
-					case 1:
-						_mainBatchNodeB2->removeChild(obj, true);
-						break;
-					case 3:
-						_mainBatchNodeB1->removeChild(obj, true);
-						break;
-					default:
-					case 5:
-						_mainBatchNodeT1->removeChild(obj, true);
-						break;
-					case 7:
-						_mainBatchNodeT2->removeChild(obj, true);
-						break;
-					case 9:
-						_mainBatchNodeT3->removeChild(obj, true);
-						break;
-					}
-				}
-				else if (obj->_texturePath == _main2BatchNodeTexture)
-					_main2BatchNode->removeChild(obj, true);
+			case -3:
+				_mainBatchNodeB4->removeChild(obj, true);
+				break;
+			case -1:
+				_mainBatchNodeB3->removeChild(obj, true);
+				break;
+			case 1:
+				_mainBatchNodeB2->removeChild(obj, true);
+				break;
+			case 3:
+				_mainBatchNodeB1->removeChild(obj, true);
+				break;
+			default:
+			case 5:
+				_mainBatchNodeT1->removeChild(obj, true);
+				break;
+			case 7:
+				_mainBatchNodeT2->removeChild(obj, true);
+				break;
+			case 9:
+				_mainBatchNodeT3->removeChild(obj, true);
+				break;
 			}
 		}
+		else if (obj->_texturePath == _main2BatchNodeTexture)
+			_main2BatchNode->removeChild(obj, true);
 	}
+}
 
-	dir->getActionManager()->removeAllActions();
-
-	_colorChannels = _originalColors;
-
+void PlayLayer::restoreScene(const PlayLayerSnapshot& snapshot)
+{
+	// what updateVisibility put on screen for the old camera, everything else is already off
+	for (int i = std::max(_prevSection, 0); i < std::min(_nextSection, static_cast<int>(_sectionObjects.size())); i++)
+	{
+		for (GameObject* obj : _sectionObjects[i])
+		{
+			if (obj)
+				hideObject(obj);
+		}
+	}
 	_prevSection = -1;
 	_nextSection = -1;
 
-	if (this->_colorChannels.contains(1000))
-		this->m_pBG->setColor(this->_colorChannels.at(1000)._color);
-	else {
-		this->m_pBG->setColor(ax::Color3B::GRAY);
-		this->_colorChannels[1000]._color = ax::Color3B::GRAY;
+	// in flight colour fades and moves belong to the timeline being thrown away
+	Director::getInstance()->getActionManager()->removeAllActions();
+	for (auto command : _effectManager->_groupActions)
+		command->release();
+	_effectManager->_groupActions.clear();
+	for (auto& [id, node] : _effectManager->_activeMoveActions)
+		node->release();
+	_effectManager->_activeMoveActions.clear();
+
+	_colorChannels = snapshot._colorChannels;
+
+	for (const auto& group : snapshot._groups)
+	{
+		auto& properties = _groups[group._id];
+		properties._alpha = group._alpha;
+		properties._color = group._color;
+		properties.groupState = group._state;
 	}
-	this->_bottomGround->update(0);
-	this->_ceiling->update(0);
+
+	// the enter effect fade an object was left with is redone when updateVisibility shows it
+	for (size_t i = 0; i < _pObjects.size(); i++)
+	{
+		GameObject* obj = _pObjects[i];
+		if (!obj)
+			continue;
+
+		obj->_effectOpacityMultipler = 1.f;
+		if (i >= snapshot._objectOffsets.size() || obj->_startPosOffset == snapshot._objectOffsets[i])
+			continue;
+
+		obj->_startPosOffset = snapshot._objectOffsets[i];
+		updateObjectSection(obj);
+	}
+
+	m_obCamPos = snapshot._cameraPos;
+	_enterEffectID = snapshot._enterEffectID;
+	unschedule("playlayer_restart");
+}
+
+void PlayLayer::restoreSnapshot(const PlayLayerSnapshot& snapshot)
+{
+	restoreScene(snapshot);
+	_world->restoreSnapshot(snapshot._sim);
+
+	// the sprites pick the state up from the world, visibility is redone around the restored camera
+	_player1->syncWithState();
+	_player2->syncWithState();
+	_player1->setVisible(!_player1->isDead());
+	_isDualMode = _world->_isDualMode;
+	_player2->setVisible(_isDualMode && !_player2->isDead());
+	m_fCameraYCenter = _world->_cameraYCenter;
+	scheduleUpdate();
+	updateVisibility();
+}
+
+void PlayLayer::placeCheckpoint()
+{
+	if (_player1->isDead())
+		return;
+
+	saveSnapshot(_checkpoints.emplace_back());
+
+	auto sprite = Sprite::createWithSpriteFrameName("checkpoint_01_001.png");
+	sprite->setPosition(_player1->getPosition());
+	addChild(sprite, 10);
+	_checkpointSprites.push_back(sprite);
+
+	publishEpisodeEvent(kEpisodeEventCheckpoint, 0, static_cast<int>(_checkpoints.size()) - 1);
+}
+
+void PlayLayer::removeCheckpoint()
+{
+	if (_checkpoints.empty())
+		return;
+
+	_checkpoints.pop_back();
+	_checkpointSprites.back()->removeFromParent();
+	_checkpointSprites.pop_back();
+}
+
+void PlayLayer::clearCheckpoints()
+{
+	while (!_checkpoints.empty())
+		removeCheckpoint();
+}
+
+void PlayLayer::startFromCheckpoint(int index)
+{
+	if (index < 0)
+		index += static_cast<int>(_checkpoints.size());
+	if (index < 0 || index >= static_cast<int>(_checkpoints.size()))
+	{
+		GameToolbox::log("no checkpoint {}, {} placed", index, _checkpoints.size());
+		return;
+	}
+
+	finishEpisode();
+	_attempts++;
+
+	const PlayLayerSnapshot& checkpoint = _checkpoints[index];
+	restoreSnapshot(checkpoint);
+	_player1->setRotation(0);
+	_player2->setRotation(0);
+	m_bEndAnimation = false;
 
 	AudioEngine::stopAll();
 	AudioEngine::setCurrentTime(AudioEngine::play2d(LevelTools::getAudioFilename(getLevel()->_musicID), false, 0.1f),
-								_levelSettings.songOffset);
+								_levelSettings.songOffset + static_cast<float>(checkpoint._sim._tick) / SimWorld::kTickRate);
+
+	_episodeStats.reset(*_world);
+	_replayRecorder.begin(*_world, getLevel()->_levelID);
+	_episodeFinished = false;
+	_tickAccumulator = 0.0;
+	if (_controller)
+		_controller->reset();
+	publishEpisodeEvent(kEpisodeEventReset, 0, -1);
+}
 
-	changeGameMode(_player1, _player1, _levelSettings.gamemode);
-	changeGameMode(_player1, _player2, _levelSettings.gamemode);
-	_player1->toggleMini(_levelSettings.mini);
-	_player2->toggleMini(_levelSettings.mini);
-	changePlayerSpeed(_levelSettings.speed);
-	m_obCamPos.y = m_fCameraYCenter;
-	_isDualMode = _levelSettings.dual;
-	if (_isDualMode)
+void PlayLayer::runInputCommand(const InputRecord& command)
+{
+	switch (command._command)
 	{
-		// toggle dual
+	case kInputCommandSaveCheckpoint:
+		placeCheckpoint();
+		break;
+	case kInputCommandStartFromCheckpoint:
+		startFromCheckpoint(static_cast<int>(command._value));
+		break;
+	case kInputCommandStartFromX:
+		startFromX(command._value);
+		break;
+	case kInputCommandClearCheckpoints:
+		clearCheckpoints();
+		break;
+	default:
+		break;
 	}
-	scheduleUpdate();
 }
 
 void PlayLayer::renderRect(ax::Rect rect, ax::Color4B col)
@@ -1805,6 +1960,7 @@ void PlayLayer::onExit()
 
 void PlayLayer::exit()
 {
+	finishEpisode();
 
 	_player1->deactivateStreak();
 	_player2->deactivateStreak();
@@ -1867,61 +2023,71 @@ void PlayLayer::onKeyPressed(EventKeyboard::KeyCode keyCode, Event* event)
 		resetLevel();
 	}
 	break;
+	case EventKeyboard::KeyCode::KEY_Z: {
+		if (_practiceMode)
+			placeCheckpoint();
+	}
+	break;
+	case EventKeyboard::KeyCode::KEY_X: {
+		if (_practiceMode)
+			removeCheckpoint();
+	}
+	break;
 	case EventKeyboard::KeyCode::KEY_F: {
 		extern bool _showDebugImgui;
 		_showDebugImgui = !_showDebugImgui;
 	}
 	break;
 	case EventKeyboard::KeyCode::KEY_SPACE: {
-		if (!_player1->m_bIsHolding)
-			_player1->pushButton();
-		if (_isDualMode && !_player2->m_bIsHolding)
-			_player2->pushButton();
+		if (!_player1->isHolding())
+			_world->pushButton(0);
+		if (_isDualMode && !_player2->isHolding())
+			_world->pushButton(1);
 	}
 	break;
 	case EventKeyboard::KeyCode::KEY_UP_ARROW: {
-		if (!_player1->m_bIsHolding)
-			_player1->pushButton();
-		if (_isDualMode && !_player2->m_bIsHolding)
-			_player2->pushButton();
+		if (!_player1->isHolding())
+			_world->pushButton(0);
+		if (_isDualMode && !_player2->isHolding())
+			_world->pushButton(1);
 	}
 	break;
 		break;
 	case EventKeyboard::KeyCode::KEY_BACK: {
-		_player1->releaseButton();
+		_world->releaseButton(0);
 		if (_isDualMode)
-			_player2->releaseButton();
+			_world->releaseButton(1);
 		this->exit();
 	}
 	default:
 		break;
 	}
-	if (keyCode == EventKeyboard::KeyCode::KEY_A && _player1->m_bIsPlatformer)
-		_player1->direction = -1.f;
-	else if (keyCode == EventKeyboard::KeyCode::KEY_D && _player1->m_bIsPlatformer)
-		_player1->direction = 1.f;
+	if (keyCode == EventKeyboard::KeyCode::KEY_A && _player1->isPlatformer())
+		_player1->setDirection(-1.f);
+	else if (keyCode == EventKeyboard::KeyCode::KEY_D && _player1->isPlatformer())
+		_player1->setDirection(1.f);
 }
 
 void PlayLayer::onKeyReleased(EventKeyboard::KeyCode keyCode, Event* event)
 {
 	GameToolbox::log("Key with keycode {} released", static_cast<int>(keyCode));
-	if ((keyCode == EventKeyboard::KeyCode::KEY_A && _player1->direction == -1.f) ||
-		(keyCode == EventKeyboard::KeyCode::KEY_D && _player1->direction == 1.f) && _player1->m_bIsPlatformer)
-		_player1->direction = 0.f;
+	if ((keyCode == EventKeyboard::KeyCode::KEY_A && _player1->getDirection() == -1.f) ||
+		(keyCode == EventKeyboard::KeyCode::KEY_D && _player1->getDirection() == 1.f) && _player1->isPlatformer())
+		_player1->setDirection(0.f);
 	switch (keyCode)
 	{
 	case EventKeyboard::KeyCode::KEY_SPACE: {
-		if (_player1->m_bIsHolding)
-			_player1->releaseButton();
-		if (_isDualMode && _player2->m_bIsHolding)
-			_player2->releaseButton();
+		if (_player1->isHolding())
+			_world->releaseButton(0);
+		if (_isDualMode && _player2->isHolding())
+			_world->releaseButton(1);
 	}
 	break;
 	case EventKeyboard::KeyCode::KEY_UP_ARROW: {
-		if (_player1->m_bIsHolding)
-			_player1->releaseButton();
-		if (_isDualMode && _player2->m_bIsHolding)
-			_player2->releaseButton();
+		if (_player1->isHolding())
+			_world->releaseButton(0);
+		if (_isDualMode && _player2->isHolding())
+			_world->releaseButton(1);
 	}
 	default:
 		break;
@@ -1940,50 +2106,6 @@ void PlayLayer::tweenCeiling(float y)
 	//_ceiling->setPositionY(y);
 }
 
-void PlayLayer::changePlayerSpeed(int speed)
-{
-	switch (speed)
-	{
-	case 0:
-		_player1->m_dXVel = 5.77;
-		_player1->setPlayerSpeed(0.9);
-		_player2->m_dXVel = 5.77;
-		_player2->setPlayerSpeed(0.9);
-		break;
-	case 1:
-		_player1->m_dXVel = 5.98;
-		_player1->setPlayerSpeed(0.7);
-		_player2->m_dXVel = 5.98;
-		_player2->setPlayerSpeed(0.7);
-		break;
-	case 2:
-		_player1->m_dXVel = 5.87;
-		_player1->setPlayerSpeed(1.1);
-		_player2->m_dXVel = 5.87;
-		_player2->setPlayerSpeed(1.1);
-		break;
-	case 3:
-		_player1->m_dXVel = 6;
-		_player1->setPlayerSpeed(1.3);
-		_player2->m_dXVel = 6;
-		_player2->setPlayerSpeed(1.3);
-		break;
-	case 4:
-		_player1->m_dXVel = 6;
-		_player1->setPlayerSpeed(1.6);
-		_player2->m_dXVel = 6;
-		_player2->setPlayerSpeed(1.6);
-		break;
-	}
-}
-
-void PlayLayer::changeGravity(bool gravityFlipped)
-{
-	_player1->flipGravity(gravityFlipped);
-	if (_isDualMode)
-		_player2->flipGravity(!gravityFlipped);
-}
-
 PlayLayer* PlayLayer::getInstance()
 {
 	return Instance;
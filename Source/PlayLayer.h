@@ -17,19 +17,29 @@
 *************************************************************************/
 
 #pragma once
+#include <memory>
+#include <span>
 #include <string_view>
 #include <vector>
 
 #include "EventKeyboard.h"
 #include "BaseGameLayer.h"
+#include "Simulation/SimEpisodeStats.h"
+#include "Simulation/SimReplay.h"
+#include "Simulation/SimWorld.h"
+#include "Training/EventChannel.h"
+#include "Training/InputChannel.h"
+#include "Training/NeatController.h"
 
 
 enum PlayerGamemode;
 
+class CompiledLevel;
 class GJGameLevel;
 class GameObject;
 class SimpleProgressBar;
 class UILayer;
+struct LevelObjectProperty;
 class PlayerObject;
 class GroundLayer;
 class MenuItemSpriteExtra;
@@ -42,6 +52,27 @@ namespace ax
 }
 
 
+// A PlayLayer attempt at one tick: the simulation plus the scene state triggers change.
+// Colour fades and move triggers still running when it is restored are cancelled, axmol
+// actions can't be rewound.
+struct PlayLayerSnapshot
+{
+	struct Group
+	{
+		int _id;
+		float _alpha;
+		ax::Color3B _color;
+		GroupProperties::GroupState _state;
+	};
+
+	SimSnapshot _sim;
+	std::unordered_map<int, SpriteColor, my_string_hash> _colorChannels;
+	std::vector<Group> _groups;
+	std::vector<ax::Vec2> _objectOffsets; // GameObject::_startPosOffset, indexed like _pObjects
+	ax::Vec2 _cameraPos;
+	int _enterEffectID = 0;
+};
+
 class PlayLayer : public BaseGameLayer
 {
 protected:
@@ -96,7 +127,7 @@ public:
 	UILayer* m_pHudLayer;
 
 	int _secondsSinceStart;
-	int _attempts;
+	int _attempts = 0;
 	int _jumps;
 	bool _everyplay_recorded;
 	bool _testMode;
@@ -105,9 +136,48 @@ public:
 
 	bool _isDualMode;
 
+	// the physics of the current attempt, the players and objects on screen only mirror it
+	std::unique_ptr<SimWorld> _world;
+
+	// real time not yet consumed by fixed ticks, only used with TrainingOptions::_fixedTimestep
+	double _tickAccumulator = 0.0;
+
+	// the current attempt so far, written out by finishEpisode once it ends
+	SimEpisodeStats _episodeStats;
+	SimReplayRecorder _replayRecorder;
+	bool _episodeFinished = false;
+
+	// plays player 1 when TrainingOptions::_genomePath is set
+	std::unique_ptr<NeatController> _controller;
+
+	// practice mode: dying restarts from the newest checkpoint, each one is the whole attempt state
+	// so the part of the level before it is never simulated again. Z places one, X removes the newest
+	bool _practiceMode = false;
+	std::vector<PlayLayerSnapshot> _checkpoints;
+	std::vector<ax::Sprite*> _checkpointSprites;
+
+	// the scene part of the level as loaded, startFromX rewinds to it instead of walking every object.
+	// Its _sim is unused, the world restarts through SimWorld::resetAt
+	PlayLayerSnapshot _startSnapshot;
+
 	virtual void destroyPlayer(PlayerObject* player);
 
+	// no-op unless TrainingOptions::_eventShm opened the EventChannel
+	void publishEpisodeEvent(EpisodeEventType type, int player, int object);
+	// at most once per attempt: the EpisodeSummaryLog record and the ReplayLog file, for the ones that are open
+	void finishEpisode();
+
 	void loadLevel(std::string_view levelStr);
+	// the same from LevelCache::getCompiled, settings, colours and objects come from its arrays
+	void loadCompiledLevel(const CompiledLevel& level);
+	// the channels every level has, then _originalColors as the level starts
+	void setupDefaultColors();
+	// a retained object added to _pObjects, nullptr for an id without a frame
+	GameObject* createLevelObject(int id);
+	void applyObjectProperty(GameObject* obj, const LevelObjectProperty& property, std::span<const GDHSV> hsv,
+							 std::span<const int> groups);
+	// outer bounds and start position once every property is set
+	void finishLevelObject(GameObject* obj);
 
 	void spawnCircle();
 	void showEndLayer();
@@ -117,15 +187,35 @@ public:
 	virtual void updateCamera(float dt);
 	void updateVisibility();
 	void moveCameraToPos(ax::Vec2);
-	void changeGameMode(GameObject* obj, PlayerObject* player, PlayerGamemode gameMode);
+	void changeGameMode(PlayerObject* player, PlayerGamemode gameMode);
 	virtual void resetLevel();
+
+	// rewinding to a snapshot skips walking every object, only what changed is touched
+	void saveSnapshot(PlayLayerSnapshot& snapshot) const;
+	void restoreSnapshot(const PlayLayerSnapshot& snapshot);
+	// everything restoreSnapshot does but the world, the objects on screen come off their batch nodes
+	void restoreScene(const PlayLayerSnapshot& snapshot);
+	// off its batch node until updateVisibility reaches its section again
+	void hideObject(GameObject* obj);
+
+	void placeCheckpoint();
+	void removeCheckpoint();
+	void clearCheckpoints();
+	// new attempts that skip the start of the level, index counts back from the newest when negative
+	void startFromCheckpoint(int index);
+	// x = 0 is the level start, past that colour and move triggers before x only run with no time
+	// to animate, see SimWorld::resetAt
+	void startFromX(float x);
+	void runInputCommand(const InputRecord& command);
 	void exit();
 
 	void tweenBottomGround(float y);
 	void tweenCeiling(float y);
 
-	// dt?
-	void checkCollisions(PlayerObject* player, float delta);
+	// rebuilds _world from _pObjects, call again whenever objects are added or moved
+	void buildSimulation();
+	void processSimulationEvents(float dt);
+	void drawHitboxes();
 	void renderRect(ax::Rect rect, ax::Color4B col);
 
 	void applyEnterEffect(GameObject* obj);
@@ -133,9 +223,6 @@ public:
 
 	int sectionForPos(float x);
 
-	void changePlayerSpeed(int speed);
-	void changeGravity(bool gravityFlipped);
-
 	void incrementTime();
 
 	ax::Color3B getLightBG();
@@ -144,6 +231,4 @@ public:
 	static PlayLayer* create(GJGameLevel* level);
 
 	static PlayLayer* getInstance();
-
-	void writePlayerPositionToFile();
-};
\ No newline at end of file
+};
\ No newline at end of file
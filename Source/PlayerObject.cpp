@@ -28,7 +28,6 @@
 #include "UTF8.h"
 #include "GameToolbox/log.h"
 #include "GameToolbox/math.h"
-#include "platform/FileUtils.h"
 
 USING_NS_AX;
 
@@ -36,17 +35,8 @@ Texture2D* PlayerObject::motionStreakTex = nullptr;
 
 void PlayerObject::reset()
 {
-	m_dYVel = 0.f;
-	setIsDead(false);
-	flipGravity(false);
-	m_snappedObject = nullptr;
-	m_snapDifference = 0;
-	m_isRising = false;
-	m_bIsHolding = false;
-	_touchedRingObject = nullptr;
 	stopActionByTag(0);
 	stopActionByTag(1);
-	_hasRingJumped = false;
 
 	dragEffect1->pauseEmissions();
 	dragEffect2->pauseEmissions();
@@ -238,14 +228,52 @@ Color3B PlayerObject::getMainColor() { return this->m_pMainSprite->getColor(); }
 
 Color3B PlayerObject::getSecondaryColor() { return this->m_pSecondarySprite->getColor(); }
 
-void PlayerObject::setIsDead(bool value) { m_bIsDead = value; }
+void PlayerObject::setPosition(const Vec2& pos)
+{
+	GameObject::setPosition(pos);
+	_state->_position = {pos.x, pos.y};
+}
+
+void PlayerObject::syncWithState()
+{
+	GameObject::setPosition({_state->_position.x, _state->_position.y});
+
+	uint32_t events = _state->_events;
+	_state->_events = 0;
+
+	updateGravityVisuals();
+
+	if (events & kSimPlayerEventLanded)
+	{
+		landEffect1->setPosition(getPosition() + Vec2 {0.f, flipMod() * -15.f});
+		landEffect1->resetSystem();
+		landEffect1->start();
+	}
+
+	if ((events & kSimPlayerEventStopRotation) && getActionByTag(0))
+		stopRotation();
+
+	if (events & kSimPlayerEventRotate)
+		runRotateAction();
+
+	if (events & kSimPlayerEventBallRotate)
+		runBallRotation();
 
-void PlayerObject::setIsOnGround(bool value) { m_bOnGround = value; }
+	if ((events & kSimPlayerEventFallRotate) && getActionByTag(0) == nullptr)
+		runRotateAction();
+
+	if (events & kSimPlayerEventMiniChanged)
+	{
+		auto ac = ScaleTo::create(0.5f, isMini() ? 0.6f : 1.f);
+		auto bounce = EaseBounceOut::create(ac);
+		this->runAction(bounce);
+	}
+}
 
 void PlayerObject::update(float dt)
 {
-	m_prevPos = getPosition();
-	if (this->m_bIsDead) return;
+	syncWithState();
+	if (isDead()) return;
 
 	if (_currentGamemode == PlayerGamemodeCube)
 	{
@@ -286,7 +314,7 @@ void PlayerObject::update(float dt)
 	}
 	else // is ship
 	{
-		if (m_bIsHolding)
+		if (isHolding())
 		{
 			if (!_particles3Activated) dragEffect3->resumeEmissions();
 			_particles3Activated = true;
@@ -306,32 +334,15 @@ void PlayerObject::update(float dt)
 			dragEffect1->pauseEmissions();
 			_particles1Activated = false;
 		}
-		// if (isOnGround() && m_dYVel > -1.f)
+		// if (isOnGround() && getYVel() > -1.f)
 		//	shipDragEffect->resumeEmissions();
 		// else
 		//	shipDragEffect->pauseEmissions();
 	}
 
-	if (!this->m_bIsLocked)
-	{
-		direction = clampf(direction, -1.f, 1.f);
-
-		if (!m_bIsPlatformer) direction = 1.f;
-
-		float dtSlow = dt * 0.9f;
-		this->updateJump(dtSlow);
-
-		float velY = (float)((double)dtSlow * m_dYVel);
-		float velX = (float)((double)dt * m_dXVel * (!m_bIsPlatformer ? 1.f : direction) * getPlayerSpeed());
-
-		ax::Vec2 velocity {velX, velY};
-
-		setPosition(getPosition() + velocity);
-	}
-
-	if (this->getPositionX() >= 500 && !this->inPlayLayer) this->m_bIsHolding = true;
+	if (this->getPositionX() >= 500 && !this->inPlayLayer) _state->_isHolding = true;
 
-	//setScaleX(direction < -0.05f ? -1.f : direction > 0.05f ? 1.f : getScaleX());
+	//setScaleX(getDirection() < -0.05f ? -1.f : getDirection() > 0.05f ? 1.f : getScaleX());
 
 	dragEffect1->setPosition(this->getPosition() + Vec2 {-10.f, flipMod() * -13.f});
 	dragEffect2->setPosition(this->getPosition() + m_pShipSprite->getPosition() + Vec2 {-10.f, flipMod() * -3.f});
@@ -352,34 +363,6 @@ void PlayerObject::update(float dt)
 	// particle->setScale(0.05);
 	// particle->setPosition(this->getPosition());
 	// this->gameLayer->addChild(particle, 999);
-
-	_touchedRingObject = nullptr;
-	_touchedPadObject = nullptr;
-
-	// Write player position to file (every few frames to avoid performance issues)
-	static int frameCounter = 0;
-	if (frameCounter++ % 3 == 0) {  // Only write every 3 frames
-		writePositionToFile();
-	}
-}
-
-void PlayerObject::writePositionToFile()
-{
-	// Get writable path from FileUtils
-	auto fu = ax::FileUtils::getInstance();
-	auto wp = fu->getWritablePath();
-	std::string filePath = wp + "player_position.txt";
-	
-	// Create a simple string with position data
-	std::string posData = fmt::format("{:.2f},{:.2f},{:.2f},{:d},{:d}\n", 
-		getPositionX(), 
-		getPositionY(),
-		m_dYVel,
-		m_bOnGround ? 1 : 0,
-		m_bIsDead ? 1 : 0);
-	
-	// Write to file
-	fu->writeStringToFile(posData, filePath);
 }
 
 void PlayerObject::updateShipRotation(float dt)
@@ -388,13 +371,13 @@ void PlayerObject::updateShipRotation(float dt)
 
 	Vec2 pos = getPosition();
 
-	Vec2 d = (pos - m_prevPos) / dt;
+	Vec2 d = (pos - Vec2 {_state->_prevPosition.x, _state->_prevPosition.y}) / dt;
 
 	if (GameToolbox::SquareDistance(0, 0, d.x, -d.y) >= 1.2f)
 	{
 		angleRad = atan2f(-d.y, d.x);
 
-		angleRad *= _mini ? 1.2f : 1.f;
+		angleRad *= isMini() ? 1.2f : 1.f;
 
 		curAngleDeg = getRotation();
 
@@ -423,147 +406,12 @@ void PlayerObject::activateStreak()
 	// motionStreak->resumeStroke();
 }
 
-void PlayerObject::propellPlayer(double force)
+void PlayerObject::updateGravityVisuals()
 {
-	m_isRising = true;
-	setIsOnGround(false);
-	m_dYVel = flipMod() * 16 * force * (_vehicleSize == 1.0 ? 1.0 : 0.8);
-
-	if (_currentGamemode == PlayerGamemodeBall || _currentGamemode == PlayerGamemodeSpider) m_dYVel *= 0.6;
-
-	runRotateAction();
-	setLastGroundPos(getPosition());
-
-	activateStreak();
-}
-
-void PlayerObject::setTouchedRing(GameObject* obj) { _touchedRingObject = obj; }
-
-void PlayerObject::ringJump(GameObject* obj)
-{
-	if (_touchedRingObject && _queuedHold && m_bIsHolding)
+	if (_gravityFlippedVisual != _state->_gravityFlipped)
 	{
-		GameToolbox::log("h ffsiofsfsdofs");
-		_touchedRingObject->triggerActivated(this);
-		m_isRising = true;
-		_queuedHold = false;
-		setIsOnGround(false);
-
-		double newYVel = m_dJumpHeight;
-
-		switch (obj->getGameObjectType())
-		{
-		case kGameObjectTypeDropRing:
-			switch (_currentGamemode)
-			{
-			case PlayerGamemodeUFO:
-				newYVel = -11.2 * flipMod();
-				break;
-			case PlayerGamemodeShip:
-			case PlayerGamemodeWave:
-				newYVel = -14 * flipMod();
-				break;
-			case PlayerGamemodeSpider:
-				newYVel = -16.5 * flipMod();
-				break;
-			default:
-				newYVel = -15 * flipMod();
-				break;
-			}
-			m_dYVel = newYVel;
-			activateStreak();
-			if (_currentGamemode == PlayerGamemodeBall) m_bIsHolding = false;
-			_touchedRingObject = nullptr;
-			return;
-		case kGameObjectTypeRedJumpRing:
-			switch (_currentGamemode)
-			{
-			case PlayerGamemodeShip:
-				if (_vehicleSize != 1.0f) newYVel *= 1.4;
-				break;
-			case PlayerGamemodeUFO:
-				if (_vehicleSize == 1.0f)
-					newYVel *= 1.02;
-				else
-					newYVel *= 1.36;
-				break;
-			case PlayerGamemodeSpider:
-			case PlayerGamemodeBall:
-				newYVel *= 1.34;
-				break;
-			case PlayerGamemodeRobot:
-				newYVel *= 1.28;
-				break;
-			default:
-				newYVel *= 1.38;
-				break;
-			}
-			break;
-		case kGameObjectTypePinkJumpRing:
-			switch (_currentGamemode)
-			{
-			case PlayerGamemodeShip:
-				newYVel *= 0.37;
-				break;
-			case PlayerGamemodeUFO:
-				newYVel *= 0.42;
-				break;
-			case PlayerGamemodeBall:
-				newYVel *= 0.77;
-				break;
-			default:
-				newYVel *= 0.72;
-				break;
-			}
-			break;
-		case kGameObjectTypeGravityRing:
-			newYVel *= 0.8;
-			break;
-		case kGameObjectTypeGreenRing:
-			if (_currentGamemode == PlayerGamemodeShip) {
-				newYVel *= 0.7;
-			}
-			flipGravity(!isGravityFlipped());
-			break;
-		default:
-			if (_currentGamemode == PlayerGamemodeRobot) newYVel *= 0.9;
-			break;
-		}
-
-		newYVel *= flipMod();
-		newYVel *= _vehicleSize < 1.f ? 0.8f : 1.f;
-
-		m_dYVel = newYVel;
-
-		if (_currentGamemode == PlayerGamemodeBall)
-			runBallRotation();
-		else
-			runRotateAction();
-		_touchedRingObject = nullptr;
-		_hasRingJumped = true;
-		setLastGroundPos(getPosition());
-
-		activateStreak();
-
-		if (_currentGamemode == PlayerGamemodeBall || _currentGamemode == PlayerGamemodeSpider)
-		{
-			m_bIsHolding = false;
-			m_dYVel *= 0.7;
-		}
-
-		if (obj->getGameObjectType() == kGameObjectTypeGravityRing)
-		{
-			flipGravity(!isGravityFlipped());
-		}
-	}
-}
-
-void PlayerObject::flipGravity(bool gravity)
-{
-	if (m_bGravityFlipped != gravity)
-	{
-		m_bGravityFlipped = gravity;
-		m_dYVel /= 2.f;
+		bool gravity = _state->_gravityFlipped;
+		_gravityFlippedVisual = gravity;
 
 		setScaleY(gravity ? getScale() * -1.f : getScale() * 1.f);
 
@@ -583,242 +431,6 @@ void PlayerObject::flipGravity(bool gravity)
 	}
 }
 
-void PlayerObject::updateJump(float dt)
-{
-	float localGravity = m_dGravity;
-
-	const int flipGravityMult = flipMod();
-
-	float playerSize = _mini ? 0.8f : 1.0f;
-
-	if (_currentGamemode == PlayerGamemodeShip || _currentGamemode == PlayerGamemodeUFO ||
-		_currentGamemode == PlayerGamemodeWave)
-	{
-		if (_mini) playerSize = 0.85f;
-
-		float upperVelocityLimit = 8.0 / playerSize;
-		float lowerVelocityLimit = -6.4 / playerSize;
-
-		if (this->_currentGamemode == PlayerGamemodeShip)
-		{
-			float shipAccel = 0.8f;
-
-			if (this->m_bIsHolding) shipAccel = -1.0f;
-
-			if (!this->m_bIsHolding && !this->playerIsFalling())
-			{
-				shipAccel = 1.2f;
-			}
-
-			float extraBoost = 0.4f;
-			if (this->m_bIsHolding && this->playerIsFalling()) extraBoost = 0.5;
-
-			this->m_dYVel -= localGravity * dt * flipGravityMult * shipAccel * extraBoost / playerSize;
-		}
-		else if (_currentGamemode == PlayerGamemodeUFO)
-		{
-			if (m_bIsHolding && _hasJustHeld)
-			{
-				_hasJustHeld = false;
-
-				const float sizeMult = _mini ? 8.f : 7.f;
-				double newVel = flipMod() * sizeMult * playerSize;
-
-				if (!isGravityFlipped() && m_dYVel < newVel || newVel < m_dYVel)
-				{
-					m_dYVel = newVel;
-				}
-			}
-			float gravityMult = 0.8f;
-
-			if (!playerIsFalling()) gravityMult = 1.2f;
-
-			m_dYVel -= localGravity * dt * flipMod() * gravityMult * 0.5 / playerSize;
-		}
-
-		if (!this->isGravityFlipped())
-		{
-			if (this->m_dYVel <= lowerVelocityLimit) this->m_dYVel = lowerVelocityLimit;
-		}
-		else
-		{
-			if (this->m_dYVel <= -upperVelocityLimit) this->m_dYVel = -upperVelocityLimit;
-
-			upperVelocityLimit = 6.4f / playerSize;
-		}
-		if (this->m_dYVel >= upperVelocityLimit) this->m_dYVel = upperVelocityLimit;
-	}
-	else
-	{
-		float gravityMultiplier = 1.0f;
-
-		if (_currentGamemode == PlayerGamemodeBall) gravityMultiplier = 0.6f;
-
-		bool shouldJump = m_bIsHolding;
-
-		if (shouldJump && isOnGround())
-		{
-			m_isRising = true;
-			setIsOnGround(false);
-
-			float jumpAccel = m_dJumpHeight;
-
-			m_dYVel = flipGravityMult * jumpAccel * playerSize;
-
-			if (_currentGamemode == PlayerGamemodeBall)
-			{
-				this->flipGravity(!this->isGravityFlipped());
-				this->m_bIsHolding = false;
-				this->m_dYVel *= 0.6;
-			}
-			else if (_currentGamemode == PlayerGamemodeCube)
-			{
-				if (!_touchedRingObject) _queuedHold = false;
-				runRotateAction();
-			}
-		}
-		else
-		{
-			if (m_isRising)
-			{
-				m_dYVel -= localGravity * dt * flipGravityMult * gravityMultiplier;
-				if (playerIsFalling())
-				{
-					m_isRising = false;
-					setIsOnGround(false);
-				}
-			}
-			else
-			{
-				if (!isGravityFlipped())
-				{
-					if (m_dYVel < -m_dGravity * 2.f) m_bOnGround = false;
-				}
-				else
-				{
-					if (m_dYVel > m_dGravity * 2.f) m_bOnGround = false;
-				}
-
-				m_dYVel -= localGravity * dt * flipGravityMult * gravityMultiplier;
-				m_dYVel = isGravityFlipped() ? std::min(m_dYVel, 15.0) : std::max(m_dYVel, -15.0);
-				if (!isGravityFlipped())
-				{
-					if (m_dYVel >= m_dGravity * 2.0f) return;
-				}
-				else
-				{
-					if (m_dYVel <= m_dGravity * 2.0f) return;
-				}
-
-				if (_currentGamemode != PlayerGamemodeBall && getActionByTag(0) == nullptr) runRotateAction();
-
-				if (isGravityFlipped())
-				{
-					if (m_dYVel >= -4.0) return;
-				}
-				else
-				{
-					if (m_dYVel <= 4.0) return;
-				}
-			}
-		}
-	}
-}
-
-bool PlayerObject::playerIsFalling()
-{
-	if (this->isGravityFlipped())
-		return this->m_dYVel > this->m_dGravity;
-	else
-		return this->m_dYVel < this->m_dGravity;
-}
-
-void PlayerObject::collidedWithObject(float dt, GameObject* obj)
-{
-	Vec2 pos = getPosition();
-	Rect rect = obj->getOuterBounds();
-
-	Rect playerRectO = _mini ? getOuterBounds(0.6f, 0.6f) : getOuterBounds();
-	Rect playerRectI = getInnerBounds();
-
-	float flipModV = flipMod();
-
-	float mod = flipModV * 10.0f;
-
-	if (_currentGamemode == PlayerGamemodeShip) mod = flipModV * 6.0f;
-
-	float topP = (pos.y + (playerRectO.origin.height * -0.5f * -flipMod())) - mod;
-	float bottomP = (pos.y + (playerRectO.origin.height * -0.5f * flipMod())) + mod;
-
-	float MaxY = rect.getMaxY();
-	float MinY = rect.getMinY();
-
-	// h
-	float MaxYP = playerRectO.getMaxY();
-	float MinYP = playerRectO.getMinY();
-
-	float t = topP;
-	float b = bottomP;
-
-	if (isGravityFlipped())
-	{
-		if (_currentGamemode != PlayerGamemodeShip && _currentGamemode != PlayerGamemodeUFO) goto topCollision;
-		t = bottomP;
-		b = topP;
-	}
-	if (b >= MaxY || t >= MaxY)
-	{
-		if (m_dYVel < 0.0f)
-		{
-			// checkSnapJumpToObject(obj);
-			//  idk snapping to Y
-			playerRectI.origin.x = rect.origin.x;
-			if (playerRectI.intersectsRect(rect))
-			{
-				playerRectI.origin.x = pos.x;
-				goto death;
-			}
-			if (MaxYP >= (MinY + MaxY) / 2.f)
-			{
-				setPositionY(MaxY - (_mini ? 6 : 0));
-				hitGround(isGravityFlipped() ? _currentGamemode == PlayerGamemodeShip : false);
-			}
-		}
-	}
-
-	if (!isGravityFlipped())
-	{
-		if (_currentGamemode != PlayerGamemodeShip && _currentGamemode != PlayerGamemodeUFO) goto death;
-		t = bottomP;
-		b = topP;
-	}
-topCollision:
-	if (b <= MinY || t <= MinY)
-	{
-		if (m_dYVel > 0.0f)
-		{
-			// checkSnapJumpToObject(obj);
-			//  idk snapping to Y
-			playerRectI.origin.x = rect.origin.x;
-			if (playerRectI.intersectsRect(rect))
-			{
-				playerRectI.origin.x = pos.x;
-				goto death;
-			}
-
-			if (MinYP <= (MinY + MaxY) / 2.f)
-			{
-				setPositionY(MinY - (_mini ? 24 : 30));
-				hitGround(!isGravityFlipped() ? _currentGamemode == PlayerGamemodeShip : false);
-			}
-		}
-	}
-death:
-	if (playerRectI.intersectsRect(rect) && !obj->_isTrigger) {
-		static_cast<PlayLayer*>(getPlayLayer())->destroyPlayer(this);
-	}
-}
-
 void PlayerObject::setGamemode(PlayerGamemode mode)
 {
 	if (_currentGamemode != mode)
@@ -837,7 +449,6 @@ void PlayerObject::setGamemode(PlayerGamemode mode)
 		switch (mode)
 		{
 		case PlayerGamemodeCube:
-			setIsOnGround(false);
 			m_pMainSprite->setVisible(true);
 			m_pMainSprite->setScale(1.f);
 			m_pMainSprite->setPositionY(0);
@@ -849,8 +460,6 @@ void PlayerObject::setGamemode(PlayerGamemode mode)
 			m_pMainSprite->setScale(0.55f);
 			m_pMainSprite->setPositionY(5);
 			setRotation(0.f);
-			m_dYVel /= 2.f;
-			setIsOnGround(false);
 			activateStreak();
 			runRotateAction();
 			break;
@@ -874,140 +483,16 @@ void PlayerObject::setGamemode(PlayerGamemode mode)
 	}
 }
 
-void PlayerObject::checkSnapJumpToObject(GameObject* obj)
-{
-	if (obj)
-	{
-		if (m_snappedObject && m_snappedObject->_uniqueID != obj->_uniqueID &&
-			m_snappedObject->getGameObjectType() == GameObjectType::kGameObjectTypeSolid)
-		{
-
-			auto oldSnapPos = m_snappedObject->getPosition();
-			auto newSnapPos = obj->getPosition();
-
-			float unknownUse = 1.0;
-			float upTwoGap = 90.0;
-			float downOneGap = 150.0;
-			float upOneGap = 90.0;
-			float xShift = 1.0;
-
-			if (m_playerSpeed == 0.9f)
-			{
-				/* //if (m_vehicleSize == 1.0) {
-					upOneGap = 120.0;
-				//} */
-			}
-			else if (m_playerSpeed == 0.7f)
-			{
-				upTwoGap = 60.0;
-				downOneGap = 120.0;
-			}
-			else if (m_playerSpeed == 1.1f)
-			{
-				unknownUse = 0.0;
-				xShift = 2.00;
-				upTwoGap = 120.0;
-				downOneGap = 195.0;
-				/* //if (m_vehicleSize == 1.0) {
-					upOneGap = 150.0;
-				//} */
-			}
-			else if (m_playerSpeed == 1.3f)
-			{
-				unknownUse = 0.0;
-				xShift = 2.00;
-				upTwoGap = 135.0;
-				downOneGap = 225.0;
-				/* //if (m_vehicleSize == 1.0) {
-					upOneGap = 180.0;
-				//} */
-			}
-			else
-			{
-				upOneGap = 120.0;
-			}
-
-			upOneGap += oldSnapPos.x;
-			downOneGap += oldSnapPos.x;
-
-			float someMultiplier = (isGravityFlipped() ? 30.0 : -30.0);
-
-			if (unknownUse >= upOneGap) oldSnapPos.y = fabs(newSnapPos.x - upOneGap) + someMultiplier;
-
-			float value1 = fabs(newSnapPos.y - (oldSnapPos.y + someMultiplier));
-			float value2 = fabs(newSnapPos.y - (oldSnapPos.y + someMultiplier * 2));
-			float value3 = fabs(newSnapPos.x - downOneGap);
-			float value4 = fabs(newSnapPos.x - (upTwoGap + oldSnapPos.x));
-			float value5 = fabs(newSnapPos.y - oldSnapPos.y);
-
-			if ((unknownUse >= upOneGap && unknownUse >= value5) || (unknownUse >= value3 && unknownUse >= value1) ||
-				(unknownUse >= value4 && unknownUse >= value2))
-			{
-				float newPos = obj->getPositionX() + this->m_snapDifference;
-				float oldPos = this->getPositionX();
-
-				if (xShift < fabs(newPos - oldPos))
-				{
-					if (newPos > oldPos)
-					{
-						newPos += oldPos;
-					}
-					else
-					{
-						newPos = oldPos - xShift;
-					}
-				}
-				this->setPositionX(newPos);
-			}
-		}
-
-		m_snappedObject = obj;
-		m_snapDifference = this->getPositionX() - obj->getPositionX();
-	}
-}
-
-void PlayerObject::hitGround(bool reverseGravity)
-{
-	m_dYVel = 0.0f;
-
-	if (!isOnGround() && !reverseGravity)
-	{
-		landEffect1->setPosition(getPosition() + Vec2 {0.f, flipMod() * -15.f});
-		landEffect1->resetSystem();
-		landEffect1->start();
-	}
-
-	if (_currentGamemode == PlayerGamemodeBall && !isOnGround()) runBallRotation();
-
-	_queuedHold = false;
-	setIsOnGround(true);
-
-	if (getActionByTag(0)) stopRotation();
-
-	m_obLastGroundPos = getPosition();
-
-	if (_currentGamemode != PlayerGamemode::PlayerGamemodeShip) deactivateStreak();
-}
-
-float PlayerObject::flipMod() { return this->m_bGravityFlipped ? -1.0f : 1.0f; }
-
-bool PlayerObject::isGravityFlipped() { return this->m_bGravityFlipped; }
-
-bool PlayerObject::isDead() { return this->m_bIsDead; }
-
-bool PlayerObject::isOnGround() { return this->m_bOnGround; }
-
-ax::Vec2 PlayerObject::getLastGroundPos() { return this->m_obLastGroundPos; }
-
 void PlayerObject::logValues()
 {
-	GameToolbox::log("xVel: {} | yVel: {} | gravity: {} | jumpHeight: {} ", m_dXVel, m_dYVel, m_dGravity, m_dJumpHeight);
+	GameToolbox::log("xVel: {} | yVel: {} | gravity: {} | jumpHeight: {} ", _state->_xVel, _state->_yVel, _state->_gravity,
+					 _state->_jumpHeight);
 }
 
 void PlayerObject::runRotateAction()
 {
 	stopRotation();
-	auto action = RotateBy::create(0.41f * (_mini ? 0.8f : 1.f), 180.f * flipMod());
+	auto action = RotateBy::create(0.41f * (isMini() ? 0.8f : 1.f), 180.f * flipMod());
 	action->setTag(0);
 	runAction(action);
 }
@@ -1037,39 +522,14 @@ void PlayerObject::stopRotation()
 	}
 }
 
-void PlayerObject::jump()
-{
-	this->m_dYVel = this->m_dJumpHeight;
-}
-
-void PlayerObject::toggleMini(bool active)
-{
-	_mini = active;
-	_vehicleSize = active ? 0.6f : 1.f;
-	auto ac = ScaleTo::create(0.5f, active ? 0.6f : 1.f);
-	auto bounce = EaseBounceOut::create(ac);
-	this->runAction(bounce);
-}
-
 void PlayerObject::pushButton()
 {
-	if (this->inPlayLayer)
-	{
-		m_bIsHolding = true;
-		_hasJustHeld = true;
-		_queuedHold = true;
-	}
-	if((_currentGamemode == PlayerGamemode::PlayerGamemodeCube || _currentGamemode == PlayerGamemode::PlayerGamemodeRobot) && m_bOnGround) _jumpedTimes++;
+	if (this->inPlayLayer) _state->pushButton();
 }
 
 void PlayerObject::releaseButton()
 {
-	if (this->inPlayLayer)
-	{
-		_queuedHold = false;
-		_hasJustHeld = false;
-		m_bIsHolding = false;
-	}
+	if (this->inPlayLayer) _state->releaseButton();
 }
 
 PlayerObject* PlayerObject::create(int playerFrame, Layer* gameLayer)
@@ -1083,4 +543,4 @@ PlayerObject* PlayerObject::create(int playerFrame, Layer* gameLayer)
 	}
 	AX_SAFE_DELETE(pRet);
 	return pRet;
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -20,6 +20,7 @@
 #include "GameObject.h"
 #include "Types.h"
 #include "math/Vec2.h"
+#include "Simulation/SimPlayer.h"
 
 class GameObject;
 class MotionTrail;
@@ -32,25 +33,15 @@ namespace ax
 	class Texture2D;
 }
 
-
-enum PlayerGamemode
-{
-	PlayerGamemodeCube = 0,
-	PlayerGamemodeShip = 1,
-	PlayerGamemodeBall = 2,
-	PlayerGamemodeUFO = 3,
-	PlayerGamemodeWave = 4,
-	PlayerGamemodeRobot = 5,
-	PlayerGamemodeSpider = 6,
-};
-
+// The sprite side of a player. Physics live in SimPlayer, this only mirrors the state it is bound to
+// (its own copy outside of PlayLayer, the one owned by PlayLayer's SimWorld inside it).
 class PlayerObject : public GameObject
 {
   private:
-	void updateJump(float dt);
 	bool init(int, ax::Layer*);
 	void runRotateAction();
 	void runBallRotation();
+	void updateGravityVisuals();
 
 	void logValues();
 
@@ -74,99 +65,65 @@ class PlayerObject : public GameObject
 	ax::ParticleSystemQuad* landEffect1;
 	ax::ParticleSystemQuad* landEffect2;
 
-	
-	double m_dYVel = 0;
-	double m_dGravity = 0.958199;
-	double m_dJumpHeight = 11.180032;
-
-	bool m_bOnGround;
-
-	bool m_bIsDead;
-	bool m_bIsLocked;
-
-	bool m_bGravityFlipped;
-
-	bool m_isRising;
-
 	bool _particles1Activated;
 	bool _particles2Activated;
 	bool _particles3Activated;
 
-	float m_playerSpeed = 0.9f;
-	float m_snapDifference;
-
-	ax::Vec2 m_obLastGroundPos;
-	ax::Vec2 m_prevPos;
+	// what the sprite currently shows, the state may be ahead of it until the next update
+	bool _gravityFlippedVisual = false;
 
-	GameObject* m_snappedObject;
-
-	void writePositionToFile();
+	SimPlayer _localState;
+	SimPlayer* _state = &_localState;
 
   public:
-
-  double m_dXVel = 5.770002;
-
-	GameObject* _touchedPadObject;
-
-	bool _mini = false;
-	bool m_bIsHolding;
-	bool _hasJustHeld;
-
-	int _jumpedTimes;
-
 	static ax::Texture2D* motionStreakTex;
 	MotionTrail* motionStreak;
 
+	// gamemode the sprites are set up for, see setGamemode
 	PlayerGamemode _currentGamemode;
 
-	GameObject* _touchedRingObject;
-	
-	bool _hasRingJumped;
-	bool _queuedHold;
-
 	void reset();
 
-	bool m_bIsPlatformer;
-	float direction, _vehicleSize = 1.f;
-
 	static PlayerObject* create(int, ax::Layer*);
 
+	// point the sprite at another physics state, nullptr goes back to the local one
+	void bindState(SimPlayer* state) { _state = state ? state : &_localState; }
+	SimPlayer* getState() { return _state; }
+
 	void setMainColor(ax::Color3B col);
 	void setSecondaryColor(ax::Color3B col);
 
 	ax::Color3B getMainColor();
 	ax::Color3B getSecondaryColor();
 
-	void jump();
-	void collidedWithObject(float dt, GameObject* obj);
-	void checkSnapJumpToObject(GameObject* obj);
+	void setPosition(const ax::Vec2& pos) override;
 
 	void updateShipRotation(float dt);
-	bool isDead();
-	bool isOnGround();
-	bool isGravityFlipped();
+	bool isDead() { return _state->_isDead; }
+	bool isOnGround() { return _state->_onGround; }
+	bool isGravityFlipped() { return _state->_gravityFlipped; }
+	bool isMini() { return _state->_mini; }
+	bool isHolding() { return _state->_isHolding; }
 	bool isRestricted()
 	{
 		return _currentGamemode == PlayerGamemodeShip || _currentGamemode == PlayerGamemodeSpider ||
 			   _currentGamemode == PlayerGamemodeBall;
 	}
 	void stopRotation();
-	void toggleMini(bool active);
-	float flipMod();
+	float flipMod() { return _state->flipMod(); }
 
-	bool playerIsFalling();
+	double getYVel() { return _state->_yVel; }
+	int getJumpedTimes() { return _state->_jumpedTimes; }
 
-	double getYVel()
-	{
-		return m_dYVel;
-	}
-	void setYVel(double yVel)
-	{
-		m_dYVel = yVel;
-	}
+	void setIsDead(bool value) { _state->_isDead = value; }
+	void setNoclip(bool value) { _state->_noclip = value; }
+
+	bool isPlatformer() { return _state->_isPlatformer; }
+	void setPlatformer(bool value) { _state->_isPlatformer = value; }
+	float getDirection() { return _state->_direction; }
+	void setDirection(float value) { _state->_direction = value; }
 
-	void setIsDead(bool);
-	void setIsOnGround(bool);
+	// sprite only, the physics side is SimPlayer::setGamemode
 	void setGamemode(PlayerGamemode mode);
 
 	ax::Layer* getPlayLayer()
@@ -176,32 +133,13 @@ class PlayerObject : public GameObject
 
 	void playDeathEffect();
 
-	void hitGround(bool reverseGravity);
-
-	void flipGravity(bool gravity);
-
-	bool noclip;
+	ax::Vec2 getLastGroundPos() { return {_state->_lastGroundPos.x, _state->_lastGroundPos.y}; }
 
-	ax::Vec2 getLastGroundPos();
-	void setLastGroundPos(ax::Vec2 pos)
-	{
-		m_obLastGroundPos = pos;
-	}
+	// catches the sprite up with the state: position, landing particles, rotations, gravity and size changes
+	void syncWithState();
 	void update(float dt);
 
-	float getPlayerSpeed()
-	{
-		return m_playerSpeed;
-	}
-	void setPlayerSpeed(float v)
-	{
-		m_playerSpeed = v;
-	}
-
-	void propellPlayer(double force);
-
-	void setTouchedRing(GameObject* obj);
-	void ringJump(GameObject* obj);
+	float getPlayerSpeed() { return _state->_playerSpeed; }
 
 	void activateStreak();
 	void deactivateStreak();
@@ -31,7 +31,7 @@
 #include <2d/ActionEase.h>
 #include "2d/ActionInstant.h"
 #include "AudioEngine.h"
-#include "external/base64.h"
+#include "GameToolbox/base64.h"
 #include "network/HttpResponse.h"
 #include "network/HttpClient.h"
 #include "CurrencyRewardLayer.h"
@@ -317,7 +317,12 @@ void RewardUnlockLayer::onHttpRequestCompleted(ax::network::HttpClient* sender,
 
 		GetGJRewards* rewards = GetGJRewards::create();
 
-		auto decodedResponse = GameToolbox::xorCipher(base64_decode(fmt::format("{}", strResp.substr(5))), "59182");
+		// five random characters, the data, then '|' and a hash
+		std::string decoded;
+		if (!GameToolbox::base64Decode(strResp.substr(5, strResp.find('|', 5) - 5), decoded))
+			GameToolbox::log("rewards response isn't valid base64: {}", strResp);
+
+		auto decodedResponse = GameToolbox::xorCipher(decoded, "59182");
 		auto data = GameToolbox::splitByDelim(decodedResponse, ':');
 		
 		GameToolbox::log("{}", (chestID == 1) ? data[6] : data[9]);
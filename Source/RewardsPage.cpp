@@ -32,7 +32,7 @@
 #include "fmt/format.h"
 #include "network/HttpResponse.h"
 #include "network/HttpClient.h"
-#include "external/base64.h"
+#include "GameToolbox/base64.h"
 #include "GameToolbox/getTextureString.h"
 #include "GameToolbox/conv.h"
 #include "GameToolbox/network.h"
@@ -222,7 +222,12 @@ void RewardsPage::onHttpRequestCompleted(ax::network::HttpClient* sender, ax::ne
 	{
 		std::string_view strResp {*str};
 
-		auto decodedResponse = GameToolbox::xorCipher(base64_decode(fmt::format("{}", strResp.substr(5))), "59182");
+		// five random characters, the data, then '|' and a hash
+		std::string decoded;
+		if (!GameToolbox::base64Decode(strResp.substr(5, strResp.find('|', 5) - 5), decoded))
+			GameToolbox::log("rewards response isn't valid base64: {}", strResp);
+
+		auto decodedResponse = GameToolbox::xorCipher(decoded, "59182");
 		auto data = GameToolbox::splitByDelim(decodedResponse, ':');
 		
 		if (GameToolbox::stoi(data[5]) > 1)
@@ -0,0 +1,91 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "SimTypes.h"
+
+enum GameObjectType
+{
+	kGameObjectTypeSolid = 0,
+	kGameObjectTypeHazard = 2,
+	kGameObjectTypeInverseGravityPortal = 3,
+	kGameObjectTypeNormalGravityPortal = 4,
+	kGameObjectTypeShipPortal = 5,
+	kGameObjectTypeCubePortal = 6,
+	kGameObjectTypeDecoration = 7,
+	kGameObjectTypeYellowJumpPad = 8,
+	kGameObjectTypePinkJumpPad = 9,
+	kGameObjectTypeGravityPad = 10,
+	kGameObjectTypeYellowJumpRing = 11,
+	kGameObjectTypePinkJumpRing = 12,
+	kGameObjectTypeGravityRing = 13,
+	kGameObjectTypeInverseMirrorPortal = 14,
+	kGameObjectTypeNormalMirrorPortal = 15,
+	kGameObjectTypeBallPortal = 16,
+	kGameObjectTypeRegularSizePortal = 17,
+	kGameObjectTypeMiniSizePortal = 18,
+	kGameObjectTypeUfoPortal = 19,
+	kGameObjectTypeModifier = 20,
+	kGameObjectTypeSecretCoin = 22,
+	kGameObjectTypeDualPortal = 23,
+	kGameObjectTypeSoloPortal = 24,
+	kGameObjectTypeSlope = 25,
+	kGameObjectTypeWavePortal = 26,
+	kGameObjectTypeRobotPortal = 27,
+	kGameObjectTypeTeleportPortal = 28,
+	kGameObjectTypeGreenRing = 29,
+	kGameObjectTypeCollectible = 30,
+	kGameObjectTypeUserCoin = 31,
+	kGameObjectTypeDropRing = 32,
+	kGameObjectTypeSpiderPortal = 33,
+	kGameObjectTypeRedJumpPad = 34,
+	kGameObjectTypeRedJumpRing = 35,
+	kGameObjectTypeCustomRing = 36,
+	kGameObjectTypeDashRing = 37,
+	kGameObjectTypeGravityDashRing = 38,
+	kGameObjectTypeCollisionObject = 39,
+	kGameObjectTypeSpecial = 40
+};
+
+struct Hitbox
+{
+	float h, w, x, y;
+};
+
+// Static per-object-id data the simulation needs. Nothing in here depends on axmol,
+// GameObject reads the same tables through its _pHitboxes/_pHitboxRadius/_pTriggers members.
+namespace ObjectData
+{
+extern const std::unordered_map<int, Hitbox> hitboxes;
+extern const std::unordered_map<int, float> hitboxRadius;
+extern const std::vector<int> triggers;
+
+bool isTrigger(int objectID);
+
+// same transform GameObject uses: rotate (degrees, clockwise like axmol nodes), then scale, then offset
+// by the object position and the 15 unit half block
+SimRect computeOuterBounds(const Hitbox& hb, SimVec2 position, float rotation, float scaleX, float scaleY);
+
+// object id -> "object_type" from Custom/object.json, ids missing from the file are solids like in GameObject
+std::unordered_map<int, GameObjectType> parseObjectTypes(std::string_view objectJson);
+} // namespace ObjectData
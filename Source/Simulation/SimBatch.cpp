@@ -0,0 +1,119 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "SimBatch.h"
+
+#include <algorithm>
+
+SimBatch::SimBatch(std::shared_ptr<const SimLevel> level, int count, unsigned threads) : _pool(threads)
+{
+	_worlds.reserve(count);
+	for (int i = 0; i < count; i++)
+		_worlds.emplace_back(level);
+
+	_held.resize(count);
+
+	if (count > 0)
+		_worlds[0].saveSnapshot(_start);
+}
+
+bool SimBatch::isDone(int index) const
+{
+	const SimWorld& world = _worlds[index];
+
+	if (world._player1._isDead || (world._isDualMode && world._player2._isDead))
+		return true;
+
+	return world.getPercentage() >= 100.f;
+}
+
+void SimBatch::reset(int index)
+{
+	// the start snapshot is world 0's, every world keeps its own seed
+	SimWorld& world = _worlds[index];
+	uint64_t seed = world._seed;
+	world.restoreSnapshot(_start);
+	world._seed = seed;
+	world._rng.seed(seed);
+	_held[index] = 0;
+}
+
+void SimBatch::setSeed(uint64_t seed)
+{
+	for (size_t i = 0; i < _worlds.size(); i++)
+		_worlds[i]._seed = GameToolbox::Rng::derive(seed, i);
+}
+
+void SimBatch::resetAll()
+{
+	_pool.parallelFor(_worlds.size(), [this](size_t i) { reset((int)i); });
+}
+
+void SimBatch::setButton(int index, bool held)
+{
+	if (_held[index] == held)
+		return;
+
+	SimWorld& world = _worlds[index];
+	for (int player = 0; player < (world._isDualMode ? 2 : 1); player++)
+	{
+		if (held)
+			world.pushButton(player);
+		else
+			world.releaseButton(player);
+	}
+
+	_held[index] = held;
+}
+
+void SimBatch::step(const uint8_t* buttons, int ticks)
+{
+	_pool.parallelFor(_worlds.size(), [&](size_t i) {
+		int index = (int)i;
+		if (isDone(index))
+			return;
+
+		if (buttons)
+			setButton(index, buttons[index] != 0);
+
+		for (int t = 0; t < ticks && !isDone(index); t++)
+			_worlds[index].step(SimWorld::kTickStep);
+	});
+}
+
+void SimBatch::forEach(const std::function<void(int)>& fn)
+{
+	_pool.parallelFor(_worlds.size(), [&](size_t i) { fn((int)i); });
+}
+
+void SimBatch::step(const std::function<bool(int, const SimWorld&)>& policy, int ticks, int actionRepeat)
+{
+	actionRepeat = std::max(actionRepeat, 1);
+
+	_pool.parallelFor(_worlds.size(), [&](size_t i) {
+		int index = (int)i;
+		SimWorld& world = _worlds[index];
+
+		for (int t = 0; t < ticks && !isDone(index); t++)
+		{
+			if (world._tick % actionRepeat == 0)
+				setButton(index, policy(index, world));
+			world.step(SimWorld::kTickStep);
+		}
+	});
+}
@@ -0,0 +1,73 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "SimWorld.h"
+#include "ThreadPool.h"
+
+// Many independent attempts at one level stepped together in fixed ticks. Every world shares
+// the same read-only SimLevel, so an extra instance only costs its player state and one byte
+// per object, and the worlds are spread over a thread pool on each step.
+class SimBatch
+{
+  public:
+	// threads as in ThreadPool, 0 means one per hardware thread
+	SimBatch(std::shared_ptr<const SimLevel> level, int count, unsigned threads = 0);
+
+	int size() const { return (int)_worlds.size(); }
+	SimWorld& getWorld(int index) { return _worlds[index]; }
+	const SimWorld& getWorld(int index) const { return _worlds[index]; }
+
+	// the attempt ended, either every active player died or the level was completed
+	bool isDone(int index) const;
+
+	void reset(int index);
+	void resetAll();
+
+	// world i gets its own seed derived from this one, takes effect on the next reset
+	void setSeed(uint64_t seed);
+
+	// buttons[i] holds (non zero) or releases the button of world i, both players in dual mode.
+	// null keeps whatever each world held before. Then every world that isn't done advances by
+	// up to ticks SimWorld::kTickStep steps, stopping early once it is done
+	void step(const uint8_t* buttons, int ticks = 1);
+
+	// the same with the button chosen by policy(index, world), called on the worker thread stepping
+	// that world. A policy may touch per index state but nothing shared. With actionRepeat it is
+	// only asked on ticks that are a multiple of it and its answer is held in between, so the
+	// world's tick and not the call decides when, whatever ticks is
+	void step(const std::function<bool(int, const SimWorld&)>& policy, int ticks = 1, int actionRepeat = 1);
+
+	// fn(index) for every world on the batch's threads, for per world work around a step like
+	// resets or reading observations. The same rules as a policy apply
+	void forEach(const std::function<void(int)>& fn);
+
+  private:
+	std::vector<SimWorld> _worlds;
+	std::vector<uint8_t> _held;
+	SimSnapshot _start; // every world right after reset, restoring it is cheaper than SimWorld::reset
+	ThreadPool _pool;
+
+	void setButton(int index, bool held);
+};
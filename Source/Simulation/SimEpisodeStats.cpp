@@ -0,0 +1,79 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "SimEpisodeStats.h"
+
+#include <algorithm>
+
+#include "SimWorld.h"
+
+void SimEpisodeStats::reset(const SimWorld& world)
+{
+	*this = SimEpisodeStats();
+	_startTick = world._tick;
+	_jumpedTimesAtStart = world._player1._jumpedTimes + world._player2._jumpedTimes;
+	_maxX = world._player1._position.x;
+}
+
+void SimEpisodeStats::update(const SimWorld& world)
+{
+	const SimPlayer& player = world._player1;
+
+	_ticks = world._tick - _startTick;
+	_maxX = std::max(_maxX, player._position.x);
+	_percentage = std::max(_percentage, std::min(world.getPercentage(), 100.f));
+	_jumps = player._jumpedTimes + world._player2._jumpedTimes - _jumpedTimesAtStart;
+	_completed = _completed || _percentage >= 100.f;
+
+	for (const SimEvent& event : world._events)
+	{
+		// in dual mode the attempt ends when either player dies
+		if (event._type == kSimEventPlayerDied && !_dead)
+		{
+			_dead = true;
+			_deathObject = event._object;
+			continue;
+		}
+
+		if (event._type != kSimEventObjectActivated)
+			continue;
+
+		switch (world._level->_objects[event._object]._type)
+		{
+		case kGameObjectTypeYellowJumpPad:
+		case kGameObjectTypePinkJumpPad:
+		case kGameObjectTypeRedJumpPad:
+		case kGameObjectTypeGravityPad:
+			_padActivations++;
+			break;
+		case kGameObjectTypeYellowJumpRing:
+		case kGameObjectTypePinkJumpRing:
+		case kGameObjectTypeRedJumpRing:
+		case kGameObjectTypeGravityRing:
+		case kGameObjectTypeGreenRing:
+		case kGameObjectTypeDropRing:
+		case kGameObjectTypeDashRing:
+		case kGameObjectTypeGravityDashRing:
+		case kGameObjectTypeCustomRing:
+			_orbActivations++;
+			break;
+		default:
+			break;
+		}
+	}
+}
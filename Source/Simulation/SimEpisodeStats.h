@@ -0,0 +1,49 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+class SimWorld;
+
+// Running totals for one attempt, fed from the world after every step. Progress follows player 1,
+// jumps, activations and deaths count both players in dual mode. The same tracker works on a
+// PlayLayer world and on the worlds of a SimBatch.
+struct SimEpisodeStats
+{
+	uint64_t _ticks = 0; // since reset, an attempt started from a checkpoint doesn't count the ticks before it
+	float _maxX = 0.f;
+	float _percentage = 0.f; // furthest progress, not where the attempt ended
+	int _jumps = 0;
+	int _orbActivations = 0;
+	int _padActivations = 0;
+	int _deathObject = -1; // index into SimLevel::_objects of the killer, -1 for none or the ground
+	bool _dead = false;
+	bool _completed = false;
+
+	// call right after SimWorld::reset or restoring a checkpoint, ticks and jumps are counted from there
+	void reset(const SimWorld& world);
+
+	// call after every SimWorld::step, reads the step's events
+	void update(const SimWorld& world);
+
+  private:
+	uint64_t _startTick = 0;
+	int _jumpedTimesAtStart = 0;
+};
@@ -0,0 +1,285 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "SimLevel.h"
+
+#include <algorithm>
+#include <charconv>
+
+#include "CompiledLevel.h"
+#include "GameToolbox/tokenizer.h"
+#include "external/fast_float.h"
+
+namespace
+{
+int parseInt(std::string_view s)
+{
+	int ret = 0;
+	std::from_chars(s.data(), s.data() + s.size(), ret);
+	return ret;
+}
+
+float parseFloat(std::string_view s)
+{
+	float ret = 0.0f;
+	fast_float::from_chars(s.data(), s.data() + s.size(), ret);
+	return ret;
+}
+
+} // namespace
+
+int SimLevel::sectionForPos(float x)
+{
+	int section = x / 100;
+	if (section < 0)
+		section = 0;
+	return section;
+}
+
+std::shared_ptr<const SimLevel> SimLevel::create(std::vector<SimObject> objects, const SimLevelSettings& settings,
+												 float lastObjXPos)
+{
+	auto level = std::make_shared<SimLevel>();
+
+	level->_objects.reserve(objects.size());
+	for (const SimObject& obj : objects)
+	{
+		if (obj._outerBounds.width <= 0 || obj._outerBounds.height <= 0)
+			continue;
+		level->_objects.push_back(obj);
+	}
+	level->_settings = settings;
+	level->_lastObjXPos = lastObjXPos;
+	level->buildSections();
+	level->computeHash();
+
+	return level;
+}
+
+void SimLevel::computeHash()
+{
+	auto fnv = [](uint64_t hash, const void* data, size_t size) {
+		auto bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= bytes[i];
+			hash *= 0x100000001b3ull;
+		}
+		return hash;
+	};
+	constexpr uint64_t kBasis = 0xcbf29ce484222325ull;
+
+	// summed per object hashes, the order objects were added in doesn't matter
+	uint64_t objects = 0;
+	for (const SimObject& obj : _objects)
+	{
+		uint64_t hash = fnv(kBasis, &obj._id, sizeof(obj._id));
+		hash = fnv(hash, &obj._type, sizeof(obj._type));
+		hash = fnv(hash, &obj._position, sizeof(obj._position));
+		hash = fnv(hash, &obj._outerBounds, sizeof(obj._outerBounds));
+		hash = fnv(hash, &obj._radius, sizeof(obj._radius));
+		objects += hash;
+	}
+
+	int settings[] = {_settings.gamemode, _settings.mini, _settings.dual, _settings.flipGravity, _settings.speed};
+	_hash = fnv(kBasis, &objects, sizeof(objects));
+	_hash = fnv(_hash, settings, sizeof(settings));
+	_hash = fnv(_hash, &_lastObjXPos, sizeof(_lastObjXPos));
+}
+
+void SimLevel::buildSections()
+{
+	int sectionCount = sectionForPos(_lastObjXPos);
+
+	auto sectionOf = [sectionCount](const SimObject& obj) {
+		int section = sectionForPos(obj._position.x) - 1;
+		return std::clamp(section, 0, std::max(sectionCount - 1, 0));
+	};
+
+	// counting sort keeps the objects of a section in level order, collisions depend on it
+	_sectionStart.assign(sectionCount + 1, 0);
+	for (const SimObject& obj : _objects)
+		_sectionStart[sectionOf(obj) + 1]++;
+	for (int i = 0; i < sectionCount; i++)
+		_sectionStart[i + 1] += _sectionStart[i];
+
+	std::vector<uint32_t> fill(_sectionStart.begin(), _sectionStart.end() - 1);
+	_sectionObjects.resize(_objects.size());
+	for (uint32_t i = 0; i < _objects.size(); i++)
+		_sectionObjects[fill[sectionOf(_objects[i])]++] = i;
+}
+
+std::shared_ptr<const SimLevel> SimLevel::createFromString(std::string_view levelString,
+														   const std::unordered_map<int, GameObjectType>& objectTypes)
+{
+	SimLevelSettings settings;
+	std::vector<SimObject> objects;
+	float lastObjXPos = 570.0f;
+
+	size_t headerEnd = levelString.find(';');
+	std::string_view header = levelString.substr(0, headerEnd);
+
+	for (auto [key, value] : GameToolbox::KeyValues(header))
+	{
+		if (key == "kA2")
+			settings.gamemode = (PlayerGamemode)parseInt(value);
+		else if (key == "kA3")
+			settings.mini = parseInt(value);
+		else if (key == "kA4")
+			settings.speed = parseInt(value);
+		else if (key == "kA8")
+			settings.dual = parseInt(value);
+		else if (key == "kA11")
+			settings.flipGravity = parseInt(value);
+	}
+
+	if (headerEnd == std::string_view::npos)
+		return create(std::move(objects), settings, lastObjXPos);
+
+	std::string_view objectString = levelString.substr(headerEnd + 1);
+	objects.reserve(std::count(objectString.begin(), objectString.end(), ';') + 1);
+
+	int uniqueID = 0;
+	for (std::string_view data : GameToolbox::Tokens(objectString, ';'))
+	{
+		int id = -1;
+		SimVec2 pos;
+		float rotation = 0.f, scaleX = 1.f, scaleY = 1.f;
+
+		for (auto [keyString, token] : GameToolbox::KeyValues(data))
+		{
+			int key = parseInt(keyString);
+			// same rule as PlayLayer::loadLevel, the id has to come first
+			if (key != 1 && id == -1)
+				break;
+
+			switch (key)
+			{
+			case 1:
+				id = parseInt(token);
+				break;
+			case 2:
+				pos.x = parseFloat(token);
+				break;
+			case 3:
+				pos.y = parseFloat(token) + 90.0f;
+				break;
+			case 4:
+				scaleX = -1.f * parseInt(token);
+				break;
+			case 5:
+				scaleY = -1.f * parseInt(token);
+				break;
+			case 6:
+				rotation = parseFloat(token);
+				break;
+			case 32:
+				scaleX = scaleX * parseFloat(token);
+				scaleY = scaleY * parseFloat(token);
+				break;
+			}
+		}
+
+		bool isTrigger = ObjectData::isTrigger(id);
+		bool hasHitbox = ObjectData::hitboxes.contains(id);
+		auto typeIt = objectTypes.find(id);
+
+		if (id < 0 || (!hasHitbox && !isTrigger && typeIt == objectTypes.end()))
+			continue;
+
+		if (lastObjXPos < pos.x)
+			lastObjXPos = pos.x;
+
+		SimObject obj;
+		obj._id = id;
+		obj._uniqueID = uniqueID++;
+		obj._type = typeIt != objectTypes.end() ? typeIt->second : kGameObjectTypeSolid;
+		obj._isTrigger = isTrigger;
+		obj._position = pos;
+		obj._radius = -1;
+
+		if (auto radius = ObjectData::hitboxRadius.find(id); radius != ObjectData::hitboxRadius.end())
+			obj._radius = radius->second;
+
+		if (hasHitbox && obj._type != kGameObjectTypeDecoration && obj._type != kGameObjectTypeSpecial)
+			obj._outerBounds = ObjectData::computeOuterBounds(ObjectData::hitboxes.at(id), pos, rotation, scaleX, scaleY);
+
+		objects.push_back(obj);
+	}
+
+	return create(std::move(objects), settings, lastObjXPos);
+}
+
+std::shared_ptr<const SimLevel> SimLevel::createFromCompiled(const CompiledLevel& level,
+															 const std::unordered_map<int, GameObjectType>& objectTypes)
+{
+	const CompiledLevelHeader& header = level.getHeader();
+
+	SimLevelSettings settings;
+	settings.gamemode = (PlayerGamemode)header._gamemode;
+	settings.mini = header._mini;
+	settings.speed = header._speed;
+	settings.dual = header._dual;
+	settings.flipGravity = header._flipGravity;
+
+	auto ids = level.getIDs();
+	auto xs = level.getX();
+	auto ys = level.getY();
+	auto rotations = level.getRotation();
+	auto scaleXs = level.getScaleX();
+	auto scaleYs = level.getScaleY();
+
+	std::vector<SimObject> objects;
+	objects.reserve(level.size());
+	float lastObjXPos = 570.0f;
+
+	int uniqueID = 0;
+	for (size_t i = 0; i < level.size(); i++)
+	{
+		int id = ids[i];
+		bool isTrigger = ObjectData::isTrigger(id);
+		bool hasHitbox = ObjectData::hitboxes.contains(id);
+		auto typeIt = objectTypes.find(id);
+
+		if (id < 0 || (!hasHitbox && !isTrigger && typeIt == objectTypes.end()))
+			continue;
+
+		SimVec2 pos = {xs[i], ys[i]};
+		if (lastObjXPos < pos.x)
+			lastObjXPos = pos.x;
+
+		SimObject obj;
+		obj._id = id;
+		obj._uniqueID = uniqueID++;
+		obj._type = typeIt != objectTypes.end() ? typeIt->second : kGameObjectTypeSolid;
+		obj._isTrigger = isTrigger;
+		obj._position = pos;
+		obj._radius = -1;
+
+		if (auto radius = ObjectData::hitboxRadius.find(id); radius != ObjectData::hitboxRadius.end())
+			obj._radius = radius->second;
+
+		if (hasHitbox && obj._type != kGameObjectTypeDecoration && obj._type != kGameObjectTypeSpecial)
+			obj._outerBounds =
+				ObjectData::computeOuterBounds(ObjectData::hitboxes.at(id), pos, rotations[i], scaleXs[i], scaleYs[i]);
+
+		objects.push_back(obj);
+	}
+
+	return create(std::move(objects), settings, lastObjXPos);
+}
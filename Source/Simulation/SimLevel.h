@@ -0,0 +1,87 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "ObjectData.h"
+#include "SimPlayer.h"
+#include "SimTypes.h"
+
+class CompiledLevel;
+
+// one collidable object, everything the physics needs and nothing the renderer needs
+struct SimObject
+{
+	int _id;
+	int _uniqueID; // index of the matching GameObject in PlayLayer::_pObjects, or the object index in the level string
+	GameObjectType _type;
+	bool _isTrigger;
+	SimVec2 _position;
+	SimRect _outerBounds;
+	float _radius;
+};
+
+struct SimLevelSettings
+{
+	PlayerGamemode gamemode = PlayerGamemodeCube;
+	bool mini = false, dual = false, flipGravity = false;
+	int speed = 0;
+};
+
+// Immutable level data shared by every SimWorld that plays it. Objects are bucketed into
+// 100 unit sections the same way PlayLayer::_sectionObjects is, stored as one flat index array.
+class SimLevel
+{
+  public:
+	std::vector<SimObject> _objects;
+	std::vector<uint32_t> _sectionStart; // section i is _sectionObjects[_sectionStart[i], _sectionStart[i + 1])
+	std::vector<uint32_t> _sectionObjects;
+
+	SimLevelSettings _settings;
+	float _lastObjXPos = 570.0f;
+
+	// identifies the physics content: objects, settings and end position. It doesn't depend on the
+	// object order, a level built from PlayLayer's objects hashes like one built from the string
+	uint64_t _hash = 0;
+
+	static int sectionForPos(float x);
+
+	int getSectionCount() const { return _sectionStart.empty() ? 0 : (int)_sectionStart.size() - 1; }
+
+	// objects without a hitbox are dropped, they can never collide
+	static std::shared_ptr<const SimLevel> create(std::vector<SimObject> objects, const SimLevelSettings& settings,
+												  float lastObjXPos);
+
+	// builds a level straight from an uncompressed level string, no GameObjects involved.
+	// objectTypes comes from ObjectData::parseObjectTypes
+	static std::shared_ptr<const SimLevel> createFromString(
+		std::string_view levelString, const std::unordered_map<int, GameObjectType>& objectTypes);
+	// the same level from its CompiledLevel arrays, without parsing any text
+	static std::shared_ptr<const SimLevel> createFromCompiled(
+		const CompiledLevel& level, const std::unordered_map<int, GameObjectType>& objectTypes);
+
+  private:
+	void buildSections();
+	void computeHash();
+};
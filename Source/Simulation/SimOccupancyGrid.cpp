@@ -0,0 +1,177 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "SimOccupancyGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "SimRaycaster.h"
+#include "SimWorld.h"
+
+namespace
+{
+// blocks sit on a 30 unit grid offset by half a block in simulation coordinates
+constexpr float kGridOffset = 15.f;
+
+uint8_t cellForObject(int gameObjectType)
+{
+	switch (SimRaycaster::classify(gameObjectType))
+	{
+	case kSimRaySolid:
+		return kSimCellSolid;
+	case kSimRayHazard:
+		return kSimCellHazard;
+	case kSimRayPad:
+	case kSimRayRing:
+	case kSimRayPortal:
+		return kSimCellInteractive;
+	default:
+		return kSimCellEmpty;
+	}
+}
+
+// a hazard wins over anything else sharing its cell, then solids
+uint8_t cellPriority(uint8_t cell)
+{
+	static constexpr uint8_t priority[] = {0, 2, 3, 1};
+	return priority[cell];
+}
+} // namespace
+
+SimOccupancyGrid::SimOccupancyGrid(const SimGridConfig& config) : _config(config)
+{
+	_config._width = std::max(1, _config._width);
+	_config._height = std::max(1, _config._height);
+	_cells.resize(_config._width * _config._height);
+}
+
+void SimOccupancyGrid::computeOrigin(const SimWorld& world, int player, int& column, int& row, float& floorY,
+									 float& ceilingY) const
+{
+	const SimPlayer& p = player == 0 ? world._player1 : world._player2;
+	float cell = _config._cellSize;
+
+	// centre of the 30 unit player box
+	column = (int)std::floor((p._position.x + 15.f - kGridOffset) / cell) - _config._cellsBehind;
+	row = (int)std::floor((p._position.y + 15.f - kGridOffset) / cell) - _config._height / 2;
+	floorY = world.getFloorY(player);
+	ceilingY = world.getCeilingY(player);
+}
+
+void SimOccupancyGrid::update(const SimWorld& world, int player)
+{
+	int column, row;
+	float floorY, ceilingY;
+	computeOrigin(world, player, column, row, floorY, ceilingY);
+
+	int shift = column - _originColumn;
+	if (!_valid || row != _originRow || floorY != _floorY || ceilingY != _ceilingY || shift < 0 ||
+		shift >= _config._width)
+	{
+		rebuild(world, player);
+		return;
+	}
+
+	if (shift == 0)
+		return;
+
+	int width = _config._width;
+	for (int y = 0; y < _config._height; y++)
+	{
+		uint8_t* rowCells = _cells.data() + y * width;
+		std::memmove(rowCells, rowCells + shift, width - shift);
+	}
+
+	_originColumn = column;
+	fillColumns(world, width - shift, width);
+}
+
+void SimOccupancyGrid::rebuild(const SimWorld& world, int player)
+{
+	computeOrigin(world, player, _originColumn, _originRow, _floorY, _ceilingY);
+	_valid = true;
+	fillColumns(world, 0, _config._width);
+}
+
+void SimOccupancyGrid::fillColumns(const SimWorld& world, int first, int last)
+{
+	const SimLevel& level = *world._level;
+	const int width = _config._width;
+	const int height = _config._height;
+	const float cell = _config._cellSize;
+
+	// world space covered by the columns being filled
+	float minX = kGridOffset + (_originColumn + first) * cell;
+	float maxX = kGridOffset + (_originColumn + last) * cell;
+	float minY = kGridOffset + _originRow * cell;
+
+	for (int y = 0; y < height; y++)
+	{
+		float cellBottom = minY + y * cell;
+		uint8_t ground = (cellBottom + cell <= _floorY || cellBottom >= _ceilingY) ? kSimCellSolid : kSimCellEmpty;
+		std::memset(_cells.data() + y * width + first, ground, last - first);
+	}
+
+	int sectionCount = level.getSectionCount();
+	if (sectionCount == 0)
+		return;
+
+	// objects are bucketed one section left of their x, widen by one more for their size
+	int firstSection = std::max(0, SimLevel::sectionForPos(std::max(0.f, minX)) - 2);
+	int lastSection = std::min(sectionCount - 1, SimLevel::sectionForPos(std::max(0.f, maxX)));
+	if (firstSection > lastSection)
+		return;
+
+	for (uint32_t i = level._sectionStart[firstSection]; i < level._sectionStart[lastSection + 1]; i++)
+	{
+		const SimObject& obj = level._objects[level._sectionObjects[i]];
+		uint8_t value = cellForObject(obj._type);
+		if (value == kSimCellEmpty)
+			continue;
+
+		SimRect bounds = obj._outerBounds;
+		SimVec2 center = obj._position + SimVec2{15, 15};
+		if (obj._radius > 0)
+			bounds = {center.x - obj._radius, center.y - obj._radius, obj._radius * 2, obj._radius * 2};
+
+		// a box ending exactly on a cell edge doesn't reach into the next cell
+		int x0 = std::max(first, (int)std::floor((bounds.getMinX() - minX) / cell) + first);
+		int x1 = std::min(last - 1, (int)std::ceil((bounds.getMaxX() - minX) / cell) - 1 + first);
+		int y0 = std::max(0, (int)std::floor((bounds.getMinY() - minY) / cell));
+		int y1 = std::min(height - 1, (int)std::ceil((bounds.getMaxY() - minY) / cell) - 1);
+
+		for (int y = y0; y <= y1; y++)
+		{
+			for (int x = x0; x <= x1; x++)
+			{
+				if (obj._radius > 0)
+				{
+					SimRect cellRect = {minX + (x - first) * cell, minY + y * cell, cell, cell};
+					if (!cellRect.intersectsCircle(center, obj._radius))
+						continue;
+				}
+
+				uint8_t& current = _cells[y * width + x];
+				if (cellPriority(value) > cellPriority(current))
+					current = value;
+			}
+		}
+	}
+}
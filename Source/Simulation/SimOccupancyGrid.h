@@ -0,0 +1,71 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+class SimWorld;
+
+enum SimCell : uint8_t
+{
+	kSimCellEmpty = 0,
+	kSimCellSolid,
+	kSimCellHazard,
+	kSimCellInteractive, // pads, rings and portals
+};
+
+struct SimGridConfig
+{
+	int _width = 32;
+	int _height = 16;
+	float _cellSize = 30.f; // one block
+	int _cellsBehind = 4;	// columns kept left of the player's column
+};
+
+// Coarse picture of the level around a player, rasterised from object hitboxes instead of
+// rendered pixels. Cells are aligned to the world grid, so when the player only moves right
+// update() shifts the existing columns and rasterises the new ones on the leading edge.
+// Rows go bottom to top, _cells[row * width + column]; the ground and ceiling are solid.
+class SimOccupancyGrid
+{
+  public:
+	explicit SimOccupancyGrid(const SimGridConfig& config = {});
+
+	int getWidth() const { return _config._width; }
+	int getHeight() const { return _config._height; }
+	const uint8_t* getCells() const { return _cells.data(); }
+
+	// incremental when the grid only scrolled right since the last call, a full rebuild otherwise
+	void update(const SimWorld& world, int player);
+	void rebuild(const SimWorld& world, int player);
+
+  private:
+	SimGridConfig _config;
+	std::vector<uint8_t> _cells;
+
+	bool _valid = false;
+	int _originColumn = 0; // world cell index of column 0 / row 0
+	int _originRow = 0;
+	float _floorY = 0.f;
+	float _ceilingY = 0.f;
+
+	void computeOrigin(const SimWorld& world, int player, int& column, int& row, float& floorY, float& ceilingY) const;
+	void fillColumns(const SimWorld& world, int first, int last);
+};
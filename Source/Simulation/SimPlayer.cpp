@@ -0,0 +1,509 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "SimPlayer.h"
+
+#include <algorithm>
+
+void SimPlayer::reset()
+{
+	_yVel = 0.f;
+	_isDead = false;
+	flipGravity(false);
+	_isRising = false;
+	_isHolding = false;
+	_touchedRingObject = -1;
+	_hasRingJumped = false;
+}
+
+void SimPlayer::update(float dt)
+{
+	_prevPosition = _position;
+	if (_isDead)
+		return;
+
+	if (!_isLocked)
+	{
+		_direction = std::clamp(_direction, -1.f, 1.f);
+
+		if (!_isPlatformer)
+			_direction = 1.f;
+
+		float dtSlow = dt * 0.9f;
+		updateJump(dtSlow);
+
+		float velY = (float)((double)dtSlow * _yVel);
+		float velX = (float)((double)dt * _xVel * (!_isPlatformer ? 1.f : _direction) * _playerSpeed);
+
+		_position = _position + SimVec2{velX, velY};
+	}
+
+	_touchedRingObject = -1;
+	_touchedPadObject = -1;
+}
+
+void SimPlayer::updateBounds()
+{
+	_outerBounds = {_position.x, _position.y, 30.f, 30.f};
+	_innerBounds = {_position.x + 11.25f, _position.y + 11.25f, 7.5f, 7.5f};
+}
+
+SimRect SimPlayer::getCollisionBounds() const
+{
+	if (!_mini)
+		return _outerBounds;
+
+	SimRect r = _outerBounds;
+	r.x += r.width / 2;
+	r.y += r.height / 2;
+	r.width *= 0.6f;
+	r.height *= 0.6f;
+	r.x -= r.width / 2;
+	r.y -= r.height / 2;
+	return r;
+}
+
+void SimPlayer::updateJump(float dt)
+{
+	float localGravity = _gravity;
+
+	const int flipGravityMult = flipMod();
+
+	float playerSize = _mini ? 0.8f : 1.0f;
+
+	if (_gamemode == PlayerGamemodeShip || _gamemode == PlayerGamemodeUFO || _gamemode == PlayerGamemodeWave)
+	{
+		if (_mini)
+			playerSize = 0.85f;
+
+		float upperVelocityLimit = 8.0 / playerSize;
+		float lowerVelocityLimit = -6.4 / playerSize;
+
+		if (_gamemode == PlayerGamemodeShip)
+		{
+			float shipAccel = 0.8f;
+
+			if (_isHolding)
+				shipAccel = -1.0f;
+
+			if (!_isHolding && !playerIsFalling())
+				shipAccel = 1.2f;
+
+			float extraBoost = 0.4f;
+			if (_isHolding && playerIsFalling())
+				extraBoost = 0.5;
+
+			_yVel -= localGravity * dt * flipGravityMult * shipAccel * extraBoost / playerSize;
+		}
+		else if (_gamemode == PlayerGamemodeUFO)
+		{
+			if (_isHolding && _hasJustHeld)
+			{
+				_hasJustHeld = false;
+
+				const float sizeMult = _mini ? 8.f : 7.f;
+				double newVel = flipMod() * sizeMult * playerSize;
+
+				if ((!_gravityFlipped && _yVel < newVel) || newVel < _yVel)
+					_yVel = newVel;
+			}
+			float gravityMult = 0.8f;
+
+			if (!playerIsFalling())
+				gravityMult = 1.2f;
+
+			_yVel -= localGravity * dt * flipMod() * gravityMult * 0.5 / playerSize;
+		}
+
+		if (!_gravityFlipped)
+		{
+			if (_yVel <= lowerVelocityLimit)
+				_yVel = lowerVelocityLimit;
+		}
+		else
+		{
+			if (_yVel <= -upperVelocityLimit)
+				_yVel = -upperVelocityLimit;
+
+			upperVelocityLimit = 6.4f / playerSize;
+		}
+		if (_yVel >= upperVelocityLimit)
+			_yVel = upperVelocityLimit;
+	}
+	else
+	{
+		float gravityMultiplier = 1.0f;
+
+		if (_gamemode == PlayerGamemodeBall)
+			gravityMultiplier = 0.6f;
+
+		bool shouldJump = _isHolding;
+
+		if (shouldJump && _onGround)
+		{
+			_isRising = true;
+			_onGround = false;
+
+			float jumpAccel = _jumpHeight;
+
+			_yVel = flipGravityMult * jumpAccel * playerSize;
+
+			if (_gamemode == PlayerGamemodeBall)
+			{
+				flipGravity(!_gravityFlipped);
+				_isHolding = false;
+				_yVel *= 0.6;
+			}
+			else if (_gamemode == PlayerGamemodeCube)
+			{
+				if (_touchedRingObject < 0)
+					_queuedHold = false;
+				_events |= kSimPlayerEventRotate;
+			}
+		}
+		else
+		{
+			if (_isRising)
+			{
+				_yVel -= localGravity * dt * flipGravityMult * gravityMultiplier;
+				if (playerIsFalling())
+				{
+					_isRising = false;
+					_onGround = false;
+				}
+			}
+			else
+			{
+				if (!_gravityFlipped)
+				{
+					if (_yVel < -_gravity * 2.f)
+						_onGround = false;
+				}
+				else
+				{
+					if (_yVel > _gravity * 2.f)
+						_onGround = false;
+				}
+
+				_yVel -= localGravity * dt * flipGravityMult * gravityMultiplier;
+				_yVel = _gravityFlipped ? std::min(_yVel, 15.0) : std::max(_yVel, -15.0);
+				if (!_gravityFlipped)
+				{
+					if (_yVel >= _gravity * 2.0f)
+						return;
+				}
+				else
+				{
+					if (_yVel <= _gravity * 2.0f)
+						return;
+				}
+
+				if (_gamemode != PlayerGamemodeBall)
+					_events |= kSimPlayerEventFallRotate;
+			}
+		}
+	}
+}
+
+bool SimPlayer::playerIsFalling() const
+{
+	if (_gravityFlipped)
+		return _yVel > _gravity;
+	else
+		return _yVel < _gravity;
+}
+
+bool SimPlayer::collidedWithObject(const SimRect& rect, bool isTrigger)
+{
+	SimVec2 pos = _position;
+
+	SimRect playerRectO = getCollisionBounds();
+	SimRect playerRectI = _innerBounds;
+
+	float flipModV = flipMod();
+
+	float mod = flipModV * 10.0f;
+
+	if (_gamemode == PlayerGamemodeShip)
+		mod = flipModV * 6.0f;
+
+	float topP = (pos.y + (playerRectO.y * -0.5f * -flipMod())) - mod;
+	float bottomP = (pos.y + (playerRectO.y * -0.5f * flipMod())) + mod;
+
+	float MaxY = rect.getMaxY();
+	float MinY = rect.getMinY();
+
+	float MaxYP = playerRectO.getMaxY();
+	float MinYP = playerRectO.getMinY();
+
+	float t = topP;
+	float b = bottomP;
+
+	if (_gravityFlipped)
+	{
+		if (_gamemode != PlayerGamemodeShip && _gamemode != PlayerGamemodeUFO)
+			goto topCollision;
+		t = bottomP;
+		b = topP;
+	}
+	if (b >= MaxY || t >= MaxY)
+	{
+		if (_yVel < 0.0f)
+		{
+			playerRectI.x = rect.x;
+			if (playerRectI.intersectsRect(rect))
+			{
+				playerRectI.x = pos.x;
+				goto death;
+			}
+			if (MaxYP >= (MinY + MaxY) / 2.f)
+			{
+				_position.y = MaxY - (_mini ? 6 : 0);
+				hitGround(_gravityFlipped ? _gamemode == PlayerGamemodeShip : false);
+			}
+		}
+	}
+
+	if (!_gravityFlipped)
+	{
+		if (_gamemode != PlayerGamemodeShip && _gamemode != PlayerGamemodeUFO)
+			goto death;
+		t = bottomP;
+		b = topP;
+	}
+topCollision:
+	if (b <= MinY || t <= MinY)
+	{
+		if (_yVel > 0.0f)
+		{
+			playerRectI.x = rect.x;
+			if (playerRectI.intersectsRect(rect))
+			{
+				playerRectI.x = pos.x;
+				goto death;
+			}
+
+			if (MinYP <= (MinY + MaxY) / 2.f)
+			{
+				_position.y = MinY - (_mini ? 24 : 30);
+				hitGround(!_gravityFlipped ? _gamemode == PlayerGamemodeShip : false);
+			}
+		}
+	}
+death:
+	return playerRectI.intersectsRect(rect) && !isTrigger;
+}
+
+void SimPlayer::propellPlayer(double force)
+{
+	_isRising = true;
+	_onGround = false;
+	_yVel = flipMod() * 16 * force * (_vehicleSize == 1.0 ? 1.0 : 0.8);
+
+	if (_gamemode == PlayerGamemodeBall || _gamemode == PlayerGamemodeSpider)
+		_yVel *= 0.6;
+
+	_events |= kSimPlayerEventRotate;
+	_lastGroundPos = _position;
+}
+
+bool SimPlayer::ringJump(GameObjectType ringType)
+{
+	if (_touchedRingObject < 0 || !_queuedHold || !_isHolding)
+		return false;
+
+	_isRising = true;
+	_queuedHold = false;
+	_onGround = false;
+
+	double newYVel = _jumpHeight;
+
+	switch (ringType)
+	{
+	case kGameObjectTypeDropRing:
+		switch (_gamemode)
+		{
+		case PlayerGamemodeUFO:
+			newYVel = -11.2 * flipMod();
+			break;
+		case PlayerGamemodeShip:
+		case PlayerGamemodeWave:
+			newYVel = -14 * flipMod();
+			break;
+		case PlayerGamemodeSpider:
+			newYVel = -16.5 * flipMod();
+			break;
+		default:
+			newYVel = -15 * flipMod();
+			break;
+		}
+		_yVel = newYVel;
+		if (_gamemode == PlayerGamemodeBall)
+			_isHolding = false;
+		_touchedRingObject = -1;
+		return true;
+	case kGameObjectTypeRedJumpRing:
+		switch (_gamemode)
+		{
+		case PlayerGamemodeShip:
+			if (_vehicleSize != 1.0f)
+				newYVel *= 1.4;
+			break;
+		case PlayerGamemodeUFO:
+			if (_vehicleSize == 1.0f)
+				newYVel *= 1.02;
+			else
+				newYVel *= 1.36;
+			break;
+		case PlayerGamemodeSpider:
+		case PlayerGamemodeBall:
+			newYVel *= 1.34;
+			break;
+		case PlayerGamemodeRobot:
+			newYVel *= 1.28;
+			break;
+		default:
+			newYVel *= 1.38;
+			break;
+		}
+		break;
+	case kGameObjectTypePinkJumpRing:
+		switch (_gamemode)
+		{
+		case PlayerGamemodeShip:
+			newYVel *= 0.37;
+			break;
+		case PlayerGamemodeUFO:
+			newYVel *= 0.42;
+			break;
+		case PlayerGamemodeBall:
+			newYVel *= 0.77;
+			break;
+		default:
+			newYVel *= 0.72;
+			break;
+		}
+		break;
+	case kGameObjectTypeGravityRing:
+		newYVel *= 0.8;
+		break;
+	case kGameObjectTypeGreenRing:
+		if (_gamemode == PlayerGamemodeShip)
+			newYVel *= 0.7;
+		flipGravity(!_gravityFlipped);
+		break;
+	default:
+		if (_gamemode == PlayerGamemodeRobot)
+			newYVel *= 0.9;
+		break;
+	}
+
+	newYVel *= flipMod();
+	newYVel *= _vehicleSize < 1.f ? 0.8f : 1.f;
+
+	_yVel = newYVel;
+
+	_events |= _gamemode == PlayerGamemodeBall ? kSimPlayerEventBallRotate : kSimPlayerEventRotate;
+	_touchedRingObject = -1;
+	_hasRingJumped = true;
+	_lastGroundPos = _position;
+
+	if (_gamemode == PlayerGamemodeBall || _gamemode == PlayerGamemodeSpider)
+	{
+		_isHolding = false;
+		_yVel *= 0.7;
+	}
+
+	if (ringType == kGameObjectTypeGravityRing)
+		flipGravity(!_gravityFlipped);
+
+	return true;
+}
+
+void SimPlayer::hitGround(bool reverseGravity)
+{
+	_yVel = 0.0f;
+
+	if (!_onGround && !reverseGravity)
+		_events |= kSimPlayerEventLanded;
+
+	if (_gamemode == PlayerGamemodeBall && !_onGround)
+		_events |= kSimPlayerEventBallRotate;
+
+	_queuedHold = false;
+	_onGround = true;
+
+	_events |= kSimPlayerEventStopRotation;
+
+	_lastGroundPos = _position;
+}
+
+void SimPlayer::flipGravity(bool gravity)
+{
+	if (_gravityFlipped != gravity)
+	{
+		_gravityFlipped = gravity;
+		_yVel /= 2.f;
+		_events |= kSimPlayerEventGravityFlipped;
+	}
+}
+
+void SimPlayer::setGamemode(PlayerGamemode mode)
+{
+	if (_gamemode == mode)
+		return;
+
+	switch (mode)
+	{
+	case PlayerGamemodeCube:
+		_onGround = false;
+		break;
+	case PlayerGamemodeShip:
+		_yVel /= 2.f;
+		_onGround = false;
+		break;
+	default:
+		break;
+	}
+
+	_gamemode = mode;
+}
+
+void SimPlayer::toggleMini(bool active)
+{
+	_mini = active;
+	_vehicleSize = active ? 0.6f : 1.f;
+	_events |= kSimPlayerEventMiniChanged;
+}
+
+void SimPlayer::pushButton()
+{
+	_isHolding = true;
+	_hasJustHeld = true;
+	_queuedHold = true;
+
+	if ((_gamemode == PlayerGamemodeCube || _gamemode == PlayerGamemodeRobot) && _onGround)
+		_jumpedTimes++;
+}
+
+void SimPlayer::releaseButton()
+{
+	_queuedHold = false;
+	_hasJustHeld = false;
+	_isHolding = false;
+}
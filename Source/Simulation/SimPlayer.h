@@ -0,0 +1,115 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include "ObjectData.h"
+#include "SimTypes.h"
+
+enum PlayerGamemode
+{
+	PlayerGamemodeCube = 0,
+	PlayerGamemodeShip = 1,
+	PlayerGamemodeBall = 2,
+	PlayerGamemodeUFO = 3,
+	PlayerGamemodeWave = 4,
+	PlayerGamemodeRobot = 5,
+	PlayerGamemodeSpider = 6,
+};
+
+// things the physics did that the PlayerObject sprite has to react to, collected in SimPlayer::_events
+// and cleared by SimWorld at the start of every step
+enum SimPlayerEvent : uint32_t
+{
+	kSimPlayerEventRotate = 1 << 0,			// start a jump rotation
+	kSimPlayerEventFallRotate = 1 << 1,		// start a jump rotation unless one is already running
+	kSimPlayerEventBallRotate = 1 << 2,		// (re)start the ball roll
+	kSimPlayerEventStopRotation = 1 << 3,	// landed, snap the rotation
+	kSimPlayerEventLanded = 1 << 4,			// land particles
+	kSimPlayerEventGravityFlipped = 1 << 5, // flip the sprite and particles
+	kSimPlayerEventMiniChanged = 1 << 6,	// scale the sprite
+};
+
+// Player physics state, ported from PlayerObject. Trivially copyable on purpose: no pointers,
+// objects are referenced by their index in SimLevel::_objects.
+struct SimPlayer
+{
+	SimVec2 _position;
+	SimVec2 _prevPosition;
+	SimVec2 _lastGroundPos;
+
+	SimRect _outerBounds;
+	SimRect _innerBounds;
+
+	double _yVel = 0;
+	double _xVel = 5.770002;
+	double _gravity = 0.958199;
+	double _jumpHeight = 11.180032;
+
+	float _playerSpeed = 0.9f;
+	float _vehicleSize = 1.f;
+	float _direction = 1.f;
+
+	PlayerGamemode _gamemode = PlayerGamemodeCube;
+
+	int _jumpedTimes = 0;
+	int _touchedRingObject = -1;
+	int _touchedPadObject = -1;
+
+	uint32_t _events = 0;
+
+	bool _onGround = false;
+	bool _isDead = false;
+	bool _isLocked = false;
+	bool _gravityFlipped = false;
+	bool _isRising = false;
+	bool _isHolding = false;
+	bool _hasJustHeld = false;
+	bool _queuedHold = false;
+	bool _hasRingJumped = false;
+	bool _mini = false;
+	bool _isPlatformer = false;
+	bool _noclip = false;
+
+	void reset();
+	void update(float dt);
+	void updateJump(float dt);
+	void updateBounds();
+
+	// returns true if the object kills the player
+	bool collidedWithObject(const SimRect& rect, bool isTrigger);
+
+	void propellPlayer(double force);
+	// returns true if the ring was used
+	bool ringJump(GameObjectType ringType);
+	void hitGround(bool reverseGravity);
+	void flipGravity(bool gravity);
+	void setGamemode(PlayerGamemode mode);
+	void toggleMini(bool active);
+
+	void pushButton();
+	void releaseButton();
+
+	bool playerIsFalling() const;
+	float flipMod() const { return _gravityFlipped ? -1.0f : 1.0f; }
+
+	// outer bounds used for object collisions, shrunk for mini like GameObject::getOuterBounds(0.6f, 0.6f)
+	SimRect getCollisionBounds() const;
+};
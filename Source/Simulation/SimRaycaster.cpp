@@ -0,0 +1,226 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "SimRaycaster.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "SimWorld.h"
+
+namespace
+{
+// distance along dir from origin to the rect, infinity if the ray misses it
+float rayRect(SimVec2 origin, SimVec2 dir, const SimRect& rect)
+{
+	float tMin = 0.f;
+	float tMax = std::numeric_limits<float>::infinity();
+
+	const float o[2] = {origin.x, origin.y};
+	const float d[2] = {dir.x, dir.y};
+	const float lo[2] = {rect.getMinX(), rect.getMinY()};
+	const float hi[2] = {rect.getMaxX(), rect.getMaxY()};
+
+	for (int axis = 0; axis < 2; axis++)
+	{
+		if (d[axis] == 0.f)
+		{
+			if (o[axis] < lo[axis] || o[axis] > hi[axis])
+				return std::numeric_limits<float>::infinity();
+			continue;
+		}
+
+		float inv = 1.f / d[axis];
+		float t0 = (lo[axis] - o[axis]) * inv;
+		float t1 = (hi[axis] - o[axis]) * inv;
+		if (t0 > t1)
+			std::swap(t0, t1);
+
+		tMin = std::max(tMin, t0);
+		tMax = std::min(tMax, t1);
+		if (tMin > tMax)
+			return std::numeric_limits<float>::infinity();
+	}
+
+	return tMin;
+}
+
+float rayCircle(SimVec2 origin, SimVec2 dir, SimVec2 center, float radius)
+{
+	SimVec2 toCenter = center - origin;
+	float along = toCenter.x * dir.x + toCenter.y * dir.y;
+	float distSq = toCenter.x * toCenter.x + toCenter.y * toCenter.y;
+	float radiusSq = radius * radius;
+
+	if (distSq <= radiusSq)
+		return 0.f;
+	if (along < 0.f)
+		return std::numeric_limits<float>::infinity();
+
+	float offSq = distSq - along * along;
+	if (offSq > radiusSq)
+		return std::numeric_limits<float>::infinity();
+
+	return along - std::sqrt(radiusSq - offSq);
+}
+
+// distance to a horizontal line, infinity when the ray points away from it
+float rayLine(SimVec2 origin, SimVec2 dir, float y)
+{
+	if (dir.y == 0.f)
+		return std::numeric_limits<float>::infinity();
+
+	float t = (y - origin.y) / dir.y;
+	return t >= 0.f ? t : std::numeric_limits<float>::infinity();
+}
+} // namespace
+
+SimRaycaster::SimRaycaster(const SimRaycastConfig& config) : _config(config)
+{
+	int count = std::clamp(config._rayCount, 1, kMaxRays);
+	_directions.reserve(count);
+
+	for (int i = 0; i < count; i++)
+	{
+		float t = count == 1 ? 0.5f : (float)i / (count - 1);
+		float angle = (config._minAngle + (config._maxAngle - config._minAngle) * t) * 3.14159265f / 180.f;
+		_directions.push_back({std::cos(angle), std::sin(angle)});
+	}
+}
+
+int SimRaycaster::classify(int gameObjectType)
+{
+	switch (gameObjectType)
+	{
+	case kGameObjectTypeSolid:
+	case kGameObjectTypeSlope:
+		return kSimRaySolid;
+	case kGameObjectTypeHazard:
+		return kSimRayHazard;
+	case kGameObjectTypeYellowJumpPad:
+	case kGameObjectTypePinkJumpPad:
+	case kGameObjectTypeGravityPad:
+	case kGameObjectTypeRedJumpPad:
+		return kSimRayPad;
+	case kGameObjectTypeYellowJumpRing:
+	case kGameObjectTypePinkJumpRing:
+	case kGameObjectTypeGravityRing:
+	case kGameObjectTypeGreenRing:
+	case kGameObjectTypeDropRing:
+	case kGameObjectTypeRedJumpRing:
+	case kGameObjectTypeCustomRing:
+	case kGameObjectTypeDashRing:
+	case kGameObjectTypeGravityDashRing:
+		return kSimRayRing;
+	case kGameObjectTypeInverseGravityPortal:
+	case kGameObjectTypeNormalGravityPortal:
+	case kGameObjectTypeShipPortal:
+	case kGameObjectTypeCubePortal:
+	case kGameObjectTypeInverseMirrorPortal:
+	case kGameObjectTypeNormalMirrorPortal:
+	case kGameObjectTypeBallPortal:
+	case kGameObjectTypeRegularSizePortal:
+	case kGameObjectTypeMiniSizePortal:
+	case kGameObjectTypeUfoPortal:
+	case kGameObjectTypeDualPortal:
+	case kGameObjectTypeSoloPortal:
+	case kGameObjectTypeWavePortal:
+	case kGameObjectTypeRobotPortal:
+	case kGameObjectTypeTeleportPortal:
+	case kGameObjectTypeSpiderPortal:
+		return kSimRayPortal;
+	default:
+		return -1;
+	}
+}
+
+void SimRaycaster::cast(const SimWorld& world, int playerIndex, float* out) const
+{
+	const SimPlayer& player = playerIndex == 0 ? world._player1 : world._player2;
+	const SimLevel& level = *world._level;
+	const int rays = (int)_directions.size();
+	const float maxDistance = _config._maxDistance;
+
+	// _position is the corner of the 30 unit player box
+	SimVec2 origin = player._position + SimVec2{15, 15};
+
+	float hitDistance[kMaxRays];
+	int hitClass[kMaxRays];
+	SimVec2 dirs[kMaxRays];
+
+	for (int r = 0; r < rays; r++)
+	{
+		dirs[r] = {_directions[r].x * player._direction, _directions[r].y * player.flipMod()};
+		hitDistance[r] = maxDistance;
+		hitClass[r] = -1;
+	}
+
+	float floorY = world.getFloorY(playerIndex);
+	float ceilingY = world.getCeilingY(playerIndex);
+
+	for (int r = 0; r < rays; r++)
+	{
+		float t = std::min(rayLine(origin, dirs[r], floorY), rayLine(origin, dirs[r], ceilingY));
+		if (t < hitDistance[r])
+		{
+			hitDistance[r] = t;
+			hitClass[r] = kSimRaySolid;
+		}
+	}
+
+	// an object sits one section left of its x, so widen by one section on the left and one for size
+	int sectionCount = level.getSectionCount();
+	if (sectionCount > 0)
+	{
+		int first = std::max(0, SimLevel::sectionForPos(std::max(0.f, origin.x - maxDistance)) - 2);
+		int last = std::min(sectionCount - 1, SimLevel::sectionForPos(origin.x + maxDistance));
+
+		for (uint32_t i = level._sectionStart[first]; i < level._sectionStart[last + 1]; i++)
+		{
+			const SimObject& obj = level._objects[level._sectionObjects[i]];
+			int cls = classify(obj._type);
+			if (cls < 0)
+				continue;
+
+			// hazards with a radius collide as circles, see SimWorld::checkCollisions
+			SimVec2 center = obj._position + SimVec2{15, 15};
+
+			for (int r = 0; r < rays; r++)
+			{
+				float t = obj._radius > 0 ? rayCircle(origin, dirs[r], center, obj._radius)
+										  : rayRect(origin, dirs[r], obj._outerBounds);
+				if (t < hitDistance[r])
+				{
+					hitDistance[r] = t;
+					hitClass[r] = cls;
+				}
+			}
+		}
+	}
+
+	for (int r = 0; r < rays; r++)
+	{
+		float* ray = out + r * kFloatsPerRay;
+		std::fill(ray, ray + kFloatsPerRay, 0.f);
+
+		ray[0] = hitDistance[r] / maxDistance;
+		if (hitClass[r] >= 0)
+			ray[1 + hitClass[r]] = 1.f;
+	}
+}
@@ -0,0 +1,70 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "SimTypes.h"
+
+class SimWorld;
+
+// What a ray ran into, one slot each in the per ray output
+enum SimRayClass
+{
+	kSimRaySolid = 0,
+	kSimRayHazard,
+	kSimRayPad,
+	kSimRayRing,
+	kSimRayPortal,
+	kSimRayClassCount
+};
+
+struct SimRaycastConfig
+{
+	int _rayCount = 8; // up to SimRaycaster::kMaxRays
+	float _minAngle = -60.f; // degrees, 0 is straight ahead, positive is away from the ground
+	float _maxAngle = 60.f;
+	float _maxDistance = 600.f;
+};
+
+// Cheap stand-in for looking at the screen: a fan of rays cast from a player through the
+// level's section index. Every ray writes kFloatsPerRay floats: the hit distance divided by
+// _maxDistance (1 when nothing was hit) followed by a one hot SimRayClass of what was hit.
+// Rays follow the player's direction and gravity, so a flipped player sees the same layout.
+// The ground and ceiling count as solid.
+class SimRaycaster
+{
+  public:
+	static constexpr int kFloatsPerRay = 1 + kSimRayClassCount;
+	static constexpr int kMaxRays = 64;
+
+	explicit SimRaycaster(const SimRaycastConfig& config = {});
+
+	int getOutputSize() const { return (int)_directions.size() * kFloatsPerRay; }
+
+	// out has to hold getOutputSize() floats
+	void cast(const SimWorld& world, int player, float* out) const;
+
+	// -1 for objects rays go through: decoration, coins, triggers and the like
+	static int classify(int gameObjectType);
+
+  private:
+	SimRaycastConfig _config;
+	std::vector<SimVec2> _directions; // unit vectors for a player facing right with normal gravity
+};
@@ -0,0 +1,261 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "SimReplay.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+// magic, version, tick rate, level id, level hash, ticks, final x and y, dead as 4 bytes, start x and tick, seed
+constexpr size_t kHeaderSize = 4 + 2 + 2 + 4 + 8 + 8 + 4 + 4 + 4 + 4 + 8 + 8;
+
+template <typename T> void put(std::vector<uint8_t>& out, T value)
+{
+	size_t at = out.size();
+	out.resize(at + sizeof(T));
+	std::memcpy(out.data() + at, &value, sizeof(T));
+}
+
+template <typename T> bool get(const uint8_t*& data, const uint8_t* end, T& value)
+{
+	if (end - data < (ptrdiff_t)sizeof(T))
+		return false;
+	std::memcpy(&value, data, sizeof(T));
+	data += sizeof(T);
+	return true;
+}
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		out.push_back(static_cast<uint8_t>(value) | 0x80);
+		value >>= 7;
+	}
+	out.push_back(static_cast<uint8_t>(value));
+}
+
+bool getVarint(const uint8_t*& data, const uint8_t* end, uint64_t& value)
+{
+	value = 0;
+	for (int shift = 0; shift < 64 && data < end; shift += 7)
+	{
+		uint8_t byte = *data++;
+		value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+		if (!(byte & 0x80))
+			return true;
+	}
+	return false;
+}
+} // namespace
+
+std::vector<uint8_t> SimReplay::encode() const
+{
+	std::vector<uint8_t> out;
+	out.reserve(kHeaderSize + _inputs.size() * 2 + _checkpoints.size() * 4 + _tickHashes.size() + 16);
+
+	put(out, kMagic);
+	put(out, kVersion);
+	put(out, _tickRate);
+	put(out, _levelID);
+	put(out, _levelHash);
+	put(out, _ticks);
+	put(out, _finalPosition.x);
+	put(out, _finalPosition.y);
+	put(out, static_cast<uint32_t>(_dead));
+	put(out, _startX);
+	put(out, _startTick);
+	put(out, _seed);
+
+	putVarint(out, _inputs.size());
+	uint64_t previous = 0;
+	for (const SimInput& input : _inputs)
+	{
+		putVarint(out, (input._tick - previous) << 2 | (input._player & 1) << 1 | input._press);
+		previous = input._tick;
+	}
+
+	putVarint(out, _checkpoints.size());
+	for (uint32_t checkpoint : _checkpoints)
+		put(out, checkpoint);
+
+	putVarint(out, _tickHashes.size());
+	out.insert(out.end(), _tickHashes.begin(), _tickHashes.end());
+
+	return out;
+}
+
+bool SimReplay::decode(const uint8_t* data, size_t size)
+{
+	const uint8_t* end = data + size;
+
+	uint32_t magic, dead;
+	uint16_t version;
+	if (!get(data, end, magic) || magic != kMagic || !get(data, end, version) || version != kVersion)
+		return false;
+	if (!get(data, end, _tickRate) || !get(data, end, _levelID) || !get(data, end, _levelHash) ||
+		!get(data, end, _ticks) || !get(data, end, _finalPosition.x) || !get(data, end, _finalPosition.y) ||
+		!get(data, end, dead))
+		return false;
+	_dead = dead;
+
+	if (!get(data, end, _startX) || !get(data, end, _startTick) || !get(data, end, _seed))
+		return false;
+
+	uint64_t count;
+	if (!getVarint(data, end, count) || count > size)
+		return false;
+
+	_inputs.resize(count);
+	uint64_t tick = 0;
+	for (SimInput& input : _inputs)
+	{
+		uint64_t packed;
+		if (!getVarint(data, end, packed))
+			return false;
+		tick += packed >> 2;
+		input = {tick, static_cast<uint8_t>(packed >> 1 & 1), static_cast<bool>(packed & 1)};
+	}
+
+	if (!getVarint(data, end, count) || count > size)
+		return false;
+
+	_checkpoints.resize(count);
+	for (uint32_t& checkpoint : _checkpoints)
+	{
+		if (!get(data, end, checkpoint))
+			return false;
+	}
+
+	if (!getVarint(data, end, count) || count > static_cast<uint64_t>(end - data))
+		return false;
+	_tickHashes.assign(data, data + count);
+
+	return true;
+}
+
+bool SimReplay::save(const std::string& path) const
+{
+	std::vector<uint8_t> data = encode();
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(reinterpret_cast<const char*>(data.data()), data.size());
+	return static_cast<bool>(file);
+}
+
+bool SimReplay::load(const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return false;
+
+	std::vector<uint8_t> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+	return decode(data.data(), data.size());
+}
+
+void SimReplayRecorder::begin(const SimWorld& world, int levelID)
+{
+	_replay = SimReplay();
+	_replay._levelID = levelID;
+	_replay._levelHash = world._level->_hash;
+	_replay._startX = world._startX;
+	_replay._startTick = world._tick;
+	_replay._seed = world._seed;
+}
+
+void SimReplayRecorder::afterStep(const SimWorld& world)
+{
+	if (world._tick <= _replay._startTick)
+		return;
+
+	uint32_t hash = world.getStateHash();
+	_replay._tickHashes.push_back(SimReplay::getTickHash(hash));
+	if (world._tick % SimReplay::kCheckpointInterval == 0)
+		_replay._checkpoints.push_back(hash);
+}
+
+const SimReplay& SimReplayRecorder::finish(const SimWorld& world)
+{
+	_replay._inputs = world._inputs;
+	_replay._ticks = world._tick;
+	_replay._finalPosition = world._player1._position;
+	_replay._dead = world._player1._isDead;
+	return _replay;
+}
+
+SimReplayResult verifyReplay(const SimReplay& replay, std::shared_ptr<const SimLevel> level)
+{
+	SimReplayResult result;
+	if (!level || level->_hash != replay._levelHash || replay._tickRate == 0)
+	{
+		result._levelMatches = false;
+		return result;
+	}
+
+	SimWorld world(std::move(level));
+	world._seed = replay._seed;
+	world.resetAt(replay._startX);
+	float dt = 60.0f / replay._tickRate;
+
+	size_t nextInput = 0;
+	size_t nextCheckpoint = 0;
+	while (world._tick < replay._ticks)
+	{
+		while (nextInput < replay._inputs.size() && replay._inputs[nextInput]._tick <= world._tick)
+		{
+			const SimInput& input = replay._inputs[nextInput++];
+			if (input._press)
+				world.pushButton(input._player);
+			else
+				world.releaseButton(input._player);
+		}
+
+		world.step(dt);
+		if (world._tick <= replay._startTick || result._diverged)
+			continue;
+
+		// every tick when the replay has tick hashes, the checkpoints still catch what a byte can't
+		uint32_t hash = world.getStateHash();
+		size_t tickIndex = world._tick - replay._startTick - 1;
+		bool differs =
+			tickIndex < replay._tickHashes.size() && SimReplay::getTickHash(hash) != replay._tickHashes[tickIndex];
+		if (world._tick % SimReplay::kCheckpointInterval == 0 && nextCheckpoint < replay._checkpoints.size())
+			differs |= hash != replay._checkpoints[nextCheckpoint++];
+
+		if (differs)
+		{
+			result._diverged = true;
+			result._divergenceTick = world._tick;
+		}
+	}
+
+	result._ticks = world._tick;
+	result._finalPosition = world._player1._position;
+	result._dead = world._player1._isDead;
+
+	if (!result._diverged && (result._finalPosition.x != replay._finalPosition.x ||
+							  result._finalPosition.y != replay._finalPosition.y || result._dead != replay._dead))
+	{
+		result._diverged = true;
+		result._divergenceTick = world._tick;
+	}
+
+	return result;
+}
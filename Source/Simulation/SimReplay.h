@@ -0,0 +1,102 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "SimWorld.h"
+
+// Everything needed to play a run again and check it still plays out the same: the level it was
+// recorded on, the button changes, a hash of the players every simulated second and where it ended.
+// Only fixed timestep runs can be replayed, the tick length is part of the file.
+struct SimReplay
+{
+	static constexpr uint32_t kMagic = 0x5244474F; // "OGDR"
+	static constexpr uint16_t kVersion = 1;
+	static constexpr int kCheckpointInterval = SimWorld::kTickRate;
+
+	int32_t _levelID = 0;
+	uint64_t _levelHash = 0; // SimLevel::_hash
+	uint16_t _tickRate = SimWorld::kTickRate;
+
+	// SimWorld::resetAt x the inputs play from, and the tick the recorded attempt started at when
+	// it began from a practice checkpoint. The inputs before _startTick are the ones that got there
+	float _startX = 0.f;
+	uint64_t _startTick = 0;
+	uint64_t _seed = 0; // SimWorld::_seed
+
+	std::vector<SimInput> _inputs;
+	std::vector<uint32_t> _checkpoints; // SimWorld::getStateHash at every kCheckpointInterval ticks after _startTick
+	// getTickHash of every tick after _startTick, so a divergence is found to the tick and not just
+	// to the checkpoint
+	std::vector<uint8_t> _tickHashes;
+
+	uint64_t _ticks = 0;
+	SimVec2 _finalPosition;
+	bool _dead = false;
+
+	// Little endian header, then the inputs as varints of (ticks since the previous one << 2 |
+	// player << 1 | press), the raw checkpoint hashes and the tick hashes. Mostly the tick hashes,
+	// a 30 second run is about 7 KB
+	std::vector<uint8_t> encode() const;
+	bool decode(const uint8_t* data, size_t size);
+
+	bool save(const std::string& path) const;
+	bool load(const std::string& path);
+
+	// SimWorld::getStateHash folded to a byte
+	static uint8_t getTickHash(uint32_t stateHash)
+	{
+		return static_cast<uint8_t>(stateHash ^ stateHash >> 8 ^ stateHash >> 16 ^ stateHash >> 24);
+	}
+};
+
+// Fills a SimReplay while a world plays. The world needs _recordInputs set before its reset.
+class SimReplayRecorder
+{
+  public:
+	// right after SimWorld::reset, resetAt or restoring a checkpoint
+	void begin(const SimWorld& world, int levelID);
+	// after every SimWorld::step
+	void afterStep(const SimWorld& world);
+	// the run so far, the world's inputs are copied in
+	const SimReplay& finish(const SimWorld& world);
+
+  private:
+	SimReplay _replay;
+};
+
+struct SimReplayResult
+{
+	bool _levelMatches = true;
+	bool _diverged = false;
+	// the first tick whose hash didn't match, a tick late once in 256 divergences as the tick hashes
+	// are a byte. The first checkpoint that didn't match for replays without them, the last tick if
+	// only the end differs
+	uint64_t _divergenceTick = 0;
+	uint64_t _ticks = 0;
+	SimVec2 _finalPosition;
+	bool _dead = false;
+};
+
+// plays the replay on a new world and compares it with what was recorded
+SimReplayResult verifyReplay(const SimReplay& replay, std::shared_ptr<const SimLevel> level);
@@ -0,0 +1,72 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cmath>
+
+// Plain math types for the simulation core. They mirror the bits of ax::Vec2/ax::Rect
+// the physics relies on so results match the scene graph code bit for bit.
+
+struct SimVec2
+{
+	float x = 0.f, y = 0.f;
+
+	SimVec2 operator+(const SimVec2& o) const { return {x + o.x, y + o.y}; }
+	SimVec2 operator-(const SimVec2& o) const { return {x - o.x, y - o.y}; }
+};
+
+struct SimRect
+{
+	float x = 0.f, y = 0.f, width = 0.f, height = 0.f;
+
+	float getMinX() const { return x; }
+	float getMaxX() const { return x + width; }
+	float getMinY() const { return y; }
+	float getMaxY() const { return y + height; }
+
+	bool intersectsRect(const SimRect& rect) const
+	{
+		return !(getMaxX() < rect.getMinX() || rect.getMaxX() < getMinX() || getMaxY() < rect.getMinY() ||
+				 rect.getMaxY() < getMinY());
+	}
+
+	bool intersectsCircle(SimVec2 center, float radius) const
+	{
+		float w = width / 2;
+		float h = height / 2;
+
+		float dx = std::abs(center.x - (x + w));
+		float dy = std::abs(center.y - (y + h));
+
+		if (dx > (radius + w) || dy > (radius + h))
+			return false;
+
+		float circleDistanceX = std::abs(center.x - x - w);
+		float circleDistanceY = std::abs(center.y - y - h);
+
+		if (circleDistanceX <= w)
+			return true;
+		if (circleDistanceY <= h)
+			return true;
+
+		float cornerDistanceSq = powf(circleDistanceX - w, 2) + powf(circleDistanceY - h, 2);
+
+		return cornerDistanceSq <= powf(radius, 2);
+	}
+};
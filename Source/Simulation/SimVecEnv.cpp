@@ -0,0 +1,104 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "SimVecEnv.h"
+
+#include <algorithm>
+#include <cstring>
+
+SimVecEnv::SimVecEnv(int count, unsigned threads, int actionRepeat, uint64_t maxTicks, bool grids)
+	: _count(std::max(count, 1)), _threads(threads), _actionRepeat(std::max(actionRepeat, 1)), _maxTicks(maxTicks)
+{
+	_observations.resize((size_t)_count * getObservationSize());
+	_rewards.resize(_count);
+	_dones.resize(_count);
+	_lastX.resize(_count);
+
+	if (grids)
+	{
+		_grids.assign(_count, SimOccupancyGrid(_gridConfig));
+		_gridCells.resize((size_t)_count * _gridConfig._width * _gridConfig._height);
+	}
+}
+
+void SimVecEnv::reset(uint64_t seed, std::shared_ptr<const SimLevel> level)
+{
+	if (level)
+		_batch = std::make_unique<SimBatch>(std::move(level), _count, _threads);
+	if (!_batch)
+		return;
+
+	_batch->setSeed(seed);
+	_batch->forEach([this](int index) {
+		_batch->reset(index);
+		_lastX[index] = _batch->getWorld(index)._player1._position.x;
+		if (!_grids.empty())
+			_grids[index].rebuild(_batch->getWorld(index), 0);
+		_rewards[index] = 0.f;
+		observe(index);
+	});
+}
+
+void SimVecEnv::step(const uint8_t* actions)
+{
+	if (!_batch)
+		return;
+
+	_batch->forEach([this](int index) {
+		if (!_dones[index])
+			return;
+		_batch->reset(index);
+		_lastX[index] = _batch->getWorld(index)._player1._position.x;
+		if (!_grids.empty())
+			_grids[index].rebuild(_batch->getWorld(index), 0);
+	});
+
+	_batch->step(actions, _actionRepeat);
+
+	_batch->forEach([this](int index) {
+		float x = _batch->getWorld(index)._player1._position.x;
+		_rewards[index] = x - _lastX[index];
+		_lastX[index] = x;
+		observe(index);
+	});
+}
+
+void SimVecEnv::observe(int index)
+{
+	const SimWorld& world = _batch->getWorld(index);
+	const SimPlayer& player = world._player1;
+
+	float* row = _observations.data() + (size_t)index * getObservationSize();
+	row[0] = player._position.x;
+	row[1] = player._position.y;
+	row[2] = (float)player._yVel;
+	row[3] = player._onGround;
+	row[4] = player._isDead;
+	row[5] = (float)player._gamemode;
+	_raycaster.cast(world, 0, row + kStateFloats);
+
+	if (!_grids.empty())
+	{
+		SimOccupancyGrid& grid = _grids[index];
+		grid.update(world, 0);
+		size_t cells = (size_t)grid.getWidth() * grid.getHeight();
+		std::memcpy(_gridCells.data() + index * cells, grid.getCells(), cells);
+	}
+
+	_dones[index] = _batch->isDone(index) || (_maxTicks && world._tick >= _maxTicks);
+}
@@ -0,0 +1,85 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "SimBatch.h"
+#include "SimOccupancyGrid.h"
+#include "SimRaycaster.h"
+
+// A SimBatch behind a reinforcement learning style interface: one action per world in, one
+// observation row, reward and done flag per world out. The output buffers are allocated once
+// and only ever overwritten, so bindings can hand them out as arrays that stay valid for the
+// lifetime of the env, even across level changes.
+class SimVecEnv
+{
+  public:
+	// x, y, y velocity, on ground, dead, gamemode, then the rays of the default SimRaycastConfig
+	static constexpr int kStateFloats = 6;
+
+	// threads as in ThreadPool. Every step runs actionRepeat ticks, an attempt is done when it
+	// dies, completes the level or reaches maxTicks (0 for no limit). grids adds a
+	// SimOccupancyGrid around player 1 of every world to the outputs
+	SimVecEnv(int count, unsigned threads = 0, int actionRepeat = 1, uint64_t maxTicks = 0, bool grids = false);
+
+	int size() const { return _count; }
+	int getObservationSize() const { return kStateFloats + _raycaster.getOutputSize(); }
+	bool hasLevel() const { return _batch != nullptr; }
+
+	// every world starts over with a seed derived from seed. A level replaces the current one,
+	// there has to be one before the first step
+	void reset(uint64_t seed, std::shared_ptr<const SimLevel> level = nullptr);
+
+	// actions[i] non zero holds world i's button. Worlds that were done after the previous step
+	// start over first, their row then shows the new attempt
+	void step(const uint8_t* actions);
+
+	// size() rows of getObservationSize() floats
+	float* getObservations() { return _observations.data(); }
+	// x gained during the last step, in level units
+	float* getRewards() { return _rewards.data(); }
+	uint8_t* getDones() { return _dones.data(); }
+	// size() grids of getGridHeight() rows of getGridWidth() SimCell values, nullptr without grids
+	uint8_t* getGrids() { return _gridCells.empty() ? nullptr : _gridCells.data(); }
+	int getGridWidth() const { return _gridConfig._width; }
+	int getGridHeight() const { return _gridConfig._height; }
+
+	SimBatch* getBatch() { return _batch.get(); }
+
+  private:
+	int _count;
+	unsigned _threads;
+	int _actionRepeat;
+	uint64_t _maxTicks;
+	std::unique_ptr<SimBatch> _batch;
+	SimRaycaster _raycaster;
+	SimGridConfig _gridConfig;
+	std::vector<SimOccupancyGrid> _grids; // scrolled along with their world, rebuilt after a reset
+
+	std::vector<float> _observations;
+	std::vector<float> _rewards;
+	std::vector<uint8_t> _dones;
+	std::vector<uint8_t> _gridCells;
+	std::vector<float> _lastX;
+
+	void observe(int index);
+};
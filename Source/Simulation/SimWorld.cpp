@@ -0,0 +1,708 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "SimWorld.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+constexpr uint8_t kTriggerCrossed = 1 << 2;
+}
+
+SimWorld::SimWorld(std::shared_ptr<const SimLevel> level) : _level(std::move(level))
+{
+	_objectState.resize(_level->_objects.size());
+	_events.reserve(16);
+	_hazards.reserve(64);
+	reset();
+}
+
+void SimWorld::reset()
+{
+	const SimLevelSettings& settings = _level->_settings;
+
+	std::fill(_objectState.begin(), _objectState.end(), 0);
+	_events.clear();
+
+	_cameraYCenter = 0.f;
+	_bottomGroundY = -68.f;
+	_ceilingY = 388.f;
+	_isDualMode = false;
+	_tick = 0;
+	_startX = 0.f;
+	_rng.seed(_seed);
+	_inputs.clear();
+
+	// everything but the debug toggles starts over, a replay recorded after many resets has to play
+	// the same in a freshly constructed world
+	for (SimPlayer* player : {&_player1, &_player2})
+	{
+		bool noclip = player->_noclip, platformer = player->_isPlatformer;
+		*player = SimPlayer();
+		player->_noclip = noclip;
+		player->_isPlatformer = platformer;
+		player->_position = {2, 105};
+		player->_prevPosition = player->_position;
+		player->reset();
+	}
+
+	changeGameMode(-1, 0, settings.gamemode, _player1._position.y);
+	changeGameMode(-1, 1, settings.gamemode, _player1._position.y);
+	_player1.toggleMini(settings.mini);
+	_player2.toggleMini(settings.mini);
+	changePlayerSpeed(settings.speed);
+	_isDualMode = settings.dual;
+}
+
+void SimWorld::resetAt(float x)
+{
+	reset();
+	if (x <= _player1._position.x)
+		return;
+
+	const SimLevel& level = *_level;
+
+	// whatever would have changed the player or run on the way, in the order it would have been met
+	std::vector<uint32_t> passed;
+	for (uint32_t i = 0; i < level._objects.size(); i++)
+	{
+		const SimObject& obj = level._objects[i];
+		if (obj._position.x >= x)
+			continue;
+
+		switch (obj._type)
+		{
+		case kGameObjectTypeInverseGravityPortal:
+		case kGameObjectTypeNormalGravityPortal:
+		case kGameObjectTypeShipPortal:
+		case kGameObjectTypeBallPortal:
+		case kGameObjectTypeUfoPortal:
+		case kGameObjectTypeCubePortal:
+		case kGameObjectTypeModifier:
+		case kGameObjectTypeMiniSizePortal:
+		case kGameObjectTypeRegularSizePortal:
+		case kGameObjectTypeDualPortal:
+		case kGameObjectTypeSoloPortal:
+			passed.push_back(i);
+			break;
+		default:
+			if (obj._isTrigger)
+				passed.push_back(i);
+			break;
+		}
+	}
+	std::stable_sort(passed.begin(), passed.end(), [&level](uint32_t a, uint32_t b) {
+		return level._objects[a]._position.x < level._objects[b]._position.x;
+	});
+
+	float y = _player1._position.y;
+	for (uint32_t index : passed)
+	{
+		const SimObject& obj = level._objects[index];
+
+		if (obj._isTrigger)
+		{
+			_objectState[index] |= kTriggerCrossed;
+			pushEvent(kSimEventTriggerCrossed, 0, index);
+			continue;
+		}
+
+		// player 2 only meets them while it's playing too
+		int players = _isDualMode ? 2 : 1;
+		switch (obj._type)
+		{
+		case kGameObjectTypeInverseGravityPortal:
+		case kGameObjectTypeNormalGravityPortal:
+			for (int p = 0; p < players; p++)
+				activateObject(index, p);
+			changeGravity(obj._type == kGameObjectTypeInverseGravityPortal);
+			break;
+		case kGameObjectTypeShipPortal:
+			for (int p = 0; p < players; p++)
+				changeGameMode(index, p, PlayerGamemodeShip, obj._position.y);
+			y = obj._position.y;
+			break;
+		case kGameObjectTypeBallPortal:
+			for (int p = 0; p < players; p++)
+				changeGameMode(index, p, PlayerGamemodeBall, obj._position.y);
+			y = obj._position.y;
+			break;
+		case kGameObjectTypeUfoPortal:
+			for (int p = 0; p < players; p++)
+				changeGameMode(index, p, PlayerGamemodeUFO, obj._position.y);
+			y = obj._position.y;
+			break;
+		case kGameObjectTypeCubePortal:
+			for (int p = 0; p < players; p++)
+				changeGameMode(index, p, PlayerGamemodeCube, obj._position.y);
+			y = obj._position.y;
+			break;
+		case kGameObjectTypeModifier:
+			switch (obj._id)
+			{
+			case 201:
+				changePlayerSpeed(0);
+				break;
+			case 200:
+				changePlayerSpeed(1);
+				break;
+			case 202:
+				changePlayerSpeed(2);
+				break;
+			case 203:
+				changePlayerSpeed(3);
+				break;
+			case 1334:
+				changePlayerSpeed(4);
+				break;
+			}
+			break;
+		case kGameObjectTypeMiniSizePortal:
+		case kGameObjectTypeRegularSizePortal:
+			for (int p = 0; p < players; p++)
+			{
+				activateObject(index, p);
+				getPlayer(p).toggleMini(obj._type == kGameObjectTypeMiniSizePortal);
+			}
+			break;
+		// player 2 joins as player 1 is at the portal, upside down
+		case kGameObjectTypeDualPortal:
+			activateObject(index, 0);
+			if (!_isDualMode)
+			{
+				_isDualMode = true;
+				_player2.setGamemode(_player1._gamemode);
+				_player2.toggleMini(_player1._mini);
+				_player2.flipGravity(!_player1._gravityFlipped);
+			}
+			break;
+		case kGameObjectTypeSoloPortal:
+			for (int p = 0; p < players; p++)
+				activateObject(index, p);
+			_isDualMode = false;
+			break;
+		default:
+			break;
+		}
+	}
+
+	_startX = x;
+
+	// a spot inside a block or right above a spike ends the attempt on its first ticks. Try the
+	// height from the portals, then the tops of the blocks around x, a few blocks back and ahead,
+	// and keep the first one that lives through a quarter second without input
+	const SimPlayer player1 = _player1, player2 = _player2;
+	auto place = [&](float px, float py) {
+		_player1 = player1;
+		_player2 = player2;
+		for (SimPlayer* player : {&_player1, &_player2})
+		{
+			player->_position = {px, py};
+			player->_prevPosition = player->_position;
+			player->_lastGroundPos = player->_position;
+			player->updateBounds();
+		}
+	};
+
+	std::vector<float> heights;
+	for (float dx : {0.f, -30.f, 30.f, -60.f, 60.f, -90.f, 90.f})
+	{
+		float px = x + dx;
+		heights.assign(1, y);
+
+		int section = SimLevel::sectionForPos(px);
+		for (int i = std::max(section - 1, 0); i <= section + 1 && i < level.getSectionCount(); i++)
+		{
+			for (uint32_t j = level._sectionStart[i]; j < level._sectionStart[i + 1]; j++)
+			{
+				const SimObject& obj = level._objects[level._sectionObjects[j]];
+				if (obj._type == kGameObjectTypeSolid && obj._outerBounds.getMinX() <= px + 15.f &&
+					obj._outerBounds.getMaxX() >= px - 15.f)
+					heights.push_back(obj._outerBounds.getMaxY() + 15.f);
+			}
+		}
+
+		for (float py : heights)
+		{
+			place(px, py);
+
+			SimWorld trial = *this;
+			bool alive = true;
+			for (int tick = 0; tick < kTickRate / 4 && alive; tick++)
+			{
+				trial.step(kTickStep);
+				alive = !trial._player1._isDead;
+			}
+			if (alive)
+				return;
+		}
+	}
+
+	// nowhere safe nearby, start where asked
+	place(x, y);
+}
+
+void SimWorld::saveSnapshot(SimSnapshot& snapshot) const
+{
+	snapshot._player1 = _player1;
+	snapshot._player2 = _player2;
+	snapshot._objectState = _objectState;
+	snapshot._cameraYCenter = _cameraYCenter;
+	snapshot._bottomGroundY = _bottomGroundY;
+	snapshot._ceilingY = _ceilingY;
+	snapshot._isDualMode = _isDualMode;
+	snapshot._tick = _tick;
+	snapshot._startX = _startX;
+	snapshot._seed = _seed;
+	snapshot._rng = _rng;
+	snapshot._inputs = _inputs;
+}
+
+void SimWorld::restoreSnapshot(const SimSnapshot& snapshot)
+{
+	_player1 = snapshot._player1;
+	_player2 = snapshot._player2;
+	_objectState = snapshot._objectState;
+	_cameraYCenter = snapshot._cameraYCenter;
+	_bottomGroundY = snapshot._bottomGroundY;
+	_ceilingY = snapshot._ceilingY;
+	_isDualMode = snapshot._isDualMode;
+	_tick = snapshot._tick;
+	_startX = snapshot._startX;
+	_seed = snapshot._seed;
+	_rng = snapshot._rng;
+	_inputs = snapshot._inputs;
+	_events.clear();
+}
+
+void SimWorld::step(float dt)
+{
+	_events.clear();
+	_player1._events = 0;
+	_player2._events = 0;
+	_tick++;
+
+	_player1.update(dt);
+	if (!_player1._isDead)
+	{
+		_player1.updateBounds();
+		checkCollisions(0);
+	}
+
+	if (_player1._isDead || !_isDualMode)
+		return;
+
+	_player2.update(dt);
+	if (!_player2._isDead)
+	{
+		_player2.updateBounds();
+		checkCollisions(1);
+	}
+}
+
+float SimWorld::getCameraY() const
+{
+	float camY = (kViewHeight * -0.5f) + _cameraYCenter;
+	if (camY <= 0.0f)
+		camY = 0.0f;
+	return std::clamp(camY, 0.0f, 1140.f - kViewHeight);
+}
+
+float SimWorld::getFloorY(int player) const
+{
+	if ((player == 0 ? _player1 : _player2)._gamemode == PlayerGamemodeCube)
+		return 105.f;
+	return _bottomGroundY + getCameraY() + 93.f;
+}
+
+float SimWorld::getCeilingY(int player) const
+{
+	if ((player == 0 ? _player1 : _player2)._gamemode == PlayerGamemodeCube)
+		return std::numeric_limits<float>::infinity();
+	return _ceilingY - 222.f + _cameraYCenter;
+}
+
+float SimWorld::getPercentage() const
+{
+	return _player1._position.x / _level->_lastObjXPos * 100.f;
+}
+
+uint32_t SimWorld::getStateHash() const
+{
+	uint32_t hash = 2166136261u;
+	auto mix = [&hash](const void* data, size_t size) {
+		auto bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= bytes[i];
+			hash *= 16777619u;
+		}
+	};
+
+	mix(&_tick, sizeof(_tick));
+	for (const SimPlayer* player : {&_player1, &_player2})
+	{
+		// field by field, the struct has padding
+		mix(&player->_position, sizeof(player->_position));
+		mix(&player->_yVel, sizeof(player->_yVel));
+		mix(&player->_xVel, sizeof(player->_xVel));
+		mix(&player->_gamemode, sizeof(player->_gamemode));
+		mix(&player->_onGround, sizeof(player->_onGround));
+		mix(&player->_isDead, sizeof(player->_isDead));
+		mix(&player->_gravityFlipped, sizeof(player->_gravityFlipped));
+		mix(&player->_isHolding, sizeof(player->_isHolding));
+	}
+	return hash;
+}
+
+void SimWorld::pushButton(int player)
+{
+	if (_recordInputs)
+		_inputs.push_back({_tick, static_cast<uint8_t>(player), true});
+	getPlayer(player).pushButton();
+}
+
+void SimWorld::releaseButton(int player)
+{
+	if (_recordInputs)
+		_inputs.push_back({_tick, static_cast<uint8_t>(player), false});
+	getPlayer(player).releaseButton();
+}
+
+void SimWorld::activateObject(int object, int player)
+{
+	_objectState[object] |= 1 << player;
+	pushEvent(kSimEventObjectActivated, player, object);
+}
+
+void SimWorld::destroyPlayer(int player, int object)
+{
+	SimPlayer& p = getPlayer(player);
+	if (p._isDead || p._noclip)
+		return;
+
+	p._isDead = true;
+	pushEvent(kSimEventPlayerDied, player, object);
+}
+
+void SimWorld::changeGameMode(int object, int player, PlayerGamemode gameMode, float portalY)
+{
+	if (object >= 0)
+		activateObject(object, player);
+
+	switch (gameMode)
+	{
+	case PlayerGamemodeShip:
+	case PlayerGamemodeUFO:
+	case PlayerGamemodeWave:
+		if (portalY < 270)
+			_cameraYCenter = 240.0f;
+		else
+			_cameraYCenter = (floorf(portalY / 30.0f) * 30.0f);
+
+		_bottomGroundY = -68;
+		_ceilingY = 388;
+		break;
+	case PlayerGamemodeBall:
+		if (portalY < 240.0f)
+			_cameraYCenter = 210.0f;
+		else
+			_cameraYCenter = (floorf(portalY / 30.0f) * 30.0f);
+
+		_bottomGroundY = -38;
+		_ceilingY = 358;
+		break;
+	default:
+		break;
+	}
+
+	getPlayer(player).setGamemode(gameMode);
+	pushEvent(kSimEventGamemodeChanged, player, object);
+}
+
+void SimWorld::changePlayerSpeed(int speed)
+{
+	double xVel;
+	float playerSpeed;
+
+	switch (speed)
+	{
+	case 0:
+		xVel = 5.77;
+		playerSpeed = 0.9;
+		break;
+	case 1:
+		xVel = 5.98;
+		playerSpeed = 0.7;
+		break;
+	case 2:
+		xVel = 5.87;
+		playerSpeed = 1.1;
+		break;
+	case 3:
+		xVel = 6;
+		playerSpeed = 1.3;
+		break;
+	case 4:
+		xVel = 6;
+		playerSpeed = 1.6;
+		break;
+	default:
+		return;
+	}
+
+	for (SimPlayer* player : {&_player1, &_player2})
+	{
+		player->_xVel = xVel;
+		player->_playerSpeed = playerSpeed;
+	}
+}
+
+void SimWorld::changeGravity(bool gravityFlipped)
+{
+	_player1.flipGravity(gravityFlipped);
+	if (_isDualMode)
+		_player2.flipGravity(!gravityFlipped);
+}
+
+void SimWorld::checkCollisions(int playerIndex)
+{
+	SimPlayer& player = getPlayer(playerIndex);
+
+	SimRect playerOuterBounds = player.getCollisionBounds();
+	if (player._position.y < (player._mini ? 99.f : 105.0f) && player._gamemode == PlayerGamemodeCube)
+	{
+		if (player._gravityFlipped)
+		{
+			destroyPlayer(playerIndex, -1);
+			return;
+		}
+
+		player._position.y = player._mini ? 99.f : 105.0f;
+
+		player.hitGround(false);
+	}
+	else if (player._position.y > 1290.0f)
+	{
+		destroyPlayer(playerIndex, -1);
+		return;
+	}
+
+	if (player._gamemode != PlayerGamemodeCube)
+	{
+		float floorY = _bottomGroundY + getCameraY() + (player._mini ? 87.f : 93.0f);
+		float ceilingY = _ceilingY - (player._mini ? 234.f : 240.f) + _cameraYCenter - 12.f;
+
+		if (player._position.y < floorY)
+		{
+			player._position.y = floorY;
+
+			if (!player._gravityFlipped)
+				player.hitGround(false);
+
+			player._yVel = 0.f;
+		}
+		if (player._position.y > ceilingY)
+		{
+			player._position.y = ceilingY;
+
+			if (player._gravityFlipped)
+				player.hitGround(true);
+
+			player._yVel = 0.f;
+		}
+	}
+
+	const SimLevel& level = *_level;
+	int currentSection = SimLevel::sectionForPos(player._position.x);
+
+	_hazards.clear();
+
+	for (int i = currentSection - 2; i < currentSection + 1; i++)
+	{
+		if (i < 0 || i >= level.getSectionCount())
+			continue;
+
+		for (uint32_t j = level._sectionStart[i]; j < level._sectionStart[i + 1]; j++)
+		{
+			int index = level._sectionObjects[j];
+			const SimObject& obj = level._objects[index];
+
+			if (obj._type == kGameObjectTypeHazard)
+			{
+				_hazards.push_back(index);
+				continue;
+			}
+
+			if (obj._isTrigger)
+			{
+				if (!(_objectState[index] & kTriggerCrossed) && obj._position.x <= player._position.x)
+				{
+					_objectState[index] |= kTriggerCrossed;
+					pushEvent(kSimEventTriggerCrossed, playerIndex, index);
+				}
+				continue;
+			}
+
+			if (!playerOuterBounds.intersectsRect(obj._outerBounds) || hasBeenActivatedByPlayer(index, playerIndex))
+				continue;
+
+			switch (obj._type)
+			{
+			case kGameObjectTypeInverseGravityPortal:
+				activateObject(index, playerIndex);
+				pushEvent(kSimEventObjectTouched, playerIndex, index);
+				changeGravity(true);
+				break;
+
+			case kGameObjectTypeNormalGravityPortal:
+				activateObject(index, playerIndex);
+				pushEvent(kSimEventObjectTouched, playerIndex, index);
+				changeGravity(false);
+				break;
+
+			case kGameObjectTypeShipPortal:
+				pushEvent(kSimEventObjectTouched, playerIndex, index);
+				changeGameMode(index, playerIndex, PlayerGamemodeShip, obj._position.y);
+				break;
+
+			case kGameObjectTypeBallPortal:
+				pushEvent(kSimEventObjectTouched, playerIndex, index);
+				changeGameMode(index, playerIndex, PlayerGamemodeBall, obj._position.y);
+				break;
+
+			case kGameObjectTypeUfoPortal:
+				pushEvent(kSimEventObjectTouched, playerIndex, index);
+				changeGameMode(index, playerIndex, PlayerGamemodeUFO, obj._position.y);
+				break;
+
+			case kGameObjectTypeCubePortal:
+				pushEvent(kSimEventObjectTouched, playerIndex, index);
+				changeGameMode(index, playerIndex, PlayerGamemodeCube, obj._position.y);
+				break;
+
+			case kGameObjectTypeYellowJumpPad:
+				pushEvent(kSimEventObjectTouched, playerIndex, index);
+				activateObject(index, playerIndex);
+				player.propellPlayer(1);
+				player._touchedPadObject = index;
+				break;
+
+			case kGameObjectTypeGravityPad:
+				if (player._touchedPadObject >= 0)
+					break;
+				pushEvent(kSimEventObjectTouched, playerIndex, index);
+				activateObject(index, playerIndex);
+				player.propellPlayer(0.8);
+				player._touchedPadObject = index;
+				changeGravity(!player._gravityFlipped);
+				break;
+
+			case kGameObjectTypePinkJumpPad:
+				pushEvent(kSimEventObjectTouched, playerIndex, index);
+				activateObject(index, playerIndex);
+				player.propellPlayer(0.65);
+				player._touchedPadObject = index;
+				break;
+
+			case kGameObjectTypeRedJumpPad:
+				pushEvent(kSimEventObjectTouched, playerIndex, index);
+				activateObject(index, playerIndex);
+				player.propellPlayer(1.25);
+				player._touchedPadObject = index;
+				break;
+
+			case kGameObjectTypeYellowJumpRing:
+			case kGameObjectTypeDashRing:
+			case kGameObjectTypeGravityRing:
+			case kGameObjectTypeRedJumpRing:
+			case kGameObjectTypePinkJumpRing:
+			case kGameObjectTypeDropRing:
+			case kGameObjectTypeGreenRing:
+				pushEvent(kSimEventObjectTouched, playerIndex, index);
+				player._touchedRingObject = index;
+				if (player.ringJump(obj._type))
+					activateObject(index, playerIndex);
+				break;
+
+			case kGameObjectTypeModifier:
+				switch (obj._id)
+				{
+				case 201:
+					changePlayerSpeed(0);
+					break;
+				case 200:
+					changePlayerSpeed(1);
+					break;
+				case 202:
+					changePlayerSpeed(2);
+					break;
+				case 203:
+					changePlayerSpeed(3);
+					break;
+				case 1334:
+					changePlayerSpeed(4);
+					break;
+				}
+				break;
+
+			case kGameObjectTypeSpecial:
+			case kGameObjectTypeNormalMirrorPortal:
+			case kGameObjectTypeInverseMirrorPortal:
+				break;
+
+			case kGameObjectTypeMiniSizePortal:
+				activateObject(index, playerIndex);
+				pushEvent(kSimEventObjectTouched, playerIndex, index);
+				player.toggleMini(true);
+				break;
+
+			case kGameObjectTypeRegularSizePortal:
+				activateObject(index, playerIndex);
+				pushEvent(kSimEventObjectTouched, playerIndex, index);
+				player.toggleMini(false);
+				break;
+
+			default:
+				if (player.collidedWithObject(obj._outerBounds, obj._isTrigger))
+					destroyPlayer(playerIndex, index);
+				break;
+			}
+		}
+	}
+
+	for (uint32_t index : _hazards)
+	{
+		const SimObject& hazard = level._objects[index];
+		if (hazard._radius > 0)
+		{
+			if (playerOuterBounds.intersectsCircle(hazard._position + SimVec2{15, 15}, hazard._radius))
+				destroyPlayer(playerIndex, index);
+		}
+		else if (playerOuterBounds.intersectsRect(hazard._outerBounds))
+		{
+			destroyPlayer(playerIndex, index);
+		}
+	}
+
+	if (player._gamemode == PlayerGamemodeShip)
+		player._queuedHold = false;
+}
@@ -0,0 +1,164 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "GameToolbox/rng.h"
+#include "SimLevel.h"
+#include "SimPlayer.h"
+
+enum SimEventType
+{
+	kSimEventObjectTouched,	  // player touched a portal, pad or ring
+	kSimEventObjectActivated, // the object is used up for this player until the next reset
+	kSimEventGamemodeChanged,
+	kSimEventTriggerCrossed,
+	kSimEventPlayerDied, // object is the killer, -1 for the ground, ceiling or falling out of the level
+};
+
+struct SimEvent
+{
+	SimEventType _type;
+	int _player; // 0 or 1
+	int _object; // index into SimLevel::_objects, -1 if none
+};
+
+// a pushButton or releaseButton, applied while SimWorld::_tick was _tick, before that step
+struct SimInput
+{
+	uint64_t _tick;
+	uint8_t _player;
+	bool _press;
+};
+
+// Everything a SimWorld changes while it runs. Restoring one puts the world back exactly where it
+// was when it was saved, so a rewind costs two players and one byte per object. Practice
+// checkpoints are snapshots too, they keep the inputs that led there so replays still work.
+struct SimSnapshot
+{
+	SimPlayer _player1, _player2;
+	std::vector<uint8_t> _objectState;
+	float _cameraYCenter = 0.f;
+	float _bottomGroundY = -68.f;
+	float _ceilingY = 388.f;
+	bool _isDualMode = false;
+	uint64_t _tick = 0;
+	float _startX = 0.f;
+	uint64_t _seed = 0;
+	GameToolbox::Rng _rng;
+	std::vector<SimInput> _inputs;
+};
+
+// One run through a SimLevel: both players, per object activation state and the level-wide
+// values PlayLayer used to keep on its nodes (camera center, ground and ceiling heights).
+// It never touches axmol so any number of worlds can be stepped without a scene.
+class SimWorld
+{
+  public:
+	// design resolution height, the physics floor in non cube modes is relative to the camera
+	static constexpr float kViewHeight = 320.0f;
+
+	// fixed timestep mode: 240 ticks a second, each one exactly a quarter of a 60 fps frame
+	static constexpr int kTickRate = 240;
+	static constexpr float kTickStep = 60.0f / kTickRate;
+
+	std::shared_ptr<const SimLevel> _level;
+
+	SimPlayer _player1, _player2;
+
+	// bit 0 = activated by player 1, bit 1 = player 2, bit 2 = trigger already crossed
+	std::vector<uint8_t> _objectState;
+
+	// what happened during the last step, in order
+	std::vector<SimEvent> _events;
+
+	float _cameraYCenter = 0.f;
+	float _bottomGroundY = -68.f;
+	float _ceilingY = 388.f;
+
+	bool _isDualMode = false;
+
+	// steps since the last reset
+	uint64_t _tick = 0;
+
+	// where the last reset put player 1, 0 for the level start, see resetAt
+	float _startX = 0.f;
+
+	// every random number the simulation draws comes from _rng, which reset() seeds with _seed.
+	// Each world owns its own so parallel worlds never share one, and the same seed and inputs
+	// always give the same attempt. SimReplay records the seed
+	uint64_t _seed = 0;
+	GameToolbox::Rng _rng;
+
+	// with _recordInputs set every button change since the last reset is kept in _inputs,
+	// that and the level are all a SimReplay needs
+	bool _recordInputs = false;
+	std::vector<SimInput> _inputs;
+
+	explicit SimWorld(std::shared_ptr<const SimLevel> level);
+
+	// back to the start of the level using its settings
+	void reset();
+	// a reset that starts player 1 at x instead, as if it had played there: every portal, speed
+	// change and size change before x is applied in order and the triggers are marked crossed,
+	// all of it showing up in _events. The height comes from the last gamemode portal passed, a
+	// cube without one starts on the ground. If that dies straight away the player is moved onto
+	// a block or up to three blocks along instead, the same x always gives the same start
+	void resetAt(float x);
+
+	// reuses the snapshot's buffer, saving every tick into the same one doesn't allocate
+	void saveSnapshot(SimSnapshot& snapshot) const;
+	// the snapshot has to come from a world playing the same SimLevel
+	void restoreSnapshot(const SimSnapshot& snapshot);
+
+	// one physics substep, dt is in 60 fps frames like PlayerObject::update used to get
+	void step(float dt);
+
+	SimPlayer& getPlayer(int index) { return index == 0 ? _player1 : _player2; }
+	float getCameraY() const;
+	float getPercentage() const;
+
+	// 32 bit hash of both players' physics state and the tick, two worlds that played the same
+	// inputs the same way hash the same
+	uint32_t getStateHash() const;
+
+	// heights where the player's box touches the floor and roof in checkCollisions, the roof is
+	// infinitely high in cube mode
+	float getFloorY(int player) const;
+	float getCeilingY(int player) const;
+
+	void pushButton(int player);
+	void releaseButton(int player);
+
+	void changeGameMode(int object, int player, PlayerGamemode gameMode, float portalY);
+	void changePlayerSpeed(int speed);
+	void changeGravity(bool gravityFlipped);
+	void destroyPlayer(int player, int object);
+
+  private:
+	std::vector<uint32_t> _hazards;
+
+	void checkCollisions(int player);
+	bool hasBeenActivatedByPlayer(int object, int player) const { return _objectState[object] & (1 << player); }
+	void activateObject(int object, int player);
+	void pushEvent(SimEventType type, int player, int object) { _events.push_back({type, player, object}); }
+};
@@ -0,0 +1,109 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned threads)
+{
+	if (threads == 0)
+		threads = std::max(1u, std::thread::hardware_concurrency());
+
+	for (unsigned i = 1; i < threads; i++)
+		_workers.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard lock(_mutex);
+		_stop = true;
+	}
+	_wake.notify_all();
+
+	for (auto& worker : _workers)
+		worker.join();
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& fn)
+{
+	if (count == 0)
+		return;
+
+	if (_workers.empty() || count == 1)
+	{
+		for (size_t i = 0; i < count; i++)
+			fn(i);
+		return;
+	}
+
+	{
+		std::lock_guard lock(_mutex);
+		_job = &fn;
+		_count = count;
+		// a few chunks per thread so a slow one doesn't hold everyone up
+		_chunk = std::max<size_t>(1, count / (getThreadCount() * 4));
+		_next.store(0, std::memory_order_relaxed);
+		_busy = (unsigned)_workers.size();
+		_generation++;
+	}
+	_wake.notify_all();
+
+	runChunks();
+
+	std::unique_lock lock(_mutex);
+	_finished.wait(lock, [this] { return _busy == 0; });
+	_job = nullptr;
+}
+
+void ThreadPool::workerLoop()
+{
+	uint64_t seen = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock lock(_mutex);
+			_wake.wait(lock, [&] { return _stop || _generation != seen; });
+			if (_stop)
+				return;
+			seen = _generation;
+		}
+
+		runChunks();
+
+		std::lock_guard lock(_mutex);
+		if (--_busy == 0)
+			_finished.notify_one();
+	}
+}
+
+void ThreadPool::runChunks()
+{
+	while (true)
+	{
+		size_t begin = _next.fetch_add(_chunk, std::memory_order_relaxed);
+		if (begin >= _count)
+			return;
+
+		size_t end = std::min(begin + _chunk, _count);
+		for (size_t i = begin; i < end; i++)
+			(*_job)(i);
+	}
+}
@@ -0,0 +1,64 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for splitting one loop across cores. Not reentrant:
+// parallelFor must not be called from inside a job or from two threads at once.
+class ThreadPool
+{
+  public:
+	// threads counts the calling thread too, 0 means one per hardware thread
+	explicit ThreadPool(unsigned threads = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	unsigned getThreadCount() const { return (unsigned)_workers.size() + 1; }
+
+	// runs fn(i) for every i in [0, count) and returns once all of them are done,
+	// the calling thread takes chunks as well
+	void parallelFor(size_t count, const std::function<void(size_t)>& fn);
+
+  private:
+	std::vector<std::thread> _workers;
+
+	std::mutex _mutex;
+	std::condition_variable _wake, _finished;
+	uint64_t _generation = 0; // bumped for every job, workers wait for it to change
+	unsigned _busy = 0;		  // workers that haven't finished the current job yet
+	bool _stop = false;
+
+	const std::function<void(size_t)>* _job = nullptr;
+	size_t _count = 0;
+	size_t _chunk = 1;
+	std::atomic<size_t> _next = 0;
+
+	void workerLoop();
+	void runChunks();
+};
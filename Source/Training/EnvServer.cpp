@@ -0,0 +1,565 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "EnvServer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "LevelCache.h"
+#include "ShmRing.h"
+#include "GameToolbox/log.h"
+#include "Simulation/SimLevel.h"
+#include "Simulation/SimVecEnv.h"
+
+#ifndef _WIN32
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifndef _WIN32
+
+namespace
+{
+// a reset asking for more worlds than this is refused, the segment would get silly
+constexpr uint32_t kMaxCount = 1 << 16;
+constexpr uint32_t kMaxMessageSize = kMaxCount + 64;
+
+std::atomic<bool> s_stop = false;
+
+void onStopSignal(int)
+{
+	s_stop.store(true);
+}
+
+struct Connection
+{
+	int _fd = -1;
+	int _id = 0;
+	bool _closed = false;
+	// a worker is serving a request, only it touches the connection until it's handed back
+	bool _busy = false;
+
+	std::unique_ptr<SimVecEnv> _env;
+	std::shared_ptr<const SimLevel> _level;
+	uint32_t _actionRepeat = 1;
+	uint64_t _maxTicks = 0;
+
+	ShmSegment _shm;
+	// the socket is nonblocking, bytes received that don't make a whole request yet wait here
+	std::vector<uint8_t> _input;
+	std::vector<uint8_t> _reply;
+	size_t _replySent = 0;
+
+	bool isReplying() const { return _replySent < _reply.size(); }
+
+	// size of the whole request at the front of _input, 0 while it's still arriving
+	uint32_t pendingRequest()
+	{
+		uint32_t size;
+		if (_closed || _input.size() < sizeof(size))
+			return 0;
+		std::memcpy(&size, _input.data(), sizeof(size));
+		if (size == 0 || size > kMaxMessageSize)
+		{
+			_closed = true;
+			return 0;
+		}
+		return _input.size() - sizeof(size) >= size ? size : 0;
+	}
+
+	// everything the socket has for now
+	void receive()
+	{
+		uint8_t buffer[64 * 1024];
+		while (true)
+		{
+			ssize_t got = recv(_fd, buffer, sizeof(buffer), 0);
+			if (got > 0)
+			{
+				_input.insert(_input.end(), buffer, buffer + got);
+				continue;
+			}
+			if (got < 0 && errno == EINTR)
+				continue;
+			if (got == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+				_closed = true;
+			return;
+		}
+	}
+
+	// as much of the reply as the socket takes, poll asks for POLLOUT while some is left
+	void send()
+	{
+		while (isReplying())
+		{
+			ssize_t sent = ::send(_fd, _reply.data() + _replySent, _reply.size() - _replySent, MSG_NOSIGNAL);
+			if (sent > 0)
+			{
+				_replySent += sent;
+				continue;
+			}
+			if (sent < 0 && errno == EINTR)
+				continue;
+			if (sent == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+				_closed = true;
+			return;
+		}
+	}
+};
+
+template <typename T> void put(std::vector<uint8_t>& out, T value)
+{
+	size_t at = out.size();
+	out.resize(at + sizeof(T));
+	std::memcpy(out.data() + at, &value, sizeof(T));
+}
+
+template <typename T> bool get(const uint8_t*& data, const uint8_t* end, T& value)
+{
+	if (end - data < (ptrdiff_t)sizeof(T))
+		return false;
+	std::memcpy(&value, data, sizeof(T));
+	data += sizeof(T);
+	return true;
+}
+
+class EnvServerState
+{
+  public:
+	EnvServerState(std::shared_ptr<const SimLevel> level, int levelID) : _level(std::move(level)), _levelID(levelID) {}
+
+	// answers the whole request at the front of the connection's input, the reply is left for send
+	void serve(Connection& connection, uint32_t size)
+	{
+		connection._reply.clear();
+		connection._replySent = 0;
+		put<uint32_t>(connection._reply, 0);
+		put<uint8_t>(connection._reply, 0);
+
+		const uint8_t* request = connection._input.data() + sizeof(uint32_t);
+		const uint8_t* data = request + 1;
+		const uint8_t* end = request + size;
+
+		const char* error = nullptr;
+		switch (request[0])
+		{
+		case kEnvRequestReset:
+			error = reset(connection, data, end);
+			break;
+		case kEnvRequestStep:
+			error = step(connection, data, end, true);
+			break;
+		case kEnvRequestBatchStep:
+			error = step(connection, data, end, false);
+			break;
+		case kEnvRequestClose:
+			connection._closed = true;
+			break;
+		default:
+			error = "unknown request";
+			break;
+		}
+
+		if (error)
+		{
+			connection._reply.resize(sizeof(uint32_t));
+			put<uint8_t>(connection._reply, 1);
+			connection._reply.insert(connection._reply.end(), error, error + std::strlen(error));
+		}
+
+		uint32_t replySize = static_cast<uint32_t>(connection._reply.size() - sizeof(uint32_t));
+		std::memcpy(connection._reply.data(), &replySize, sizeof(replySize));
+		connection._input.erase(connection._input.begin(), connection._input.begin() + sizeof(uint32_t) + size);
+	}
+
+  private:
+	std::shared_ptr<const SimLevel> _level;
+	int _levelID;
+
+	const char* reset(Connection& connection, const uint8_t* data, const uint8_t* end)
+	{
+		uint64_t seed, maxTicks;
+		int32_t levelID;
+		uint32_t count, actionRepeat;
+		if (!get(data, end, seed) || !get(data, end, levelID) || !get(data, end, count) ||
+			!get(data, end, actionRepeat) || !get(data, end, maxTicks))
+			return "malformed reset";
+		if (count == 0 || count > kMaxCount)
+			return "count out of range";
+		actionRepeat = std::max(actionRepeat, 1u);
+
+		auto level = levelID == 0 || levelID == _levelID ? _level : LevelCache::getInstance()->getSimLevel(levelID);
+		if (!level)
+			return "level not found";
+
+		// every world of a connection steps on the worker serving it
+		auto& env = connection._env;
+		if (!env || static_cast<uint32_t>(env->size()) != count || connection._actionRepeat != actionRepeat ||
+			connection._maxTicks != maxTicks)
+		{
+			env = std::make_unique<SimVecEnv>(count, 1, actionRepeat, maxTicks);
+			connection._level = nullptr;
+			connection._actionRepeat = actionRepeat;
+			connection._maxTicks = maxTicks;
+		}
+
+		size_t segmentSize = sizeof(EnvShmHeader) + count * (env->getObservationSize() * sizeof(float) + sizeof(float) + 1);
+		std::string name = fmt::format("/opengd-env-{}-{}", getpid(), connection._id);
+		if (connection._shm.size() < segmentSize && !connection._shm.create(name, segmentSize))
+		{
+			env = nullptr;
+			return "could not create the shared memory segment";
+		}
+
+		env->reset(seed, connection._level == level ? nullptr : level);
+		connection._level = std::move(level);
+
+		auto header = static_cast<EnvShmHeader*>(connection._shm.data());
+		*header = {};
+		header->_magic = EnvShmHeader::kMagic;
+		header->_version = EnvShmHeader::kVersion;
+		header->_count = count;
+		header->_observationSize = env->getObservationSize();
+		publish(connection);
+		header->_steps = 0;
+
+		put<uint32_t>(connection._reply, count);
+		put<uint32_t>(connection._reply, env->getObservationSize());
+		connection._reply.insert(connection._reply.end(), name.begin(), name.end());
+		return nullptr;
+	}
+
+	const char* step(Connection& connection, const uint8_t* data, const uint8_t* end, bool single)
+	{
+		auto& env = connection._env;
+		if (!env)
+			return "reset before stepping";
+		if (single && env->size() != 1)
+			return "step is for a single world, use batch step";
+		if (end - data != env->size())
+			return "expected one action per world";
+
+		env->step(data);
+		publish(connection);
+
+		if (single)
+		{
+			put<float>(connection._reply, env->getRewards()[0]);
+			put<uint8_t>(connection._reply, env->getDones()[0]);
+		}
+		return nullptr;
+	}
+
+	// the env's own buffers to the segment, a few kilobytes next to the ticks that made them
+	static void publish(Connection& connection)
+	{
+		SimVecEnv& env = *connection._env;
+		auto header = static_cast<EnvShmHeader*>(connection._shm.data());
+		auto out = reinterpret_cast<uint8_t*>(header + 1);
+
+		size_t observationBytes = (size_t)env.size() * env.getObservationSize() * sizeof(float);
+		std::memcpy(out, env.getObservations(), observationBytes);
+		out += observationBytes;
+		std::memcpy(out, env.getRewards(), env.size() * sizeof(float));
+		out += env.size() * sizeof(float);
+		std::memcpy(out, env.getDones(), env.size());
+
+		header->_steps++;
+	}
+};
+
+// Serves every request on its own, whichever worker is free takes it and hands the connection
+// back as soon as it's answered, so a big batch step only holds up the client that sent it.
+// Handed back connections are announced on a pipe the poll loop waits on
+class RequestWorkers
+{
+  public:
+	// 0 threads means one per hardware thread
+	RequestWorkers(EnvServerState& state, unsigned threads) : _state(state)
+	{
+		if (pipe(_wake) != 0)
+		{
+			_wake[0] = _wake[1] = -1;
+			return;
+		}
+		fcntl(_wake[0], F_SETFL, fcntl(_wake[0], F_GETFL) | O_NONBLOCK);
+		fcntl(_wake[1], F_SETFL, fcntl(_wake[1], F_GETFL) | O_NONBLOCK);
+
+		// the stop signals go to the thread in poll, the workers inherit the blocked mask
+		sigset_t stopSignals, previous;
+		sigemptyset(&stopSignals);
+		sigaddset(&stopSignals, SIGTERM);
+		sigaddset(&stopSignals, SIGINT);
+		pthread_sigmask(SIG_BLOCK, &stopSignals, &previous);
+
+		if (threads == 0)
+			threads = std::max(1u, std::thread::hardware_concurrency());
+		for (unsigned i = 0; i < threads; i++)
+			_workers.emplace_back(&RequestWorkers::workerLoop, this);
+
+		pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+	}
+
+	~RequestWorkers()
+	{
+		stop();
+		if (_wake[0] >= 0)
+		{
+			close(_wake[0]);
+			close(_wake[1]);
+		}
+	}
+
+	// waits for the requests being served, the ones still queued are dropped
+	void stop()
+	{
+		{
+			std::lock_guard lock(_mutex);
+			_stop = true;
+		}
+		_queued.notify_all();
+
+		for (auto& worker : _workers)
+			worker.join();
+		_workers.clear();
+	}
+
+	bool isOpen() const { return _wake[0] >= 0; }
+	int getWakeFd() const { return _wake[0]; }
+	unsigned getThreadCount() const { return static_cast<unsigned>(_workers.size()); }
+
+	// size is the connection's pendingRequest, the connection stays _busy until takeFinished returns it
+	void submit(Connection& connection, uint32_t size)
+	{
+		connection._busy = true;
+		{
+			std::lock_guard lock(_mutex);
+			_queue.push_back({&connection, size});
+		}
+		_queued.notify_one();
+	}
+
+	// connections answered since the last call, no longer busy
+	void takeFinished(std::vector<Connection*>& out)
+	{
+		uint8_t buffer[256];
+		while (read(_wake[0], buffer, sizeof(buffer)) > 0)
+			;
+
+		out.clear();
+		{
+			std::lock_guard lock(_mutex);
+			out.swap(_finished);
+		}
+		for (Connection* connection : out)
+			connection->_busy = false;
+	}
+
+  private:
+	EnvServerState& _state;
+	std::vector<std::thread> _workers;
+	int _wake[2] = {-1, -1};
+
+	std::mutex _mutex;
+	std::condition_variable _queued;
+	std::deque<std::pair<Connection*, uint32_t>> _queue;
+	std::vector<Connection*> _finished;
+	bool _stop = false;
+
+	void workerLoop()
+	{
+		while (true)
+		{
+			std::pair<Connection*, uint32_t> request;
+			{
+				std::unique_lock lock(_mutex);
+				_queued.wait(lock, [&] { return _stop || !_queue.empty(); });
+				if (_stop)
+					return;
+				request = _queue.front();
+				_queue.pop_front();
+			}
+
+			_state.serve(*request.first, request.second);
+
+			{
+				std::lock_guard lock(_mutex);
+				_finished.push_back(request.first);
+			}
+			// a full pipe already has poll's attention
+			uint8_t byte = 0;
+			[[maybe_unused]] auto written = write(_wake[1], &byte, 1);
+		}
+	}
+};
+} // namespace
+
+int EnvServer::run(std::string_view socketPath, int levelID, unsigned threads)
+{
+	auto level = LevelCache::getInstance()->getSimLevel(levelID);
+	if (!level)
+	{
+		GameToolbox::log("EnvServer: level {} not found", levelID);
+		return 1;
+	}
+
+	sockaddr_un address = {};
+	address.sun_family = AF_UNIX;
+	if (socketPath.size() >= sizeof(address.sun_path))
+	{
+		GameToolbox::log("EnvServer: socket path {} is too long", socketPath);
+		return 1;
+	}
+	socketPath.copy(address.sun_path, socketPath.size());
+
+	int server = socket(AF_UNIX, SOCK_STREAM, 0);
+	unlink(address.sun_path);
+	if (server < 0 || bind(server, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+		listen(server, 64) != 0)
+	{
+		GameToolbox::log("EnvServer: could not listen on {}", socketPath);
+		if (server >= 0)
+			close(server);
+		return 1;
+	}
+
+	struct sigaction action = {};
+	action.sa_handler = onStopSignal;
+	sigemptyset(&action.sa_mask);
+	sigaction(SIGTERM, &action, nullptr);
+	sigaction(SIGINT, &action, nullptr);
+
+	EnvServerState state(level, levelID);
+	std::vector<std::unique_ptr<Connection>> connections;
+	std::vector<pollfd> fds;
+	std::vector<Connection*> finished;
+	int nextID = 0;
+
+	RequestWorkers workers(state, threads);
+	if (!workers.isOpen())
+	{
+		GameToolbox::log("EnvServer: could not create the wake pipe");
+		close(server);
+		unlink(address.sun_path);
+		return 1;
+	}
+
+	GameToolbox::log("EnvServer: level {} ({} objects) ready on {} with {} threads", levelID, level->_objects.size(),
+					 socketPath, workers.getThreadCount());
+
+	while (!s_stop.load())
+	{
+		// a connection a worker has isn't polled at all, one with a whole request waiting isn't
+		// read from until it's answered, and one still sending its reply is only polled for the rest
+		fds.clear();
+		fds.push_back({server, POLLIN, 0});
+		fds.push_back({workers.getWakeFd(), POLLIN, 0});
+		for (auto& connection : connections)
+		{
+			short events = 0;
+			if (!connection->_busy)
+				events = connection->isReplying() ? POLLOUT : connection->pendingRequest() ? 0 : POLLIN;
+			fds.push_back({connection->_fd, events, 0});
+		}
+
+		// a signal interrupts poll, the timeout is only a fallback
+		if (poll(fds.data(), fds.size(), 500) < 0)
+			continue;
+
+		for (size_t i = 2; i < fds.size(); i++)
+		{
+			Connection& connection = *connections[i - 2];
+			if (fds[i].revents & POLLOUT)
+				connection.send();
+			else if (fds[i].revents & (POLLIN | POLLHUP | POLLERR))
+				connection.receive();
+		}
+
+		// replies go out as soon as their own request is done, not when the slowest one is
+		if (fds[1].revents & POLLIN)
+		{
+			workers.takeFinished(finished);
+			for (Connection* connection : finished)
+				connection->send();
+		}
+
+		// every request that's whole, including pipelined ones already in the buffer
+		for (auto& connection : connections)
+		{
+			if (connection->_busy || connection->isReplying())
+				continue;
+			if (uint32_t size = connection->pendingRequest())
+				workers.submit(*connection, size);
+		}
+
+		std::erase_if(connections, [](const std::unique_ptr<Connection>& connection) {
+			if (connection->_busy || !connection->_closed)
+				return false;
+			close(connection->_fd);
+			return true;
+		});
+
+		if (fds[0].revents & POLLIN)
+		{
+			int fd = accept(server, nullptr, nullptr);
+			if (fd >= 0)
+			{
+				fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+				auto& connection = connections.emplace_back(std::make_unique<Connection>());
+				connection->_fd = fd;
+				connection->_id = nextID++;
+			}
+		}
+	}
+
+	// the segments are unlinked as the connections go, none may still be with a worker
+	workers.stop();
+	for (auto& connection : connections)
+		close(connection->_fd);
+	connections.clear();
+
+	close(server);
+	unlink(address.sun_path);
+	return 0;
+}
+
+#else
+
+int EnvServer::run(std::string_view socketPath, int, unsigned)
+{
+	GameToolbox::log("EnvServer: not supported on this platform ({})", socketPath);
+	return 1;
+}
+
+#endif
@@ -0,0 +1,69 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// Out of process environments for trainers that can't load proj.python's module. Every
+// connection on the unix stream socket owns one SimVecEnv, every request is served on a worker
+// thread of its own and answered as soon as it's done. Only available where unix sockets are.
+//
+// Messages both ways are a little endian uint32 byte count followed by that many bytes. A request
+// starts with its EnvRequestType, a reply with 0 for ok or 1 followed by an error message.
+//   reset       u64 seed, i32 level (0 for the server's), u32 count, u32 action repeat, u64 max ticks
+//               -> u32 count, u32 observation size, name of the EnvShmHeader segment
+//   step        u8 action -> f32 reward, u8 done           only for count 1
+//   batch step  u8 action per world -> nothing
+//   close       -> nothing, then the server hangs up
+// Observations, rewards and dones of every step are in the shared memory segment, it exists from
+// the first reset until the connection closes. A reset with a different level, count, repeat or
+// max ticks makes a new SimVecEnv but keeps the segment if the size allows.
+enum EnvRequestType : uint8_t
+{
+	kEnvRequestReset = 1,
+	kEnvRequestStep,
+	kEnvRequestBatchStep,
+	kEnvRequestClose,
+};
+
+// Start of a connection's segment. The layout is read by ai_source/env_client.py: magic 0,
+// version 4, count 8, observation size 12, steps 16, then from 64 the float observations
+// [count][observation size], float rewards [count] and byte dones [count].
+struct EnvShmHeader
+{
+	static constexpr uint32_t kMagic = 0x56454750; // "PGEV"
+	static constexpr uint32_t kVersion = 1;
+
+	uint32_t _magic;
+	uint32_t _version;
+	uint32_t _count;
+	uint32_t _observationSize;
+	uint64_t _steps; // steps since the last reset
+	uint8_t _pad[40];
+};
+
+static_assert(sizeof(EnvShmHeader) == 64);
+
+namespace EnvServer
+{
+	// threads serving requests, 0 for one per hardware thread. Blocks until SIGTERM or SIGINT,
+	// returns the process exit code
+	int run(std::string_view socketPath, int levelID, unsigned threads = 0);
+}
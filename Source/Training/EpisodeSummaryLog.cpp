@@ -0,0 +1,81 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "EpisodeSummaryLog.h"
+
+#include <algorithm>
+#include <string>
+
+#include "GameToolbox/log.h"
+#include "Simulation/SimEpisodeStats.h"
+#include "Simulation/SimLevel.h"
+
+EpisodeSummaryLog* EpisodeSummaryLog::getInstance()
+{
+	static EpisodeSummaryLog instance;
+	return &instance;
+}
+
+bool EpisodeSummaryLog::open(std::string_view path)
+{
+	close();
+
+	_file = std::fopen(std::string(path).c_str(), "ab");
+	if (!_file)
+	{
+		GameToolbox::log("EpisodeSummaryLog: could not open {}", path);
+		return false;
+	}
+
+	GameToolbox::log("EpisodeSummaryLog: appending to {}", path);
+	return true;
+}
+
+void EpisodeSummaryLog::close()
+{
+	if (_file)
+		std::fclose(_file);
+	_file = nullptr;
+}
+
+EpisodeSummary EpisodeSummaryLog::makeSummary(const SimEpisodeStats& stats, const SimLevel& level, uint32_t attempt)
+{
+	EpisodeSummary summary{};
+	summary._ticks = stats._ticks;
+	summary._attempt = attempt;
+	summary._deathObject = stats._deathObject;
+	summary._deathObjectID = stats._deathObject < 0 ? -1 : level._objects[stats._deathObject]._id;
+	summary._maxX = stats._maxX;
+	summary._percentage = stats._percentage;
+	summary._jumps = stats._jumps;
+	summary._orbActivations = std::min(stats._orbActivations, 0xFFFF);
+	summary._padActivations = std::min(stats._padActivations, 0xFFFF);
+	summary._outcome = stats._completed ? kEpisodeOutcomeCompleted
+					 : stats._dead		? kEpisodeOutcomeDied
+										: kEpisodeOutcomeAbandoned;
+	return summary;
+}
+
+void EpisodeSummaryLog::write(const EpisodeSummary& summary)
+{
+	if (!_file)
+		return;
+
+	std::fwrite(&summary, sizeof(summary), 1, _file);
+	std::fflush(_file);
+}
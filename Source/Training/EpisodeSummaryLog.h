@@ -0,0 +1,72 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+
+struct SimEpisodeStats;
+class SimLevel;
+
+enum EpisodeOutcome : uint8_t
+{
+	kEpisodeOutcomeAbandoned, // reset or left before dying or finishing
+	kEpisodeOutcomeDied,
+	kEpisodeOutcomeCompleted,
+};
+
+// One attempt, appended as raw bytes. Mirrored by struct.Struct("<QIiiffIHHB3x") in ai_source.
+struct EpisodeSummary
+{
+	uint64_t _ticks;		 // simulation ticks survived
+	uint32_t _attempt;		 // PlayLayer::_attempts
+	int32_t _deathObject;	 // index into SimLevel::_objects, -1 if none
+	int32_t _deathObjectID;	 // object id of the killer (8 = spike...), -1 if none
+	float _maxX;
+	float _percentage;
+	uint32_t _jumps;
+	uint16_t _orbActivations;
+	uint16_t _padActivations;
+	uint8_t _outcome; // EpisodeOutcome
+	uint8_t _pad[3];
+};
+
+static_assert(sizeof(EpisodeSummary) == 40);
+
+// Append-only file of EpisodeSummary records, one per attempt. Nothing but fixed size records,
+// so any number of runs can be aggregated with a single read.
+class EpisodeSummaryLog
+{
+  public:
+	static EpisodeSummaryLog* getInstance();
+	~EpisodeSummaryLog() { close(); }
+
+	bool open(std::string_view path);
+	void close();
+	bool isOpen() const { return _file != nullptr; }
+
+	static EpisodeSummary makeSummary(const SimEpisodeStats& stats, const SimLevel& level, uint32_t attempt);
+
+	// flushed right away, the trainer may read the file while the game keeps running
+	void write(const EpisodeSummary& summary);
+
+  private:
+	FILE* _file = nullptr;
+};
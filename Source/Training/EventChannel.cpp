@@ -0,0 +1,90 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "EventChannel.h"
+
+#include "GameToolbox/log.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+EventChannel* EventChannel::getInstance()
+{
+	static EventChannel instance;
+	return &instance;
+}
+
+std::string EventChannel::getWakePath(std::string_view name)
+{
+	if (!name.empty() && name[0] == '/')
+		name.remove_prefix(1);
+	return "/tmp/" + std::string(name) + ".wake";
+}
+
+bool EventChannel::open(std::string_view name, uint32_t capacity)
+{
+	if (!_ring.create(name, capacity, kMagic, kVersion))
+	{
+		GameToolbox::log("EventChannel: could not open {}", name);
+		return false;
+	}
+
+#ifndef _WIN32
+	// O_RDWR keeps the fifo open with no reader attached, so neither open() nor write() blocks
+	_wakePath = getWakePath(name);
+	unlink(_wakePath.c_str());
+	if (mkfifo(_wakePath.c_str(), 0600) == 0)
+		_wakeFd = ::open(_wakePath.c_str(), O_RDWR | O_NONBLOCK);
+	if (_wakeFd < 0)
+		GameToolbox::log("EventChannel: no wake fifo at {}, readers will have to poll", _wakePath);
+#endif
+
+	GameToolbox::log("EventChannel: publishing to {} ({} records)", name, capacity);
+	return true;
+}
+
+void EventChannel::close()
+{
+#ifndef _WIN32
+	if (_wakeFd >= 0)
+	{
+		::close(_wakeFd);
+		unlink(_wakePath.c_str());
+	}
+#endif
+	_wakeFd = -1;
+	_wakePath.clear();
+	_ring.close();
+}
+
+void EventChannel::publish(const EpisodeEvent& event)
+{
+	_ring.push(event);
+
+#ifndef _WIN32
+	// a full fifo already has a wakeup pending, losing this byte is fine
+	if (_wakeFd >= 0)
+	{
+		char byte = event._type;
+		[[maybe_unused]] auto written = write(_wakeFd, &byte, 1);
+	}
+#endif
+}
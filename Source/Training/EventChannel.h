@@ -0,0 +1,77 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "ShmRing.h"
+
+// What ended or started an attempt
+enum EpisodeEventType : uint8_t
+{
+	kEpisodeEventReset,		 // a new attempt starts, at tick 0 or the tick of the checkpoint it starts from
+	kEpisodeEventDeath,		 // _object is the killer, -1 for the ground, ceiling or falling out
+	kEpisodeEventComplete,	 // reached the end of the level
+	kEpisodeEventCheckpoint, // a practice checkpoint was saved, _object is its index
+};
+
+// Mirrored by struct.Struct("<QIiffBB6x") in ai_source.
+struct EpisodeEvent
+{
+	uint64_t _tick;	   // SimWorld::_tick when it happened
+	uint32_t _attempt; // PlayLayer::_attempts
+	int32_t _object;   // index into SimLevel::_objects, -1 if none
+	float _x;
+	float _percentage;
+	uint8_t _type; // EpisodeEventType
+	uint8_t _player;
+	uint8_t _pad[6];
+};
+
+static_assert(sizeof(EpisodeEvent) == 32);
+
+// Attempt boundaries published the moment PlayLayer knows about them, so the trainer doesn't have
+// to guess deaths from the screen. Besides the ring there is a fifo at getWakePath() that gets one
+// byte per event: a reader can block in read() or select() on it and drain the ring when it wakes.
+class EventChannel
+{
+  public:
+	static constexpr uint32_t kMagic = 0x4F444745; // "OGDE"
+	static constexpr uint32_t kVersion = 1;
+	static constexpr uint32_t kDefaultCapacity = 256;
+
+	static EventChannel* getInstance();
+	~EventChannel() { close(); }
+
+	// /tmp/<name>.wake
+	static std::string getWakePath(std::string_view name);
+
+	bool open(std::string_view name, uint32_t capacity = kDefaultCapacity);
+	void close();
+	bool isOpen() const { return _ring.isOpen(); }
+
+	void publish(const EpisodeEvent& event);
+
+  private:
+	ShmRing<EpisodeEvent> _ring;
+	std::string _wakePath;
+	int _wakeFd = -1;
+};
@@ -0,0 +1,271 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "ForkServer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EpisodeSummaryLog.h"
+#include "EventChannel.h"
+#include "HeadlessEnvironment.h"
+#include "InputChannel.h"
+#include "LevelCache.h"
+#include "ObservationChannel.h"
+#include "ReplayLog.h"
+#include "TrainingOptions.h"
+#include "GameToolbox/log.h"
+#include "Simulation/SimLevel.h"
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+#endif
+
+#ifndef _WIN32
+
+static std::atomic<bool> s_stop = false;
+
+static void onStopSignal(int)
+{
+	s_stop.store(true);
+}
+
+// no SA_RESTART, a blocking accept() returns EINTR so the stop flag gets checked
+static void installStopHandler()
+{
+	struct sigaction action = {};
+	action.sa_handler = onStopSignal;
+	sigemptyset(&action.sa_mask);
+	sigaction(SIGTERM, &action, nullptr);
+	sigaction(SIGINT, &action, nullptr);
+}
+
+static bool readLine(int fd, std::string& line)
+{
+	char c;
+	while (line.size() < 4096)
+	{
+		ssize_t got = read(fd, &c, 1);
+		if (got <= 0)
+			return false;
+		if (c == '\n')
+			return true;
+		line.push_back(c);
+	}
+	return false;
+}
+
+static std::vector<std::string_view> splitWords(std::string_view line)
+{
+	std::vector<std::string_view> words;
+	while (!line.empty())
+	{
+		size_t end = line.find(' ');
+		if (end != 0)
+			words.push_back(line.substr(0, end));
+		if (end == std::string_view::npos)
+			break;
+		line.remove_prefix(end + 1);
+	}
+	return words;
+}
+
+static void writeLine(int fd, std::string_view line)
+{
+	std::string out = fmt::format("{}\n", line);
+	[[maybe_unused]] auto written = write(fd, out.data(), out.size());
+}
+
+// the channels unlink their segments, a killed worker would leave them behind
+static void closeChannels()
+{
+	ObservationChannel::getInstance()->close();
+	InputChannel::getInstance()->close();
+	EventChannel::getInstance()->close();
+	EpisodeSummaryLog::getInstance()->close();
+	ReplayLog::getInstance()->close();
+}
+
+// never returns, the worker exits once its environment is stopped
+[[noreturn]] static void runWorker(int connection, const std::vector<std::string_view>& request,
+								   std::shared_ptr<const SimLevel> level, int levelID)
+{
+	signal(SIGCHLD, SIG_DFL);
+#ifdef __linux__
+	prctl(PR_SET_PDEATHSIG, SIGTERM);
+#endif
+
+	auto options = TrainingOptions::getInstance();
+	options->_fixedTimestep = true;
+	for (size_t i = 1; i < request.size(); i++)
+	{
+		std::string_view token = request[i];
+		size_t equals = token.find('=');
+		if (equals == std::string_view::npos)
+			continue;
+
+		std::string_view key = token.substr(0, equals);
+		std::string value(token.substr(equals + 1));
+
+		if (key == "obs")
+			options->_observationShm = value;
+		else if (key == "input")
+			options->_inputShm = value;
+		else if (key == "events")
+			options->_eventShm = value;
+		else if (key == "summary")
+			options->_summaryFile = value;
+		else if (key == "replays")
+			options->_replayDir = value;
+		else if (key == "fast")
+			options->_fastForward = value != "0";
+		else if (key == "practice")
+			options->_practiceMode = value != "0";
+		else if (key == "repeat")
+			options->_actionRepeat = std::max(1, std::atoi(value.c_str()));
+		else if (key == "seed")
+			options->_seed = std::strtoull(value.c_str(), nullptr, 0);
+	}
+
+	// a trainer told ready would wait on a channel that never comes
+	const char* failed = nullptr;
+	if (!options->_observationShm.empty() && !ObservationChannel::getInstance()->open(options->_observationShm))
+		failed = "obs";
+	else if (!options->_inputShm.empty() && !InputChannel::getInstance()->open(options->_inputShm))
+		failed = "input";
+	else if (!options->_eventShm.empty() && !EventChannel::getInstance()->open(options->_eventShm))
+		failed = "events";
+	else if (!options->_summaryFile.empty() && !EpisodeSummaryLog::getInstance()->open(options->_summaryFile))
+		failed = "summary";
+	else if (!options->_replayDir.empty() && !ReplayLog::getInstance()->open(options->_replayDir))
+		failed = "replays";
+
+	if (failed)
+	{
+		writeLine(connection, fmt::format("error could not open {}", failed));
+		close(connection);
+		closeChannels();
+		_exit(1);
+	}
+
+	ObservationChannel::getInstance()->setActionRepeat(options->_actionRepeat);
+	writeLine(connection, fmt::format("ready {}", getpid()));
+	close(connection);
+
+	{
+		HeadlessEnvironment environment(std::move(level), levelID);
+		environment.run(s_stop);
+	}
+
+	// the last attempt's summary and replay were written as the environment went
+	closeChannels();
+	_exit(0);
+}
+
+int ForkServer::run(std::string_view socketPath, int levelID)
+{
+	auto level = LevelCache::getInstance()->getSimLevel(levelID);
+	if (!level)
+	{
+		GameToolbox::log("ForkServer: level {} not found", levelID);
+		return 1;
+	}
+
+	sockaddr_un address = {};
+	address.sun_family = AF_UNIX;
+	if (socketPath.size() >= sizeof(address.sun_path))
+	{
+		GameToolbox::log("ForkServer: socket path {} is too long", socketPath);
+		return 1;
+	}
+	socketPath.copy(address.sun_path, socketPath.size());
+
+	int server = socket(AF_UNIX, SOCK_STREAM, 0);
+	unlink(address.sun_path);
+	if (server < 0 || bind(server, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+		listen(server, 64) != 0)
+	{
+		GameToolbox::log("ForkServer: could not listen on {}", socketPath);
+		if (server >= 0)
+			close(server);
+		return 1;
+	}
+
+	// workers are never waited for, let the kernel reap them
+	signal(SIGCHLD, SIG_IGN);
+	installStopHandler();
+
+	GameToolbox::log("ForkServer: level {} ({} objects) ready on {}", levelID, level->_objects.size(), socketPath);
+
+	while (!s_stop.load())
+	{
+		int connection = accept(server, nullptr, nullptr);
+		if (connection < 0)
+			continue;
+
+		std::string line;
+		if (!readLine(connection, line))
+		{
+			close(connection);
+			continue;
+		}
+
+		auto request = splitWords(line);
+		if (request.empty() || request[0] != "spawn")
+		{
+			writeLine(connection, "error unknown request");
+			close(connection);
+			continue;
+		}
+
+		pid_t pid = fork();
+		if (pid == 0)
+		{
+			close(server);
+			runWorker(connection, request, level, levelID);
+		}
+
+		if (pid < 0)
+			writeLine(connection, "error fork failed");
+		close(connection);
+	}
+
+	close(server);
+	unlink(address.sun_path);
+	return 0;
+}
+
+#else
+
+int ForkServer::run(std::string_view socketPath, int)
+{
+	GameToolbox::log("ForkServer: not supported on this platform ({})", socketPath);
+	return 1;
+}
+
+#endif
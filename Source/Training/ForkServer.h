@@ -0,0 +1,35 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <string_view>
+
+// Headless environment zygote. Loads the object tables and one level once, then forks a
+// HeadlessEnvironment worker per request so new environments start in about a millisecond and
+// share the parsed level with the server copy-on-write. Only available where fork() is.
+//
+// Requests are single lines on a unix stream socket:
+//   spawn obs=<shm> input=<shm> events=<shm> summary=<file> replays=<dir> fast=<0|1> practice=<0|1> repeat=<ticks> seed=<n>
+// every key is optional. The worker answers "ready <pid>" once its channels exist, or the server
+// answers "error <reason>". Workers run until SIGTERM or until the server exits.
+namespace ForkServer
+{
+	// blocks until SIGTERM or SIGINT, returns the process exit code
+	int run(std::string_view socketPath, int levelID);
+}
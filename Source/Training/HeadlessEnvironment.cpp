@@ -0,0 +1,194 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "HeadlessEnvironment.h"
+
+#include <chrono>
+#include <thread>
+
+#include "EpisodeSummaryLog.h"
+#include "GameToolbox/log.h"
+#include "ObservationChannel.h"
+#include "ReplayLog.h"
+#include "TrainingOptions.h"
+
+HeadlessEnvironment::HeadlessEnvironment(std::shared_ptr<const SimLevel> level, int levelID)
+	: _world(std::move(level)), _levelID(levelID)
+{
+	_world._recordInputs = ReplayLog::getInstance()->isOpen();
+	_world._seed = TrainingOptions::getInstance()->_seed;
+	resetLevel();
+}
+
+void HeadlessEnvironment::run(const std::atomic<bool>& stop)
+{
+	using clock = std::chrono::steady_clock;
+	constexpr auto tick = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / SimWorld::kTickRate));
+
+	bool realTime = !TrainingOptions::getInstance()->_fastForward;
+	auto next = clock::now();
+
+	while (!stop.load(std::memory_order_relaxed))
+	{
+		step();
+
+		if (realTime)
+		{
+			next += tick;
+			std::this_thread::sleep_until(next);
+		}
+	}
+
+	finishEpisode();
+}
+
+void HeadlessEnvironment::step()
+{
+	auto inputs = InputChannel::getInstance();
+	InputRecord command;
+	while (inputs->isOpen() && inputs->apply(_world, command))
+		runCommand(command);
+
+	_world.step(SimWorld::kTickStep);
+	_stats.update(_world);
+	if (_world._recordInputs)
+		_replayRecorder.afterStep(_world);
+
+	if (auto observations = ObservationChannel::getInstance(); observations->isOpen())
+		observations->publish(_world);
+
+	for (const SimEvent& event : _world._events)
+	{
+		if (event._type == kSimEventPlayerDied)
+		{
+			publishEpisodeEvent(kEpisodeEventDeath, event._object);
+			resetLevel();
+			return;
+		}
+	}
+
+	if (_stats._completed)
+	{
+		publishEpisodeEvent(kEpisodeEventComplete, -1);
+		resetLevel();
+	}
+}
+
+void HeadlessEnvironment::resetLevel()
+{
+	// the trainer's inputs still waiting were for the attempt that just ended
+	InputChannel::getInstance()->clear();
+
+	if (TrainingOptions::getInstance()->_practiceMode && !_checkpoints.empty())
+	{
+		startFromCheckpoint(-1);
+		return;
+	}
+
+	finishEpisode();
+	_attempts++;
+	_world.reset();
+	beginEpisode();
+}
+
+void HeadlessEnvironment::saveCheckpoint()
+{
+	_world.saveSnapshot(_checkpoints.emplace_back());
+	publishEpisodeEvent(kEpisodeEventCheckpoint, static_cast<int>(_checkpoints.size()) - 1);
+}
+
+void HeadlessEnvironment::startFromCheckpoint(int index)
+{
+	if (index < 0)
+		index += static_cast<int>(_checkpoints.size());
+	if (index < 0 || index >= static_cast<int>(_checkpoints.size()))
+	{
+		GameToolbox::log("HeadlessEnvironment: no checkpoint {}, {} saved", index, _checkpoints.size());
+		return;
+	}
+
+	finishEpisode();
+	_attempts++;
+	_world.restoreSnapshot(_checkpoints[index]);
+	beginEpisode();
+}
+
+void HeadlessEnvironment::startFromX(float x)
+{
+	finishEpisode();
+	_attempts++;
+	_world.resetAt(x);
+	beginEpisode();
+}
+
+void HeadlessEnvironment::runCommand(const InputRecord& command)
+{
+	switch (command._command)
+	{
+	case kInputCommandSaveCheckpoint:
+		saveCheckpoint();
+		break;
+	case kInputCommandStartFromCheckpoint:
+		startFromCheckpoint(static_cast<int>(command._value));
+		break;
+	case kInputCommandStartFromX:
+		startFromX(command._value);
+		break;
+	case kInputCommandClearCheckpoints:
+		_checkpoints.clear();
+		break;
+	default:
+		break;
+	}
+}
+
+void HeadlessEnvironment::beginEpisode()
+{
+	_stats.reset(_world);
+	_replayRecorder.begin(_world, _levelID);
+	_episodeFinished = false;
+	publishEpisodeEvent(kEpisodeEventReset, -1);
+}
+
+void HeadlessEnvironment::publishEpisodeEvent(EpisodeEventType type, int object)
+{
+	auto events = EventChannel::getInstance();
+	if (!events->isOpen())
+		return;
+
+	EpisodeEvent event{};
+	event._tick = _world._tick;
+	event._attempt = _attempts;
+	event._object = object;
+	event._x = _world._player1._position.x;
+	event._percentage = _world.getPercentage();
+	event._type = type;
+	events->publish(event);
+}
+
+void HeadlessEnvironment::finishEpisode()
+{
+	if (_episodeFinished || _stats._ticks == 0)
+		return;
+	_episodeFinished = true;
+
+	if (auto log = EpisodeSummaryLog::getInstance(); log->isOpen())
+		log->write(EpisodeSummaryLog::makeSummary(_stats, *_world._level, _attempts));
+	if (_world._recordInputs)
+		ReplayLog::getInstance()->write(_replayRecorder.finish(_world), _attempts);
+}
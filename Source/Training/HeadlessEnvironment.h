@@ -0,0 +1,70 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "Simulation/SimEpisodeStats.h"
+#include "Simulation/SimReplay.h"
+#include "Simulation/SimWorld.h"
+#include "EventChannel.h"
+#include "InputChannel.h"
+
+class SimLevel;
+
+// A level played without a window: one SimWorld driven by InputChannel, publishing to the
+// observation, event and summary channels the same way PlayLayer does. Dying or finishing starts
+// the next attempt straight away, from the newest checkpoint in practice mode. This is what
+// ForkServer workers run.
+class HeadlessEnvironment
+{
+  public:
+	HeadlessEnvironment(std::shared_ptr<const SimLevel> level, int levelID);
+
+	// ticks at SimWorld::kTickRate in real time, or as fast as possible with
+	// TrainingOptions::_fastForward, until stop is set
+	void run(const std::atomic<bool>& stop);
+
+	// one fixed tick
+	void step();
+
+	void resetLevel();
+
+	// new attempts that skip the start of the level, see InputCommand
+	void saveCheckpoint();
+	void startFromCheckpoint(int index);
+	void startFromX(float x);
+
+  private:
+	SimWorld _world;
+	SimEpisodeStats _stats;
+	SimReplayRecorder _replayRecorder;
+	std::vector<SimSnapshot> _checkpoints;
+	int _levelID;
+	int _attempts = 0;
+	bool _episodeFinished = false;
+
+	void runCommand(const InputRecord& command);
+	// after the world was put where the attempt starts
+	void beginEpisode();
+	void publishEpisodeEvent(EpisodeEventType type, int object);
+	void finishEpisode();
+};
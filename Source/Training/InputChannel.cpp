@@ -0,0 +1,79 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "InputChannel.h"
+
+#include "GameToolbox/log.h"
+#include "Simulation/SimWorld.h"
+
+InputChannel* InputChannel::getInstance()
+{
+	static InputChannel instance;
+	return &instance;
+}
+
+bool InputChannel::open(std::string_view name, uint32_t capacity)
+{
+	if (!_ring.create(name, capacity, kMagic, kVersion))
+	{
+		GameToolbox::log("InputChannel: could not open {}", name);
+		return false;
+	}
+
+	GameToolbox::log("InputChannel: reading from {} ({} records)", name, capacity);
+	return true;
+}
+
+void InputChannel::close()
+{
+	_ring.close();
+	_pending.clear();
+}
+
+bool InputChannel::apply(SimWorld& world, InputRecord& command)
+{
+	InputRecord record;
+	while (_ring.pop(record))
+		_pending.push_back(record);
+
+	while (!_pending.empty() && _pending.front()._tick <= world._tick)
+	{
+		const InputRecord& input = _pending.front();
+		if (input._command != kInputCommandButton)
+		{
+			command = input;
+			_pending.pop_front();
+			return true;
+		}
+
+		int player = input._player ? 1 : 0;
+		if (input._press)
+			world.pushButton(player);
+		else
+			world.releaseButton(player);
+
+		_pending.pop_front();
+	}
+	return false;
+}
+
+void InputChannel::clear()
+{
+	// whatever is still in the ring was sent after the death was observed, so it is for the next attempt
+	_pending.clear();
+}
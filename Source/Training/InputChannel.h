@@ -0,0 +1,79 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string_view>
+
+#include "ShmRing.h"
+
+class SimWorld;
+
+enum InputCommand : uint8_t
+{
+	kInputCommandButton,			  // _player and _press
+	kInputCommandSaveCheckpoint,	  // keep the current state, answered with a kEpisodeEventCheckpoint
+	kInputCommandStartFromCheckpoint, // new attempt from checkpoint int(_value), negative counts back from the newest
+	kInputCommandStartFromX,		  // new attempt from x = _value, see SimWorld::resetAt
+	kInputCommandClearCheckpoints,
+};
+
+// A button press or release for one player, or a command for whoever plays the level.
+// Mirrored by struct.Struct("<QBBBxf") in ai_source.
+struct InputRecord
+{
+	uint64_t _tick;	  // applied once SimWorld::_tick reaches this, right before the next step
+	uint8_t _player;  // 0 or 1
+	uint8_t _press;	  // 1 = pushButton, 0 = releaseButton
+	uint8_t _command; // InputCommand
+	uint8_t _pad;
+	float _value;
+};
+
+static_assert(sizeof(InputRecord) == 16);
+
+// Button input written by the trainer into a shared memory ring, fed straight into the
+// simulation at the exact tick it asks for instead of going through the window's key events.
+class InputChannel
+{
+  public:
+	static constexpr uint32_t kMagic = 0x4F444749; // "OGDI"
+	static constexpr uint32_t kVersion = 2;
+	static constexpr uint32_t kDefaultCapacity = 1024;
+
+	static InputChannel* getInstance();
+
+	bool open(std::string_view name, uint32_t capacity = kDefaultCapacity);
+	void close();
+	bool isOpen() const { return _ring.isOpen(); }
+
+	// applies the buttons due at the world's current tick, call right before SimWorld::step. Stops at
+	// the first due command and returns it instead, the caller runs it and calls again until false
+	bool apply(SimWorld& world, InputRecord& command);
+
+	// drops popped inputs still waiting for a later tick, the attempt they were meant for is over
+	void clear();
+
+  private:
+	ShmRing<InputRecord> _ring;
+
+	// popped from the ring but not due yet, the trainer sends them in tick order
+	std::deque<InputRecord> _pending;
+};
@@ -0,0 +1,102 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "NeatController.h"
+
+#include <algorithm>
+
+#include "Simulation/SimBatch.h"
+#include "Simulation/SimWorld.h"
+
+NeatController::NeatController(NeatNetwork network) : _network(std::move(network))
+{
+}
+
+void NeatController::reset()
+{
+	_hasPrevPosition = false;
+	_held = false;
+}
+
+bool NeatController::decide(const SimWorld& world, int playerIndex)
+{
+	if (!isValid())
+		return false;
+
+	const SimPlayer& player = playerIndex == 0 ? world._player1 : world._player2;
+	SimVec2 prev = _hasPrevPosition ? _prevPosition : player._position;
+
+	// keep in sync with prepare_inputs in ai_source/train.py
+	_inputs[0] = player._position.x / 1000.f;
+	_inputs[1] = player._position.y / 1000.f;
+	_inputs[2] = (float)player._yVel / 20.f;
+	_inputs[3] = player._onGround ? 1.f : 0.f;
+	_inputs[4] = (player._position.x - prev.x) / 10.f;
+	_inputs[5] = (player._position.y - prev.y) / 10.f;
+	_inputs[6] = player._isDead ? 1.f : 0.f;
+	_raycaster.cast(world, playerIndex, _inputs + kBaseInputs);
+
+	_prevPosition = player._position;
+	_hasPrevPosition = true;
+
+	float output;
+	_network.activate(_inputs, &output);
+	return output > 0.5f;
+}
+
+void NeatController::apply(SimWorld& world, int player)
+{
+	bool hold = decide(world, player);
+	if (hold == _held)
+		return;
+
+	if (hold)
+		world.pushButton(player);
+	else
+		world.releaseButton(player);
+	_held = hold;
+}
+
+std::vector<float> NeatController::evaluate(std::shared_ptr<const SimLevel> level, std::vector<NeatNetwork> networks,
+											 int maxTicks, unsigned threads, int actionRepeat)
+{
+	SimBatch batch(level, (int)networks.size(), threads);
+
+	std::vector<NeatController> controllers;
+	controllers.reserve(networks.size());
+	for (auto& network : networks)
+		controllers.emplace_back(std::move(network));
+
+	std::vector<float> fitness(controllers.size(), 0.f);
+
+	batch.step(
+		[&](int index, const SimWorld& world) {
+			fitness[index] = std::max(fitness[index], world._player1._position.x);
+			return controllers[index].decide(world);
+		},
+		maxTicks, actionRepeat);
+
+	for (int i = 0; i < batch.size(); i++)
+	{
+		fitness[i] = std::max(fitness[i], batch.getWorld(i)._player1._position.x);
+		if (!controllers[i].isValid())
+			fitness[i] = 0.f;
+	}
+
+	return fitness;
+}
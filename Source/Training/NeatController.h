@@ -0,0 +1,68 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "NeatNetwork.h"
+#include "ObservationChannel.h"
+#include "Simulation/SimRaycaster.h"
+
+class SimLevel;
+class SimWorld;
+
+// Plays a SimWorld with a NeatNetwork in process. The inputs are the ones prepare_inputs in
+// ai_source/train.py builds from the observation ring, so a genome behaves the same here as
+// when it is driven from python.
+class NeatController
+{
+  public:
+	// x, y, y velocity, on ground, x and y moved since the last decision, dead
+	static constexpr int kBaseInputs = 7;
+	static constexpr int kInputCount = kBaseInputs + kObservationRays * SimRaycaster::kFloatsPerRay;
+
+	explicit NeatController(NeatNetwork network);
+
+	// false when the genome was exported for a different number of inputs
+	bool isValid() const { return _network.getInputCount() == kInputCount && _network.getOutputCount() > 0; }
+
+	// start of an attempt, there is no previous position to diff against
+	void reset();
+
+	// runs the network on the current state, true means hold the button
+	bool decide(const SimWorld& world, int player = 0);
+
+	// decide() and push or release the world's button when the answer changed
+	void apply(SimWorld& world, int player = 0);
+
+	// plays one attempt per network on a SimBatch and returns how far each one got (the
+	// trainer's max_x fitness). Networks with the wrong input count score 0. Each network runs
+	// once every actionRepeat ticks, see SimBatch::step
+	static std::vector<float> evaluate(std::shared_ptr<const SimLevel> level, std::vector<NeatNetwork> networks,
+									   int maxTicks, unsigned threads = 0, int actionRepeat = 1);
+
+  private:
+	NeatNetwork _network;
+	SimRaycaster _raycaster{{kObservationRays}};
+	SimVec2 _prevPosition;
+	bool _hasPrevPosition = false;
+	bool _held = false;
+	float _inputs[kInputCount];
+};
@@ -0,0 +1,297 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "NeatNetwork.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "GameToolbox/log.h"
+#include "external/json.hpp"
+
+namespace
+{
+struct GenomeNode
+{
+	float bias = 0.f, response = 1.f;
+	NeatNetwork::Activation activation = NeatNetwork::kActivationSigmoid;
+	NeatNetwork::Aggregation aggregation = NeatNetwork::kAggregationSum;
+};
+
+struct GenomeConnection
+{
+	int in, out;
+	float weight;
+};
+
+bool parseActivation(std::string_view name, NeatNetwork::Activation& out)
+{
+	static const std::unordered_map<std::string_view, NeatNetwork::Activation> names = {
+		{"sigmoid", NeatNetwork::kActivationSigmoid},	{"tanh", NeatNetwork::kActivationTanh},
+		{"relu", NeatNetwork::kActivationRelu},			{"identity", NeatNetwork::kActivationIdentity},
+		{"clamped", NeatNetwork::kActivationClamped},	{"sin", NeatNetwork::kActivationSin},
+		{"gauss", NeatNetwork::kActivationGauss},		{"abs", NeatNetwork::kActivationAbs},
+	};
+	auto it = names.find(name);
+	if (it == names.end())
+		return false;
+	out = it->second;
+	return true;
+}
+
+bool parseAggregation(std::string_view name, NeatNetwork::Aggregation& out)
+{
+	static const std::unordered_map<std::string_view, NeatNetwork::Aggregation> names = {
+		{"sum", NeatNetwork::kAggregationSum}, {"product", NeatNetwork::kAggregationProduct},
+		{"max", NeatNetwork::kAggregationMax}, {"min", NeatNetwork::kAggregationMin},
+		{"mean", NeatNetwork::kAggregationMean},
+	};
+	auto it = names.find(name);
+	if (it == names.end())
+		return false;
+	out = it->second;
+	return true;
+}
+
+// same scaling and clamping as neat/activations.py
+float applyActivation(NeatNetwork::Activation activation, float z)
+{
+	switch (activation)
+	{
+	case NeatNetwork::kActivationSigmoid:
+		z = std::clamp(5.f * z, -60.f, 60.f);
+		return 1.f / (1.f + std::exp(-z));
+	case NeatNetwork::kActivationTanh:
+		return std::tanh(std::clamp(2.5f * z, -60.f, 60.f));
+	case NeatNetwork::kActivationRelu:
+		return z > 0.f ? z : 0.f;
+	case NeatNetwork::kActivationIdentity:
+		return z;
+	case NeatNetwork::kActivationClamped:
+		return std::clamp(z, -1.f, 1.f);
+	case NeatNetwork::kActivationSin:
+		return std::sin(std::clamp(5.f * z, -60.f, 60.f));
+	case NeatNetwork::kActivationGauss:
+		z = std::clamp(z, -3.4f, 3.4f);
+		return std::exp(-5.f * z * z);
+	case NeatNetwork::kActivationAbs:
+		return std::abs(z);
+	}
+	return z;
+}
+} // namespace
+
+bool NeatNetwork::loadFromFile(std::string_view path)
+{
+	std::ifstream file{std::string(path)};
+	if (!file)
+	{
+		GameToolbox::log("NeatNetwork: could not open {}", path);
+		return false;
+	}
+
+	std::stringstream contents;
+	contents << file.rdbuf();
+	return loadFromJson(contents.str());
+}
+
+bool NeatNetwork::loadFromJson(std::string_view text)
+{
+	auto json = nlohmann::json::parse(text, nullptr, false);
+	if (json.is_discarded() || !json.is_object() || !json["inputs"].is_array() || !json["outputs"].is_array() ||
+		!json["nodes"].is_array() || !json["connections"].is_array())
+	{
+		GameToolbox::log("NeatNetwork: not an exported genome");
+		return false;
+	}
+
+	std::vector<int> inputKeys, outputKeys;
+	for (auto& key : json["inputs"])
+		inputKeys.push_back(key.get<int>());
+	for (auto& key : json["outputs"])
+		outputKeys.push_back(key.get<int>());
+
+	std::unordered_map<int, GenomeNode> nodes;
+	for (auto& node : json["nodes"])
+	{
+		GenomeNode n;
+		n.bias = node.value("bias", 0.f);
+		n.response = node.value("response", 1.f);
+		if (!parseActivation(node.value("activation", "sigmoid"), n.activation) ||
+			!parseAggregation(node.value("aggregation", "sum"), n.aggregation))
+		{
+			GameToolbox::log("NeatNetwork: unsupported activation or aggregation on node {}", node.value("key", 0));
+			return false;
+		}
+		nodes[node.value("key", 0)] = n;
+	}
+
+	std::vector<GenomeConnection> connections;
+	for (auto& c : json["connections"])
+	{
+		if (!c.value("enabled", true))
+			continue;
+		connections.push_back({c.value("in", 0), c.value("out", 0), c.value("weight", 0.f)});
+	}
+
+	std::unordered_set<int> inputs(inputKeys.begin(), inputKeys.end());
+
+	// neat.graphs.required_for_output: walk back from the outputs, stopping at inputs
+	std::unordered_set<int> required(outputKeys.begin(), outputKeys.end());
+	std::unordered_set<int> seen = required;
+	while (true)
+	{
+		std::unordered_set<int> layer;
+		for (auto& c : connections)
+			if (seen.contains(c.out) && !seen.contains(c.in))
+				layer.insert(c.in);
+		if (layer.empty())
+			break;
+
+		bool anyHidden = false;
+		for (int key : layer)
+		{
+			if (!inputs.contains(key))
+			{
+				required.insert(key);
+				anyHidden = true;
+			}
+		}
+		if (!anyHidden)
+			break;
+		seen.insert(layer.begin(), layer.end());
+	}
+
+	// neat.graphs.feed_forward_layers: a node is ready once everything feeding it is
+	std::vector<int> order;
+	std::unordered_set<int> done = inputs;
+	while (true)
+	{
+		std::vector<int> layer;
+		for (auto& c : connections)
+		{
+			if (!done.contains(c.in) || done.contains(c.out) || !required.contains(c.out))
+				continue;
+			if (std::find(layer.begin(), layer.end(), c.out) != layer.end())
+				continue;
+
+			bool ready = std::all_of(connections.begin(), connections.end(),
+									 [&](const GenomeConnection& o) { return o.out != c.out || done.contains(o.in); });
+			if (ready)
+				layer.push_back(c.out);
+		}
+		if (layer.empty())
+			break;
+
+		order.insert(order.end(), layer.begin(), layer.end());
+		done.insert(layer.begin(), layer.end());
+	}
+
+	// slots: inputs, outputs, then the hidden nodes in evaluation order
+	std::unordered_map<int, uint32_t> slots;
+	for (size_t i = 0; i < inputKeys.size(); i++)
+		slots[inputKeys[i]] = (uint32_t)i;
+	for (int key : outputKeys)
+		slots.emplace(key, (uint32_t)slots.size());
+	for (int key : order)
+		slots.emplace(key, (uint32_t)slots.size());
+
+	_inputCount = (int)inputKeys.size();
+	_nodes.clear();
+	_sources.clear();
+	_weights.clear();
+	_outputSlots.clear();
+
+	for (int key : order)
+	{
+		auto it = nodes.find(key);
+		GenomeNode genomeNode = it != nodes.end() ? it->second : GenomeNode{};
+
+		Node node;
+		node._slot = slots[key];
+		node._firstConnection = (uint32_t)_sources.size();
+		node._bias = genomeNode.bias;
+		node._response = genomeNode.response;
+		node._activation = genomeNode.activation;
+		node._aggregation = genomeNode.aggregation;
+
+		for (auto& c : connections)
+		{
+			if (c.out != key)
+				continue;
+			_sources.push_back(slots[c.in]);
+			_weights.push_back(c.weight);
+		}
+		node._connectionCount = (uint32_t)_sources.size() - node._firstConnection;
+		_nodes.push_back(node);
+	}
+
+	for (int key : outputKeys)
+		_outputSlots.push_back(slots[key]);
+
+	_values.assign(slots.size(), 0.f);
+	return true;
+}
+
+void NeatNetwork::activate(const float* inputs, float* outputs)
+{
+	std::copy(inputs, inputs + _inputCount, _values.begin());
+
+	for (const Node& node : _nodes)
+	{
+		const uint32_t* sources = _sources.data() + node._firstConnection;
+		const float* weights = _weights.data() + node._firstConnection;
+		uint32_t count = node._connectionCount;
+
+		float s = 0.f;
+		switch (node._aggregation)
+		{
+		case kAggregationSum:
+		case kAggregationMean:
+			for (uint32_t i = 0; i < count; i++)
+				s += _values[sources[i]] * weights[i];
+			if (node._aggregation == kAggregationMean && count > 0)
+				s /= count;
+			break;
+		case kAggregationProduct:
+			s = 1.f;
+			for (uint32_t i = 0; i < count; i++)
+				s *= _values[sources[i]] * weights[i];
+			break;
+		case kAggregationMax:
+		case kAggregationMin:
+			for (uint32_t i = 0; i < count; i++)
+			{
+				float v = _values[sources[i]] * weights[i];
+				if (i == 0 || (node._aggregation == kAggregationMax ? v > s : v < s))
+					s = v;
+			}
+			break;
+		}
+
+		_values[node._slot] = applyActivation(node._activation, node._bias + node._response * s);
+	}
+
+	for (size_t i = 0; i < _outputSlots.size(); i++)
+		outputs[i] = _values[_outputSlots[i]];
+}
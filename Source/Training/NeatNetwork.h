@@ -0,0 +1,81 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// A feed forward genome exported by ai_source/train.py (export_genome), compiled into one flat
+// array of nodes in evaluation order with their incoming weights stored back to back.
+// activate() gives the same outputs as neat.nn.FeedForwardNetwork, nodes that can't reach an
+// output are dropped and outputs nothing feeds stay at 0.
+class NeatNetwork
+{
+  public:
+	enum Activation : uint8_t
+	{
+		kActivationSigmoid,
+		kActivationTanh,
+		kActivationRelu,
+		kActivationIdentity,
+		kActivationClamped,
+		kActivationSin,
+		kActivationGauss,
+		kActivationAbs,
+	};
+
+	enum Aggregation : uint8_t
+	{
+		kAggregationSum,
+		kAggregationProduct,
+		kAggregationMax,
+		kAggregationMin,
+		kAggregationMean,
+	};
+
+	bool loadFromJson(std::string_view json);
+	bool loadFromFile(std::string_view path);
+
+	int getInputCount() const { return _inputCount; }
+	int getOutputCount() const { return (int)_outputSlots.size(); }
+
+	// inputs and outputs as many floats as getInputCount/getOutputCount. Not const, the node
+	// values live in the network, so use one network per thread
+	void activate(const float* inputs, float* outputs);
+
+  private:
+	struct Node
+	{
+		uint32_t _slot;			   // where the value goes in _values
+		uint32_t _firstConnection; // into _sources/_weights
+		uint32_t _connectionCount;
+		float _bias;
+		float _response;
+		Activation _activation;
+		Aggregation _aggregation;
+	};
+
+	int _inputCount = 0;
+	std::vector<Node> _nodes; // evaluation order
+	std::vector<uint32_t> _sources;
+	std::vector<float> _weights;
+	std::vector<uint32_t> _outputSlots;
+	std::vector<float> _values; // inputs first, then one slot per output and evaluated node
+};
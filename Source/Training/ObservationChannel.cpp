@@ -0,0 +1,69 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "ObservationChannel.h"
+
+#include "GameToolbox/log.h"
+#include "Simulation/SimWorld.h"
+
+ObservationChannel* ObservationChannel::getInstance()
+{
+	static ObservationChannel instance;
+	return &instance;
+}
+
+bool ObservationChannel::open(std::string_view name, uint32_t capacity)
+{
+	if (!_ring.create(name, capacity, kMagic, kVersion))
+	{
+		GameToolbox::log("ObservationChannel: could not open {}", name);
+		return false;
+	}
+
+	GameToolbox::log("ObservationChannel: publishing to {} ({} records)", name, capacity);
+	return true;
+}
+
+void ObservationChannel::close()
+{
+	_ring.close();
+}
+
+void ObservationChannel::publish(SimWorld& world)
+{
+	if (world._tick % _actionRepeat != 0 && !world._player1._isDead && !world._player2._isDead &&
+		world.getPercentage() < 100.f)
+		return;
+
+	for (int i = 0; i < (world._isDualMode ? 2 : 1); i++)
+	{
+		const SimPlayer& player = world.getPlayer(i);
+
+		ObservationRecord record;
+		record._frame = world._tick;
+		record._x = player._position.x;
+		record._y = player._position.y;
+		record._yVel = (float)player._yVel;
+		record._onGround = player._onGround;
+		record._dead = player._isDead;
+		record._gamemode = player._gamemode;
+		record._player = i;
+		_raycaster.cast(world, i, record._rays);
+		_ring.push(record);
+	}
+}
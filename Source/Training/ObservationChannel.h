@@ -0,0 +1,74 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "ShmRing.h"
+#include "Simulation/SimRaycaster.h"
+
+class SimWorld;
+
+// rays cast for every record with the default SimRaycastConfig fan
+constexpr int kObservationRays = 8;
+
+// One player after one simulation step. Mirrored by struct.Struct("<QfffBBBB48f") in ai_source.
+struct ObservationRecord
+{
+	uint64_t _frame; // SimWorld::_tick, steps since the attempt started
+	float _x;
+	float _y;
+	float _yVel;
+	uint8_t _onGround;
+	uint8_t _dead;
+	uint8_t _gamemode;
+	uint8_t _player; // 0 or 1
+	float _rays[kObservationRays * SimRaycaster::kFloatsPerRay]; // see SimRaycaster::cast
+};
+
+static_assert(sizeof(ObservationRecord) == 24 + kObservationRays * SimRaycaster::kFloatsPerRay * 4);
+
+// Publishes the player state to a shared memory ring after every simulation step, or every
+// actionRepeat steps, replacing the player_position.txt polling the trainer used to do.
+class ObservationChannel
+{
+  public:
+	static constexpr uint32_t kMagic = 0x4F44474F; // "OGDO"
+	static constexpr uint32_t kVersion = 2;
+	static constexpr uint32_t kDefaultCapacity = 4096;
+
+	static ObservationChannel* getInstance();
+
+	bool open(std::string_view name, uint32_t capacity = kDefaultCapacity);
+	void close();
+	bool isOpen() const { return _ring.isOpen(); }
+
+	// the trainer only decides every ticks steps, the states in between are skipped. A death or
+	// the end of the level is always published on the tick it happens
+	void setActionRepeat(int ticks) { _actionRepeat = ticks < 1 ? 1 : ticks; }
+
+	// player 1, and player 2 when the world is in dual mode
+	void publish(SimWorld& world);
+
+  private:
+	ShmRing<ObservationRecord> _ring;
+	int _actionRepeat = 1;
+	SimRaycaster _raycaster{{kObservationRays}};
+};
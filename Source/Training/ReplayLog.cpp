@@ -0,0 +1,57 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "ReplayLog.h"
+
+#include <filesystem>
+#include <random>
+
+#include "GameToolbox/log.h"
+#include "Simulation/SimReplay.h"
+
+ReplayLog* ReplayLog::getInstance()
+{
+	static ReplayLog instance;
+	return &instance;
+}
+
+bool ReplayLog::open(std::string_view directory)
+{
+	std::error_code error;
+	std::filesystem::create_directories(directory, error);
+	if (error)
+	{
+		GameToolbox::log("ReplayLog: could not create {}", directory);
+		return false;
+	}
+
+	_directory = directory;
+	_session = std::random_device{}();
+	GameToolbox::log("ReplayLog: writing replays to {}", directory);
+	return true;
+}
+
+void ReplayLog::write(const SimReplay& replay, uint32_t attempt)
+{
+	if (!isOpen())
+		return;
+
+	std::string path = fmt::format("{}/{}-{:08x}-{:06}.ogdr", _directory, replay._levelID, _session, attempt);
+	if (!replay.save(path))
+		GameToolbox::log("ReplayLog: could not write {}", path);
+}
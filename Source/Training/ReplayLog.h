@@ -0,0 +1,43 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+struct SimReplay;
+
+// Writes one SimReplay file per attempt into a directory, named <level>-<session>-<attempt>.ogdr
+// where the session is random per process, so any number of games can share the directory.
+class ReplayLog
+{
+  public:
+	static ReplayLog* getInstance();
+
+	bool open(std::string_view directory);
+	void close() { _directory.clear(); }
+	bool isOpen() const { return !_directory.empty(); }
+
+	void write(const SimReplay& replay, uint32_t attempt);
+
+  private:
+	std::string _directory;
+	uint32_t _session = 0;
+};
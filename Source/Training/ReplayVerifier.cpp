@@ -0,0 +1,154 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "ReplayVerifier.h"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <memory>
+
+#include "LevelCache.h"
+#include "GameToolbox/log.h"
+#include "Simulation/SimReplay.h"
+#include "Simulation/ThreadPool.h"
+
+namespace
+{
+enum class Status
+{
+	Unreadable,
+	UnknownLevel,
+	LevelMismatch,
+	Diverged,
+	Ok,
+};
+
+struct Entry
+{
+	std::string _path;
+	SimReplay _replay;
+	std::shared_ptr<const SimLevel> _level;
+	SimReplayResult _result;
+	Status _status = Status::Unreadable;
+};
+
+std::vector<std::string> collectFiles(const std::vector<std::string>& paths)
+{
+	std::vector<std::string> files;
+	for (const std::string& path : paths)
+	{
+		std::error_code error;
+		if (!std::filesystem::is_directory(path, error))
+		{
+			files.push_back(path);
+			continue;
+		}
+
+		for (const auto& file : std::filesystem::directory_iterator(path, error))
+		{
+			if (file.is_regular_file() && file.path().extension() == ".ogdr")
+				files.push_back(file.path().string());
+		}
+	}
+	return files;
+}
+} // namespace
+
+int ReplayVerifier::run(const std::vector<std::string>& paths)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	std::vector<std::string> files = collectFiles(paths);
+	std::vector<Entry> entries(files.size());
+	for (size_t i = 0; i < files.size(); i++)
+		entries[i]._path = std::move(files[i]);
+
+	ThreadPool pool;
+	pool.parallelFor(entries.size(), [&](size_t i) {
+		if (entries[i]._replay.load(entries[i]._path))
+			entries[i]._status = Status::UnknownLevel;
+	});
+
+	// levels are built once, before the parallel part
+	std::map<int, std::shared_ptr<const SimLevel>> levels;
+	for (Entry& entry : entries)
+	{
+		if (entry._status == Status::Unreadable)
+			continue;
+
+		int levelID = entry._replay._levelID;
+		auto it = levels.find(levelID);
+		if (it == levels.end())
+			it = levels.emplace(levelID, LevelCache::getInstance()->getSimLevel(levelID)).first;
+		entry._level = it->second;
+	}
+
+	pool.parallelFor(entries.size(), [&](size_t i) {
+		Entry& entry = entries[i];
+		if (entry._status == Status::Unreadable || !entry._level)
+			return;
+
+		entry._result = verifyReplay(entry._replay, entry._level);
+		if (!entry._result._levelMatches)
+			entry._status = Status::LevelMismatch;
+		else
+			entry._status = entry._result._diverged ? Status::Diverged : Status::Ok;
+	});
+
+	int counts[5] = {};
+	uint64_t ticks = 0;
+	for (const Entry& entry : entries)
+	{
+		counts[static_cast<int>(entry._status)]++;
+		ticks += entry._result._ticks;
+
+		const SimReplay& replay = entry._replay;
+		const SimReplayResult& result = entry._result;
+		switch (entry._status)
+		{
+		case Status::Unreadable:
+			GameToolbox::log("{}: not a replay", entry._path);
+			break;
+		case Status::UnknownLevel:
+			GameToolbox::log("{}: level {} isn't a main level", entry._path, replay._levelID);
+			break;
+		case Status::LevelMismatch:
+			GameToolbox::log("{}: recorded on a different version of level {}", entry._path, replay._levelID);
+			break;
+		case Status::Diverged:
+			GameToolbox::log("{}: diverged at tick {}, ended at ({}, {}){} instead of ({}, {}){}", entry._path,
+							 result._divergenceTick, result._finalPosition.x, result._finalPosition.y,
+							 result._dead ? " dead" : "", replay._finalPosition.x, replay._finalPosition.y,
+							 replay._dead ? " dead" : "");
+			break;
+		case Status::Ok:
+			break;
+		}
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	GameToolbox::log("{} replays: {} ok, {} diverged, {} level mismatches, {} unknown levels, {} unreadable. "
+					 "{} ticks in {:.2f}s on {} threads",
+					 entries.size(), counts[(int)Status::Ok], counts[(int)Status::Diverged],
+					 counts[(int)Status::LevelMismatch], counts[(int)Status::UnknownLevel],
+					 counts[(int)Status::Unreadable], ticks, seconds, pool.getThreadCount());
+
+	return counts[(int)Status::Ok] == (int)entries.size() ? 0 : 1;
+}
@@ -0,0 +1,31 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Headless check that recorded runs still play out the same in this build. Every replay is played on
+// its own SimWorld, spread over all cores, against the main level it was recorded on.
+namespace ReplayVerifier
+{
+	// paths are .ogdr files or directories holding them. Prints a line for every replay that
+	// doesn't verify and a total, returns 0 when all of them did
+	int run(const std::vector<std::string>& paths);
+}
@@ -0,0 +1,135 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "ShmRing.h"
+
+#include "GameToolbox/log.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+ShmSegment::~ShmSegment()
+{
+	close();
+}
+
+#ifndef _WIN32
+
+// shm_open wants a single leading slash
+static std::string shmName(std::string_view name)
+{
+	std::string ret(name);
+	if (ret.empty() || ret[0] != '/')
+		ret.insert(ret.begin(), '/');
+	return ret;
+}
+
+bool ShmSegment::create(std::string_view name, size_t size)
+{
+	close();
+
+	_name = shmName(name);
+	int fd = shm_open(_name.c_str(), O_CREAT | O_RDWR, 0600);
+	if (fd < 0)
+	{
+		GameToolbox::log("shm: could not create {}", _name);
+		return false;
+	}
+
+	if (ftruncate(fd, size) != 0)
+	{
+		GameToolbox::log("shm: could not resize {} to {} bytes", _name, size);
+		::close(fd);
+		shm_unlink(_name.c_str());
+		return false;
+	}
+
+	void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (data == MAP_FAILED)
+	{
+		GameToolbox::log("shm: could not map {}", _name);
+		shm_unlink(_name.c_str());
+		return false;
+	}
+
+	_data = data;
+	_size = size;
+	_owner = true;
+	return true;
+}
+
+bool ShmSegment::open(std::string_view name)
+{
+	close();
+
+	_name = shmName(name);
+	int fd = shm_open(_name.c_str(), O_RDWR, 0600);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size <= 0)
+	{
+		::close(fd);
+		return false;
+	}
+
+	void* data = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (data == MAP_FAILED)
+		return false;
+
+	_data = data;
+	_size = st.st_size;
+	_owner = false;
+	return true;
+}
+
+void ShmSegment::close()
+{
+	if (_data)
+		munmap(_data, _size);
+	if (_owner)
+		shm_unlink(_name.c_str());
+
+	_data = nullptr;
+	_size = 0;
+	_owner = false;
+}
+
+#else
+
+bool ShmSegment::create(std::string_view name, size_t)
+{
+	GameToolbox::log("shm: shared memory channels are not supported on this platform ({})", name);
+	return false;
+}
+
+bool ShmSegment::open(std::string_view)
+{
+	return false;
+}
+
+void ShmSegment::close() {}
+
+#endif
@@ -0,0 +1,186 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// A named POSIX shared memory segment (shm_open + mmap). Not available on Windows, create and open fail there.
+class ShmSegment
+{
+  public:
+	ShmSegment() = default;
+	~ShmSegment();
+
+	ShmSegment(const ShmSegment&) = delete;
+	ShmSegment& operator=(const ShmSegment&) = delete;
+
+	// creates or truncates the segment, whoever created it unlinks it again in close()
+	bool create(std::string_view name, size_t size);
+	bool open(std::string_view name);
+	void close();
+
+	void* data() const { return _data; }
+	size_t size() const { return _size; }
+	bool isOpen() const { return _data != nullptr; }
+
+  private:
+	std::string _name;
+	void* _data = nullptr;
+	size_t _size = 0;
+	bool _owner = false;
+};
+
+// Start of every ring segment. The layout is read by ai_source, keep the offsets in sync with it:
+// magic 0, version 4, record size 8, capacity 12, write index 64, read index 128, records from 192.
+struct ShmRingHeader
+{
+	uint32_t _magic;
+	uint32_t _version;
+	uint32_t _recordSize;
+	uint32_t _capacity; // power of two
+	alignas(64) std::atomic<uint64_t> _writeIndex; // records ever pushed, slot = index & (capacity - 1)
+	alignas(64) std::atomic<uint64_t> _readIndex;  // records ever popped
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+static_assert(offsetof(ShmRingHeader, _writeIndex) == 64 && offsetof(ShmRingHeader, _readIndex) == 128);
+static_assert(sizeof(ShmRingHeader) == 192);
+
+// Lock-free single producer / single consumer ring of fixed size records living in a ShmSegment.
+// push() never blocks, when the consumer falls behind the oldest records are overwritten and pop()
+// skips past them. Use tryPush() when records must not be lost.
+//
+// Each side publishes its index with a release store after it's done with the records and loads
+// the other's with acquire, so a record is complete before the index that covers it is visible on
+// any CPU. A slot being rewritten is told apart like a seqlock: the write index that claims it is
+// visible before the new contents, and pop reads the write index again after copying.
+template <typename T>
+class ShmRing
+{
+	static_assert(std::is_trivially_copyable_v<T>);
+
+  public:
+	bool create(std::string_view name, uint32_t capacity, uint32_t magic, uint32_t version)
+	{
+		if (capacity < 2 || (capacity & (capacity - 1)) != 0)
+			return false;
+
+		if (!_segment.create(name, sizeof(ShmRingHeader) + sizeof(T) * capacity))
+			return false;
+
+		_header = new (_segment.data()) ShmRingHeader();
+		_header->_magic = magic;
+		_header->_version = version;
+		_header->_recordSize = sizeof(T);
+		_header->_capacity = capacity;
+		_header->_writeIndex.store(0, std::memory_order_relaxed);
+		_header->_readIndex.store(0, std::memory_order_release);
+		_records = reinterpret_cast<T*>(_header + 1);
+		return true;
+	}
+
+	bool open(std::string_view name, uint32_t magic, uint32_t version)
+	{
+		if (!_segment.open(name) || _segment.size() < sizeof(ShmRingHeader))
+			return false;
+
+		auto header = static_cast<ShmRingHeader*>(_segment.data());
+		if (header->_magic != magic || header->_version != version || header->_recordSize != sizeof(T) ||
+			_segment.size() < sizeof(ShmRingHeader) + sizeof(T) * header->_capacity)
+		{
+			_segment.close();
+			return false;
+		}
+
+		_header = header;
+		_records = reinterpret_cast<T*>(_header + 1);
+		return true;
+	}
+
+	void close()
+	{
+		_segment.close();
+		_header = nullptr;
+		_records = nullptr;
+	}
+
+	bool isOpen() const { return _header != nullptr; }
+
+	void push(const T& record)
+	{
+		uint64_t index = _header->_writeIndex.load(std::memory_order_relaxed);
+		// the previous push's index, which claims this slot from the record a lapped reader may be
+		// copying, has to be visible before any of the new contents
+		std::atomic_thread_fence(std::memory_order_release);
+		_records[index & (_header->_capacity - 1)] = record;
+		_header->_writeIndex.store(index + 1, std::memory_order_release);
+	}
+
+	bool tryPush(const T& record)
+	{
+		// one slot stays free, pop can't tell a full ring from one whose oldest slot is being rewritten
+		uint64_t index = _header->_writeIndex.load(std::memory_order_relaxed);
+		if (index - _header->_readIndex.load(std::memory_order_acquire) >= _header->_capacity - 1)
+			return false;
+
+		push(record);
+		return true;
+	}
+
+	bool pop(T& out)
+	{
+		uint64_t read = _header->_readIndex.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			uint64_t write = _header->_writeIndex.load(std::memory_order_acquire);
+			if (read == write)
+				return false;
+
+			// lapped by the producer, drop what was overwritten. The oldest slot left is the one the
+			// next push writes, so that goes too
+			if (write - read >= _header->_capacity)
+				read = write - _header->_capacity + 1;
+
+			out = _records[read & (_header->_capacity - 1)];
+
+			// the slot could have been rewritten while copying it, push starts on it once the write
+			// index is read + capacity
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (_header->_writeIndex.load(std::memory_order_relaxed) - read >= _header->_capacity)
+				continue;
+
+			_header->_readIndex.store(read + 1, std::memory_order_release);
+			return true;
+		}
+	}
+
+	uint64_t getWriteIndex() const { return _header->_writeIndex.load(std::memory_order_acquire); }
+
+  private:
+	ShmSegment _segment;
+	ShmRingHeader* _header = nullptr;
+	T* _records = nullptr;
+};
@@ -0,0 +1,97 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#include "TrainingOptions.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string_view>
+
+#include "GameToolbox/log.h"
+
+void TrainingOptions::parseCommandLine(int argc, char** argv)
+{
+	if (const char* obs = std::getenv("OPENGD_OBS_SHM"))
+		_observationShm = obs;
+	if (const char* input = std::getenv("OPENGD_INPUT_SHM"))
+		_inputShm = input;
+	if (const char* events = std::getenv("OPENGD_EVENT_SHM"))
+		_eventShm = events;
+	if (const char* summary = std::getenv("OPENGD_SUMMARY_FILE"))
+		_summaryFile = summary;
+	if (const char* levelCache = std::getenv("OPENGD_LEVEL_CACHE"))
+		_levelCacheDir = levelCache;
+	if (const char* replays = std::getenv("OPENGD_REPLAY_DIR"))
+		_replayDir = replays;
+	if (const char* genome = std::getenv("OPENGD_GENOME"))
+		_genomePath = genome;
+	if (const char* fixed = std::getenv("OPENGD_FIXED_TIMESTEP"))
+		_fixedTimestep = std::string_view(fixed) != "0";
+	if (const char* practice = std::getenv("OPENGD_PRACTICE"))
+		_practiceMode = std::string_view(practice) != "0";
+	if (const char* repeat = std::getenv("OPENGD_ACTION_REPEAT"))
+		_actionRepeat = std::max(1, std::atoi(repeat));
+	if (const char* seed = std::getenv("OPENGD_SEED"))
+		_seed = std::strtoull(seed, nullptr, 0);
+	if (const char* level = std::getenv("OPENGD_PLAY_LEVEL"))
+		_playLevel = std::atoi(level);
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string_view arg = argv[i];
+
+		if (arg == "--fixed-timestep")
+			_fixedTimestep = true;
+		else if (arg == "--fast-forward")
+			_fastForward = _fixedTimestep = true;
+		else if (arg == "--render-every" && i + 1 < argc)
+			_renderEvery = std::max(1, std::atoi(argv[++i]));
+		else if (arg == "--practice")
+			_practiceMode = true;
+		else if (arg == "--action-repeat" && i + 1 < argc)
+			_actionRepeat = std::max(1, std::atoi(argv[++i]));
+		else if (arg == "--seed" && i + 1 < argc)
+			_seed = std::strtoull(argv[++i], nullptr, 0);
+		else if (arg == "--obs-shm" && i + 1 < argc)
+			_observationShm = argv[++i];
+		else if (arg == "--input-shm" && i + 1 < argc)
+			_inputShm = argv[++i];
+		else if (arg == "--event-shm" && i + 1 < argc)
+			_eventShm = argv[++i];
+		else if (arg == "--summary-file" && i + 1 < argc)
+			_summaryFile = argv[++i];
+		else if (arg == "--level-cache" && i + 1 < argc)
+			_levelCacheDir = argv[++i];
+		else if (arg == "--fork-server" && i + 1 < argc)
+			_forkServer = argv[++i];
+		else if (arg == "--env-server" && i + 1 < argc)
+			_envServer = argv[++i];
+		else if (arg == "--level" && i + 1 < argc)
+			_levelID = std::atoi(argv[++i]);
+		else if (arg == "--play-level" && i + 1 < argc)
+			_playLevel = std::atoi(argv[++i]);
+		else if (arg == "--replay-dir" && i + 1 < argc)
+			_replayDir = argv[++i];
+		else if (arg == "--verify-replays" && i + 1 < argc)
+			_verifyReplays.push_back(argv[++i]);
+		else if (arg == "--genome" && i + 1 < argc)
+			_genomePath = argv[++i];
+		else
+			GameToolbox::log("ignoring unknown argument {}", arg);
+	}
+}
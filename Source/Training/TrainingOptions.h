@@ -0,0 +1,94 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Switches set by the trainer when it launches the game, read once at startup.
+// Everything defaults to the normal interactive behaviour.
+struct TrainingOptions
+{
+	// step the simulation in SimWorld::kTickRate fixed ticks instead of the frame delta,
+	// so the same inputs give the same run no matter how the frames were paced
+	bool _fixedTimestep = false;
+
+	// run as many ticks per rendered frame as _renderEvery asks for instead of following
+	// real time, with the frame rate uncapped. implies _fixedTimestep
+	bool _fastForward = false;
+
+	// in fast forward, 60 fps frames simulated for every frame drawn
+	int _renderEvery = 60;
+
+	// dying restarts from the newest practice checkpoint instead of the level start
+	bool _practiceMode = false;
+
+	// the policy picks an action every this many ticks and it is held in between, observations
+	// are only published on those ticks and when the attempt ends
+	int _actionRepeat = 1;
+
+	// SimWorld::_seed for every attempt, replays record it
+	uint64_t _seed = 0;
+
+	// shared memory ring to publish observations to, see ObservationChannel
+	std::string _observationShm;
+
+	// shared memory ring the trainer writes button input to, see InputChannel
+	std::string _inputShm;
+
+	// shared memory ring for deaths, completions and resets, see EventChannel
+	std::string _eventShm;
+
+	// file EpisodeSummaryLog appends one record per attempt to
+	std::string _summaryFile;
+
+	// where LevelCache keeps decompressed levels for every game process on the machine to map
+	std::string _levelCacheDir;
+
+	// run as a headless ForkServer listening on this unix socket instead of opening a window
+	std::string _forkServer;
+
+	// run as a headless EnvServer on this unix socket instead of opening a window
+	std::string _envServer;
+
+	// main level the fork server or env server preloads
+	int _levelID = 1;
+
+	// main level to open straight after loading instead of the menu, 0 for the menu
+	int _playLevel = 0;
+
+	// directory ReplayLog writes a replay of every fixed timestep attempt to
+	std::string _replayDir;
+
+	// check these replay files or directories with ReplayVerifier instead of opening a window
+	std::vector<std::string> _verifyReplays;
+
+	// genome exported by ai_source/genome_export.py, when set a NeatController plays instead of the keyboard
+	std::string _genomePath;
+
+	static TrainingOptions* getInstance()
+	{
+		static TrainingOptions instance;
+		return &instance;
+	}
+
+	// OPENGD_* environment variables first, then --flags on top of them
+	void parseCommandLine(int argc, char** argv);
+};
@@ -63,14 +63,14 @@ bool UILayer::init()
 bool UILayer::onTouchBegan(ax::Touch* touch, ax::Event* event)
 {
 	auto pl = PlayLayer::getInstance();
-	pl->_player1->pushButton();
-	if (pl->_isDualMode) pl->_player2->pushButton();
+	pl->_world->pushButton(0);
+	if (pl->_isDualMode) pl->_world->pushButton(1);
 	return true;
 }
 
 void UILayer::onTouchEnded(ax::Touch* touch, ax::Event* event)
 {
 	auto pl = PlayLayer::getInstance();
-	pl->_player1->releaseButton();
-	if (pl->_isDualMode) pl->_player2->releaseButton();
+	pl->_world->releaseButton(0);
+	if (pl->_isDualMode) pl->_world->releaseButton(1);
 }
\ No newline at end of file
@@ -0,0 +1,115 @@
+"""Client for the game's environment server (Source/Training/EnvServer.h)
+
+Start the server with `OpenGD --env-server <socket> --level <id>`, every EnvClient is one
+connection with its own batch of worlds. Observations are read from the shared memory segment
+the server creates on the first reset, nothing but actions and small replies go over the socket.
+"""
+import socket
+import struct
+from multiprocessing import shared_memory, resource_tracker
+
+REQUEST_RESET = 1
+REQUEST_STEP = 2
+REQUEST_BATCH_STEP = 3
+REQUEST_CLOSE = 4
+
+SHM_MAGIC = 0x56454750
+SHM_VERSION = 1
+SHM_HEADER = struct.Struct("<IIIIQ")
+SHM_DATA_OFFSET = 64
+
+SIZE = struct.Struct("<I")
+RESET = struct.Struct("<QiIIQ")
+RESET_REPLY = struct.Struct("<II")
+STEP_REPLY = struct.Struct("<fB")
+
+
+class EnvServerError(RuntimeError):
+    pass
+
+
+class EnvClient:
+    def __init__(self, socket_path, timeout=30.0):
+        self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self.sock.settimeout(timeout)
+        self.sock.connect(socket_path)
+        self.shm = None
+        self.count = 0
+        self.observation_size = 0
+
+    def _request(self, payload):
+        self.sock.sendall(SIZE.pack(len(payload)) + payload)
+        size = SIZE.unpack(self._read(SIZE.size))[0]
+        reply = self._read(size)
+        if reply[0] != 0:
+            raise EnvServerError(reply[1:].decode(errors="replace"))
+        return reply[1:]
+
+    def _read(self, size):
+        data = bytearray()
+        while len(data) < size:
+            chunk = self.sock.recv(size - len(data))
+            if not chunk:
+                raise EnvServerError("the server closed the connection")
+            data += chunk
+        return bytes(data)
+
+    def reset(self, seed=0, level=0, count=1, action_repeat=1, max_ticks=0):
+        """Start every world over, returns the observations. level 0 is the server's level"""
+        reply = self._request(bytes([REQUEST_RESET]) + RESET.pack(seed, level, count, action_repeat, max_ticks))
+        self.count, self.observation_size = RESET_REPLY.unpack_from(reply)
+        self._attach(reply[RESET_REPLY.size:].decode())
+        return self.observations()
+
+    def _attach(self, name):
+        if self.shm is not None:
+            if self.shm.name.lstrip("/") == name.lstrip("/") and self.shm.size >= self._segment_size():
+                return
+            self.shm.close()
+        self.shm = shared_memory.SharedMemory(name=name)
+        # the server owns the segment, don't let python unlink it on exit
+        try:
+            resource_tracker.unregister(self.shm._name, "shared_memory")
+        except Exception:
+            pass
+        magic, version, count, observation_size, _ = SHM_HEADER.unpack_from(self.shm.buf, 0)
+        if magic != SHM_MAGIC or version != SHM_VERSION or count != self.count:
+            raise EnvServerError(f"shared memory segment {name} has an unexpected layout")
+
+    def _segment_size(self):
+        return SHM_DATA_OFFSET + self.count * (self.observation_size * 4 + 5)
+
+    def step(self, action):
+        """One world only: returns (observation, reward, done)"""
+        reward, done = STEP_REPLY.unpack(self._request(bytes([REQUEST_STEP, 1 if action else 0])))
+        observation = self.shm.buf[SHM_DATA_OFFSET:SHM_DATA_OFFSET + self.observation_size * 4].cast("f")
+        return observation, reward, bool(done)
+
+    def batch_step(self, actions):
+        """One action per world, returns (observations, rewards, dones)"""
+        self._request(bytes([REQUEST_BATCH_STEP]) + bytes(1 if a else 0 for a in actions))
+        return self.observations(), self.rewards(), self.dones()
+
+    def observations(self):
+        """float32 view [count][observation size] of the segment, overwritten by the next step.
+        numpy.asarray() on it aliases the segment, release every view before close()"""
+        size = self.count * self.observation_size * 4
+        return self.shm.buf[SHM_DATA_OFFSET:SHM_DATA_OFFSET + size].cast("f", (self.count, self.observation_size))
+
+    def rewards(self):
+        start = SHM_DATA_OFFSET + self.count * self.observation_size * 4
+        return self.shm.buf[start:start + self.count * 4].cast("f")
+
+    def dones(self):
+        start = SHM_DATA_OFFSET + self.count * (self.observation_size * 4 + 4)
+        return self.shm.buf[start:start + self.count]
+
+    def close(self):
+        try:
+            self._request(bytes([REQUEST_CLOSE]))
+        except (OSError, EnvServerError):
+            pass
+        self.sock.close()
+        if self.shm is not None:
+            self.shm.close()
+            self.shm = None
@@ -0,0 +1,33 @@
+"""Reader for the game's episode summary file (Source/Training/EpisodeSummaryLog.h)
+
+The file is nothing but fixed size records appended one per attempt.
+"""
+import os
+import struct
+
+SUMMARY = struct.Struct("<QIiiffIHHB3x")
+FIELDS = ("ticks", "attempt", "death_object", "death_object_id", "max_x", "percentage",
+          "jumps", "orb_activations", "pad_activations", "outcome")
+OUTCOME_ABANDONED, OUTCOME_DIED, OUTCOME_COMPLETED = 0, 1, 2
+
+
+def summary_file_size(path):
+    """Where the next record will start, 0 if the game hasn't created the file yet"""
+    try:
+        return os.path.getsize(path)
+    except OSError:
+        return 0
+
+
+def read_summaries(path, offset=0):
+    """Every whole record from byte offset on as dicts, plus the offset to continue from"""
+    try:
+        with open(path, "rb") as f:
+            f.seek(offset)
+            data = f.read()
+    except OSError:
+        return [], offset
+
+    count = len(data) // SUMMARY.size
+    records = [dict(zip(FIELDS, values)) for values in SUMMARY.iter_unpack(data[:count * SUMMARY.size])]
+    return records, offset + count * SUMMARY.size
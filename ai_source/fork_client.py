@@ -0,0 +1,63 @@
+"""Client for the game's headless fork server (Source/Training/ForkServer.h)
+
+Start the server once with `OpenGD --fork-server <socket> --level <id>`, then every
+spawn_environment() call forks a worker playing that level in about a millisecond.
+"""
+import os
+import signal
+import socket
+
+
+def spawn_environment(socket_path, obs=None, input=None, events=None, summary=None, fast=False, practice=False,
+                      action_repeat=1, seed=0, timeout=5.0):
+    """Fork a worker with the given channel names, returns its pid once the channels exist"""
+    request = ["spawn"]
+    for key, value in (("obs", obs), ("input", input), ("events", events), ("summary", summary)):
+        if value:
+            request.append(f"{key}={value}")
+    request.append(f"fast={1 if fast else 0}")
+    request.append(f"practice={1 if practice else 0}")  # deaths restart from the newest checkpoint
+    request.append(f"repeat={action_repeat}")  # ticks between observations
+    request.append(f"seed={seed}")  # the simulation's random seed, recorded in replays
+
+    with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as sock:
+        sock.settimeout(timeout)
+        sock.connect(socket_path)
+        sock.sendall((" ".join(request) + "\n").encode())
+        reply = sock.makefile("r").readline().split()
+
+    if len(reply) != 2 or reply[0] != "ready":
+        raise RuntimeError(f"fork server refused to spawn: {' '.join(reply) or 'no reply'}")
+    return int(reply[1])
+
+
+def stop_environment(pid):
+    """Ask a worker to exit, it removes its shared memory on the way out"""
+    try:
+        os.kill(pid, signal.SIGTERM)
+    except ProcessLookupError:
+        pass
+
+
+class ForkedEnvironment:
+    """The subset of subprocess.Popen train.py uses, for a worker of the fork server"""
+
+    def __init__(self, pid):
+        self.pid = pid
+
+    def poll(self):
+        """None while the worker runs, 0 once it is gone"""
+        try:
+            os.kill(self.pid, 0)
+            return None
+        except ProcessLookupError:
+            return 0
+
+    def terminate(self):
+        stop_environment(self.pid)
+
+    def kill(self):
+        try:
+            os.kill(self.pid, signal.SIGKILL)
+        except ProcessLookupError:
+            pass
@@ -0,0 +1,35 @@
+"""Write a neat-python genome in the JSON form Source/Training/NeatNetwork.cpp loads"""
+import json
+
+
+def genome_to_dict(genome, genome_config):
+    return {
+        'key': genome.key,
+        'inputs': list(genome_config.input_keys),
+        'outputs': list(genome_config.output_keys),
+        'nodes': [
+            {
+                'key': key,
+                'bias': node.bias,
+                'response': node.response,
+                'activation': node.activation,
+                'aggregation': node.aggregation
+            }
+            for key, node in genome.nodes.items()
+        ],
+        # disabled genes are kept with their flag, the loader skips them like neat-python does
+        'connections': [
+            {'in': conn.key[0], 'out': conn.key[1], 'weight': conn.weight, 'enabled': conn.enabled}
+            for conn in genome.connections.values()
+        ]
+    }
+
+
+def genome_to_json(genome, genome_config):
+    """What export_genome writes, as a string for opengd_sim.evaluate"""
+    return json.dumps(genome_to_dict(genome, genome_config))
+
+
+def export_genome(genome, genome_config, path):
+    with open(path, 'w') as f:
+        json.dump(genome_to_dict(genome, genome_config), f)
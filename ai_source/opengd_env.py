@@ -0,0 +1,91 @@
+"""Many headless attempts in this process through the opengd_sim extension (proj.python)
+
+Build it with `cmake -S proj.python -B build-python && cmake --build build-python`, then put the
+build directory on PYTHONPATH or set OPENGD_SIM_PATH. Every array a VecEnv hands out is a view of
+the simulator's own memory, it changes in place on every step and is never copied.
+"""
+import base64
+import json
+import os
+import sys
+import zlib
+
+import numpy as np
+
+CONTENT_DIR = os.environ.get("OPENGD_CONTENT", os.path.join(os.path.dirname(__file__), "..", "Content"))
+
+if os.environ.get("OPENGD_SIM_PATH"):
+    sys.path.insert(0, os.environ["OPENGD_SIM_PATH"])
+import opengd_sim  # noqa: E402
+
+_main_levels = None
+
+
+def load_main_level(level_id):
+    """The uncompressed level string of a main level, decoded like LevelCache::getMainLevel"""
+    global _main_levels
+    if _main_levels is None:
+        with open(os.path.join(CONTENT_DIR, "Custom", "mainLevels.json")) as f:
+            _main_levels = json.load(f)
+
+    # the file leaves out the gzip header every level starts with
+    data = "H4sIAAAAAAAAA" + _main_levels[str(level_id)]
+    data += "=" * (-len(data) % 4)
+    return zlib.decompress(base64.urlsafe_b64decode(data), 15 + 32)
+
+
+def load_object_types():
+    with open(os.path.join(CONTENT_DIR, "Custom", "object.json"), "rb") as f:
+        return f.read()
+
+
+def evaluate_genomes(level, genomes, genome_config, max_ticks, threads=0, action_repeat=1):
+    """Furthest x of one attempt per neat-python genome, played in process by NeatController
+
+    level is a main level id or an uncompressed level string. The inputs are the ones
+    prepare_inputs in train.py builds, so the fitness matches a run through the game.
+    """
+    from genome_export import genome_to_json
+
+    if isinstance(level, int):
+        level = load_main_level(level)
+    texts = [genome_to_json(genome, genome_config) for genome in genomes]
+    return opengd_sim.evaluate(load_object_types(), level, texts, max_ticks, threads, action_repeat)
+
+
+class VecEnv:
+    """count attempts at one level stepped together, the GIL is released while they run
+
+    observations is float32 [count, observation_size], rewards float32 [count] (x gained during the
+    last step) and dones bool [count]. Worlds that are done start over on the next step. With
+    grids=True, grids is uint8 [count, 16, 32], the occupancy around each player (see Simulator.grids).
+    """
+
+    def __init__(self, level, count, threads=0, action_repeat=1, max_ticks=0, seed=0, grids=False):
+        self.sim = opengd_sim.Simulator(load_object_types(), count, threads, action_repeat, max_ticks, grids)
+        self.observations = np.asarray(self.sim.observations)
+        self.rewards = np.asarray(self.sim.rewards)
+        self.dones = np.asarray(self.sim.dones)
+        self.grids = np.asarray(self.sim.grids) if grids else None
+        self.actions = np.zeros(count, dtype=np.uint8)
+        self.reset(seed, level)
+
+    @property
+    def count(self):
+        return self.sim.count
+
+    def reset(self, seed=0, level=None):
+        """level is a main level id or an uncompressed level string, None keeps the current one"""
+        if isinstance(level, int):
+            level = load_main_level(level)
+        self.sim.reset(seed, level)
+        return self.observations
+
+    def step(self, actions=None):
+        """actions: one value per world, non zero holds the button. None steps with self.actions"""
+        if actions is None:
+            actions = self.actions
+        elif not isinstance(actions, np.ndarray) or actions.dtype != np.uint8:
+            actions = np.asarray(actions, dtype=np.uint8)
+        self.sim.step(actions)
+        return self.observations, self.rewards, self.dones
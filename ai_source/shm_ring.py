@@ -0,0 +1,142 @@
+"""Python side of the game's shared memory rings (Source/Training/ShmRing.h)
+
+Header layout: magic 0, version 4, record size 8, capacity 12, write index 64,
+read index 128, records from 192. The game creates and owns every segment.
+
+Ordering contract, the same as ShmRing.h: a producer writes the record and then
+publishes the write index with a release store, a consumer loads the write index
+with acquire, copies the record and loads the write index again to catch a slot
+rewritten underneath it, then publishes the read index with a release store.
+Every index access here is one aligned 8 byte copy and CPython does them and
+the record copies in program order, but it has no fences. x86's ordering makes
+plain stores and loads release and acquire, weakly ordered CPUs like ARM don't,
+so these rings are only safe to use from Python on x86.
+"""
+import os
+import platform
+import select
+import struct
+import time
+import warnings
+from multiprocessing import shared_memory, resource_tracker
+
+HEADER = struct.Struct("<IIII")
+INDEX = struct.Struct("<Q")
+WRITE_INDEX_OFFSET = 64
+READ_INDEX_OFFSET = 128
+RECORDS_OFFSET = 192
+# plain loads and stores are acquire and release on these, see the ordering contract above
+ORDERED_MACHINES = ("x86_64", "amd64", "i386", "i686", "x86")
+
+
+class ShmRing:
+    def __init__(self, name, magic, version, record):
+        self.name = name
+        self.magic = magic
+        self.version = version
+        self.record = record
+        self.shm = None
+        self.capacity = 0
+
+    def attach(self):
+        """Map the ring once the game has created it, returns False until then"""
+        if self.shm is not None:
+            return True
+        try:
+            shm = shared_memory.SharedMemory(name=self.name)
+        except FileNotFoundError:
+            return False
+        # the game owns the segment, don't let python unlink it on exit
+        try:
+            resource_tracker.unregister(shm._name, "shared_memory")
+        except Exception:
+            pass
+        magic, version, record_size, capacity = HEADER.unpack_from(shm.buf, 0)
+        if magic != self.magic or version != self.version or record_size != self.record.size:
+            shm.close()
+            raise ValueError(f"shared memory ring {self.name} has an unexpected layout")
+        self.shm = shm
+        self.capacity = capacity
+        if platform.machine().lower() not in ORDERED_MACHINES:
+            warnings.warn(f"shared memory ring {self.name}: {platform.machine()} doesn't order plain "
+                          "loads and stores, records may be read before they are complete")
+        return True
+
+    def close(self):
+        if self.shm is not None:
+            self.shm.close()
+            self.shm = None
+
+    def _load(self, offset):
+        return INDEX.unpack_from(self.shm.buf, offset)[0]
+
+    def _slot(self, index):
+        return RECORDS_OFFSET + (index & (self.capacity - 1)) * self.record.size
+
+    def latest(self):
+        """Newest record as a tuple, None if nothing was written yet or it got overwritten while reading"""
+        write_index = self._load(WRITE_INDEX_OFFSET)
+        if write_index == 0:
+            return None
+        values = self.record.unpack_from(self.shm.buf, self._slot(write_index - 1))
+        # the game starts rewriting the slot once its write index is write_index - 1 + capacity
+        if self._load(WRITE_INDEX_OFFSET) - (write_index - 1) >= self.capacity:
+            return None
+        return values
+
+    def pop(self):
+        """Oldest unread record as a tuple, None when the ring is empty"""
+        read_index = self._load(READ_INDEX_OFFSET)
+        while True:
+            write_index = self._load(WRITE_INDEX_OFFSET)
+            if read_index == write_index:
+                return None
+            # lapped, the oldest slot left is the one the next push writes so it goes too
+            if write_index - read_index >= self.capacity:
+                read_index = write_index - self.capacity + 1
+            values = self.record.unpack_from(self.shm.buf, self._slot(read_index))
+            if self._load(WRITE_INDEX_OFFSET) - read_index >= self.capacity:
+                continue
+            INDEX.pack_into(self.shm.buf, READ_INDEX_OFFSET, read_index + 1)
+            return values
+
+    def try_push(self, *values):
+        """Append a record, False if the game hasn't consumed enough to make room"""
+        write_index = self._load(WRITE_INDEX_OFFSET)
+        # one slot stays free, like ShmRing::tryPush
+        if write_index - self._load(READ_INDEX_OFFSET) >= self.capacity - 1:
+            return False
+        self.record.pack_into(self.shm.buf, self._slot(write_index), *values)
+        INDEX.pack_into(self.shm.buf, WRITE_INDEX_OFFSET, write_index + 1)
+        return True
+
+
+class WakeFifo:
+    """The fifo the game's EventChannel writes a byte to for every event, /tmp/<name>.wake"""
+
+    def __init__(self, name):
+        self.path = os.path.join("/tmp", name.lstrip("/") + ".wake")
+        self.fd = None
+
+    def wait(self, timeout):
+        """Sleep until the game publishes an event or timeout seconds pass, plain sleep without the fifo"""
+        if self.fd is None:
+            try:
+                self.fd = os.open(self.path, os.O_RDONLY | os.O_NONBLOCK)
+            except (OSError, AttributeError):
+                time.sleep(timeout)
+                return
+        readable, _, _ = select.select([self.fd], [], [], timeout)
+        if readable:
+            try:
+                if not os.read(self.fd, 4096):
+                    # the game closed the fifo, open it again next time
+                    self.close()
+                    time.sleep(timeout)
+            except BlockingIOError:
+                pass
+
+    def close(self):
+        if self.fd is not None:
+            os.close(self.fd)
+            self.fd = None
@@ -1,26 +1,19 @@
 import neat
 import json
 import os
-import numpy as np
-import cv2
-import mss
-import pyautogui
 import time
 import subprocess
-import multiprocessing as mp
 import pickle
 import psutil
-import ctypes
-import sys
 import platform
-import win32gui
-import win32con
-import win32api
 import logging
+import struct
 from collections import deque
 from datetime import datetime
-import win32ui
-from PIL import Image
+from shm_ring import ShmRing, WakeFifo
+from genome_export import export_genome
+from episode_summary import read_summaries, summary_file_size
+from fork_client import ForkedEnvironment, spawn_environment
 
 # Set up logging
 log_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)), "logs")
@@ -38,15 +31,8 @@ logging.basicConfig(
 )
 logger = logging.getLogger("OpenGD_AI")
 
-# Platform-specific imports
-IS_WINDOWS = platform.system() == 'Windows'
-if IS_WINDOWS:
-    import win32gui
-    import win32con
-    import win32api
-    logger.info("Running on Windows platform")
-else:
-    logger.info(f"Running on {platform.system()} platform")
+# The game is driven through the shared memory channels only, no window or key events
+logger.info(f"Running on {platform.system()} platform")
 
 # Load config file
 SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
@@ -68,14 +54,30 @@ else:
     GAME_PATH = os.path.abspath(os.path.join(SCRIPT_DIR, "..", config["game_path"]))
 logger.info(f"Game path: {GAME_PATH}")
 
-# Define the position file path based on platform
-if platform_name == 'windows':
-    app_data = os.getenv('LOCALAPPDATA')
-    POSITION_FILE = os.path.join(app_data, "OpenGD", "player_position.txt")
-else:  # macOS/Linux
-    home = os.path.expanduser("~")
-    POSITION_FILE = os.path.join(home, ".OpenGD", "player_position.txt")
-logger.info(f"Position file path: {POSITION_FILE}")
+# Shared memory rings the game publishes player state into and reads button input from
+# (Source/Training/ObservationChannel.h, Source/Training/InputChannel.h)
+OBS_SHM_NAME = f"opengd_obs_{os.getpid()}"
+INPUT_SHM_NAME = f"opengd_input_{os.getpid()}"
+EVENT_SHM_NAME = f"opengd_events_{os.getpid()}"
+SUMMARY_FILE = os.path.join(log_dir, "episodes.bin")  # one record per attempt, see episode_summary.py
+LEVEL_CACHE_DIR = os.path.join(SCRIPT_DIR, "level_cache")  # decompressed levels shared by every game we launch
+# socket of an already running `OpenGD --fork-server <socket> --level <id>`. When set every genome gets a
+# headless environment forked from it instead of a freshly launched game, no window or menus involved
+FORK_SERVER_SOCKET = config.get("fork_server")
+# simulation ticks every decision is held for, the game only publishes an observation every this many
+# ticks (and on death), so the network runs that much less often
+ACTION_REPEAT = max(1, int(config.get("action_repeat", 1)))
+SEED = int(config.get("seed", 0))  # every attempt of every genome plays the same simulation
+LEVEL_ID = int(config.get("level", 1))  # main level the game opens straight into, no menus to click through
+OBS_RAYS = 8  # each ray: distance, then one hot solid/hazard/pad/ring/portal (Source/Simulation/SimRaycaster.h)
+observations = ShmRing(OBS_SHM_NAME, 0x4F44474F, 2, struct.Struct(f"<QfffBBBB{OBS_RAYS * 6}f"))  # frame, x, y, y_vel, on_ground, dead, gamemode, player, rays
+inputs = ShmRing(INPUT_SHM_NAME, 0x4F444749, 2, struct.Struct("<QBBBxf"))  # tick, player, press, command, value
+# InputCommand in Source/Training/InputChannel.h
+COMMAND_BUTTON, COMMAND_SAVE_CHECKPOINT, COMMAND_START_FROM_CHECKPOINT, COMMAND_START_FROM_X, COMMAND_CLEAR_CHECKPOINTS = range(5)
+events = ShmRing(EVENT_SHM_NAME, 0x4F444745, 1, struct.Struct("<QIiffBB6x"))  # tick, attempt, object, x, percentage, type, player
+event_wake = WakeFifo(EVENT_SHM_NAME)
+EVENT_RESET, EVENT_DEATH, EVENT_COMPLETE, EVENT_CHECKPOINT = 0, 1, 2, 3  # EpisodeEventType in Source/Training/EventChannel.h
+logger.info(f"Observation channel: {OBS_SHM_NAME}, input channel: {INPUT_SHM_NAME}, event channel: {EVENT_SHM_NAME}")
 
 # Constants
 MAX_GENERATIONS = 100
@@ -90,33 +92,92 @@ genome_data_dir = os.path.join(log_dir, "genome_data")
 os.makedirs(genome_data_dir, exist_ok=True)
 
 def get_player_position():
-    """Read player position from the file written by the game"""
+    """Read the newest player state from the game's observation ring"""
     try:
-        # Check if file exists
-        if not os.path.exists(POSITION_FILE):
+        if not observations.attach():
             return None
-            
-        # Read the file
-        with open(POSITION_FILE, 'r') as f:
-            data = f.read().strip()
-            
-        # Parse the data
-        if data:
-            parts = data.split(',')
-            if len(parts) >= 5:
-                x, y, y_vel, on_ground, is_dead = parts[:5]
-                return {
-                    'x': float(x),
-                    'y': float(y),
-                    'y_vel': float(y_vel),
-                    'on_ground': bool(int(on_ground)),
-                    'is_dead': bool(int(is_dead))
-                }
-        return None
+
+        record = observations.latest()
+        if record is None:
+            return None
+
+        frame, x, y, y_vel, on_ground, is_dead, gamemode, player = record[:8]
+        return {
+            'x': x,
+            'y': y,
+            'y_vel': y_vel,
+            'on_ground': bool(on_ground),
+            'is_dead': bool(is_dead),
+            'gamemode': gamemode,
+            'frame': frame,
+            'rays': record[8:]
+        }
     except Exception as e:
         logger.error(f"Error reading player position: {e}")
         return None
 
+def send_button(press, tick, player=0):
+    """Press or release the jump button at an exact simulation tick"""
+    try:
+        if not inputs.attach():
+            return False
+        if not inputs.try_push(tick, player, 1 if press else 0, COMMAND_BUTTON, 0.0):
+            logger.warning("Input channel full, button event dropped")
+            return False
+        return True
+    except Exception as e:
+        logger.error(f"Error sending input: {e}")
+        return False
+
+def send_command(command, value=0.0, tick=0):
+    """Queue a checkpoint command, run once the simulation reaches tick (0 = right away)"""
+    try:
+        if not inputs.attach():
+            return False
+        if not inputs.try_push(tick, 0, 0, command, float(value)):
+            logger.warning("Input channel full, command dropped")
+            return False
+        return True
+    except Exception as e:
+        logger.error(f"Error sending command: {e}")
+        return False
+
+def save_checkpoint(tick=0):
+    """Keep the game's current state, it answers with an EVENT_CHECKPOINT holding the index"""
+    return send_command(COMMAND_SAVE_CHECKPOINT, tick=tick)
+
+def start_from_checkpoint(index=-1):
+    """Start a new attempt from a saved checkpoint (negative counts back from the newest), skipping
+    everything before it. The game answers with an EVENT_RESET at the checkpoint's tick"""
+    return send_command(COMMAND_START_FROM_CHECKPOINT, index)
+
+def start_from_x(x):
+    """Start a new attempt at x, with the portals and speed changes before it already applied"""
+    return send_command(COMMAND_START_FROM_X, x)
+
+def next_episode_event():
+    """Oldest unread death, completion or reset from the game, None if there is none"""
+    try:
+        if not events.attach():
+            return None
+        record = events.pop()
+        if record is None:
+            return None
+
+        tick, attempt, obj, x, percentage, event_type, player = record
+        return {
+            'tick': tick,
+            'attempt': attempt,
+            'object': obj,
+            'x': x,
+            'percentage': percentage,
+            'type': event_type,
+            'player': player
+        }
+    except Exception as e:
+        logger.error(f"Error reading episode events: {e}")
+        return None
+
 def update_position_history(position):
     """Add new position to history"""
     if position is not None:
@@ -127,9 +188,9 @@ def prepare_inputs():
     if len(position_history) < 2:
         return None
         
-    # Get current and previous positions
-    current = position_history[0]
-    prev = position_history[1]
+    # Get current and previous positions (newest is appended last)
+    current = position_history[-1]
+    prev = position_history[-2]
     
     # Calculate velocity
     dx = current['x'] - prev['x']
@@ -145,6 +206,7 @@ def prepare_inputs():
         dy / 10.0,  # y velocity
         1.0 if current['is_dead'] else 0.0  # Death state
     ]
+    inputs.extend(current['rays'])  # what is ahead of the player
     
     return inputs
 
@@ -236,6 +298,9 @@ def terminate_all_game_processes():
 
 def start_game():
     """Start the OpenGD game after ensuring no other instances are running"""
+    if FORK_SERVER_SOCKET:
+        return start_forked_environment()
+
     # First terminate any existing game processes
     logger.info("Terminating any existing OpenGD processes before starting new game...")
     terminate_all_game_processes()
@@ -255,7 +320,16 @@ def start_game():
         
         # Start the game using just the executable name
         logger.info(f"Launching executable: {executable}")
-        game_process = subprocess.Popen(executable, shell=True)
+        observations.close()
+        inputs.close()
+        events.close()
+        event_wake.close()
+        env = dict(os.environ, OPENGD_OBS_SHM=OBS_SHM_NAME, OPENGD_INPUT_SHM=INPUT_SHM_NAME,
+                   OPENGD_EVENT_SHM=EVENT_SHM_NAME, OPENGD_SUMMARY_FILE=SUMMARY_FILE,
+                   OPENGD_LEVEL_CACHE=LEVEL_CACHE_DIR, OPENGD_FIXED_TIMESTEP="1",
+                   OPENGD_ACTION_REPEAT=str(ACTION_REPEAT), OPENGD_SEED=str(SEED),
+                   OPENGD_PLAY_LEVEL=str(LEVEL_ID))
+        game_process = subprocess.Popen(executable, shell=True, env=env)
         logger.info(f"Game process started with PID: {game_process.pid if hasattr(game_process, 'pid') else 'unknown'}")
         
         logger.info("Waiting 5 seconds for game to initialize...")
@@ -278,30 +352,21 @@ def start_game():
             logger.error(f"Failed to change back to original directory: {dir_error}")
         return None
 
-def press_space():
-    """Press the space key using win32api"""
-    try:
-        # Key down
-        win32api.keybd_event(0x20, 0, 0, 0)  # 0x20 is the virtual key code for SPACE
-        time.sleep(0.05)
-        # Key up
-        win32api.keybd_event(0x20, 0, win32con.KEYEVENTF_KEYUP, 0)
-        logger.debug("Space key pressed using win32api")
-    except Exception as e:
-        logger.error(f"Failed to press space key: {e}")
-
-def reset_game():
-    """Reset the game by pressing R"""
+def start_forked_environment():
+    """Fork a headless environment from the fork server, up in milliseconds"""
+    observations.close()
+    inputs.close()
+    events.close()
+    event_wake.close()
     try:
-        # Key down
-        win32api.keybd_event(0x52, 0, 0, 0)  # 0x52 is the virtual key code for R
-        time.sleep(0.05)
-        # Key up
-        win32api.keybd_event(0x52, 0, win32con.KEYEVENTF_KEYUP, 0)
-        time.sleep(1)  # Wait for reset
-        logger.debug("Game reset using R key")
+        pid = spawn_environment(FORK_SERVER_SOCKET, obs=OBS_SHM_NAME, input=INPUT_SHM_NAME,
+                                events=EVENT_SHM_NAME, summary=SUMMARY_FILE, action_repeat=ACTION_REPEAT,
+                                seed=SEED)
+        logger.info(f"Forked environment with PID: {pid}")
+        return ForkedEnvironment(pid)
     except Exception as e:
-        logger.error(f"Failed to reset game: {e}")
+        logger.error(f"Failed to fork an environment: {e}")
+        return None
 
 def log_decision(inputs, output, should_jump, position):
     """Log neural network decision details for debugging"""
@@ -310,109 +375,6 @@ def log_decision(inputs, output, should_jump, position):
         logger.debug(f"Network inputs: {inputs}")
         logger.debug(f"Network output: {output[0]:.4f}, Decision: {'JUMP' if should_jump else 'NO JUMP'}")
 
-def capture_window_image(hwnd):
-    """Capture a screenshot of the specified window"""
-    try:
-        # Get window dimensions
-        left, top, right, bottom = win32gui.GetWindowRect(hwnd)
-        width = right - left
-        height = bottom - top
-        
-        # Create device context
-        hwnd_dc = win32gui.GetWindowDC(hwnd)
-        mfc_dc = win32ui.CreateDCFromHandle(hwnd_dc)
-        save_dc = mfc_dc.CreateCompatibleDC()
-        
-        # Create bitmap
-        save_bitmap = win32ui.CreateBitmap()
-        save_bitmap.CreateCompatibleBitmap(mfc_dc, width, height)
-        save_dc.SelectObject(save_bitmap)
-        
-        # Copy screen to bitmap
-        save_dc.BitBlt((0, 0), (width, height), mfc_dc, (0, 0), win32con.SRCCOPY)
-        
-        # Convert to numpy array
-        bmpinfo = save_bitmap.GetInfo()
-        bmpstr = save_bitmap.GetBitmapBits(True)
-        img = np.frombuffer(bmpstr, dtype=np.uint8)
-        img.shape = (bmpinfo['bmHeight'], bmpinfo['bmWidth'], 4)
-        img = img[:, :, :3]  # Remove alpha channel
-        
-        # Clean up
-        win32gui.DeleteObject(save_bitmap.GetHandle())
-        save_dc.DeleteDC()
-        mfc_dc.DeleteDC()
-        win32gui.ReleaseDC(hwnd, hwnd_dc)
-        
-        return img
-    except Exception as e:
-        logger.error(f"Error capturing window image: {e}")
-        return None
-
-def is_death_detected(hwnd, num_frames=8, similarity_threshold=0.999):
-    """Detect death by checking for freeze frames"""
-    frames = []
-    
-    # Capture initial frames
-    for _ in range(num_frames):
-        img = capture_window_image(hwnd)
-        if img is None:
-            return False
-        frames.append(img)
-        time.sleep(0.05)  # Small delay between captures
-    
-    # Calculate similarity between consecutive frames
-    similarities = []
-    for i in range(1, len(frames)):
-        # Convert to grayscale for simpler comparison
-        prev_gray = cv2.cvtColor(frames[i-1], cv2.COLOR_BGR2GRAY)
-        curr_gray = cv2.cvtColor(frames[i], cv2.COLOR_BGR2GRAY)
-        
-        # Calculate similarity (normalized cross-correlation)
-        result = cv2.matchTemplate(prev_gray, curr_gray, cv2.TM_CCORR_NORMED)
-        similarity = result[0][0]
-        similarities.append(similarity)
-    
-    # Check if all similarities are above threshold
-    all_similar = all(sim >= similarity_threshold for sim in similarities)
-    
-    if all_similar:
-        logger.info(f"Death detected - screen frozen for {num_frames} frames")
-        return True
-    
-    return False
-
-def find_game_window():
-    """Find the OpenGD window with more robust detection"""
-    try:
-        # Try different possible window titles
-        window_titles = ["OpenGD", "OpenGD - Geometry Dash", "Geometry Dash"]
-        
-        for title in window_titles:
-            hwnd = win32gui.FindWindow(None, title)
-            if hwnd != 0:
-                logger.info(f"Found game window with title: {title}")
-                return hwnd
-                
-        # If not found by title, try finding by class
-        def callback(hwnd, hwnds):
-            if win32gui.IsWindowVisible(hwnd) and "OpenGD" in win32gui.GetWindowText(hwnd):
-                hwnds.append(hwnd)
-            return True
-            
-        hwnds = []
-        win32gui.EnumWindows(callback, hwnds)
-        
-        if hwnds:
-            logger.info(f"Found game window by partial title match")
-            return hwnds[0]
-            
-        logger.error("Game window not found")
-        return 0
-    except Exception as e:
-        logger.error(f"Error finding game window: {e}")
-        return 0
-
 def evaluate_genomes(genomes, config):
     """Evaluate the fitness of each genome"""
     for genome_id, genome in genomes:
@@ -428,6 +390,7 @@ def evaluate_genomes(genomes, config):
         
         # Start game process (this will terminate any existing games)
         logger.info(f"Starting game for genome {genome_id}...")
+        summary_offset = summary_file_size(SUMMARY_FILE)
         game_process = start_game()
         if game_process is None:
             logger.error("Failed to start game")
@@ -437,40 +400,14 @@ def evaluate_genomes(genomes, config):
         logger.info(f"Game process info: {game_process}")
             
         try:
-            # Navigate menus
-            logger.info("Attempting to click play button...")
-            if not click_play():
-                logger.error("Failed to enter play mode")
-                genome.fitness = 0
-                continue
-                
-            logger.info("Attempting to click level...")
-            if not click_level():
-                logger.error("Failed to select level")
-                genome.fitness = 0
-                continue
-            
-            # Get window handle for death detection
-            logger.info("Finding game window for death detection...")
-            hwnd = find_game_window()
-            if hwnd == 0:
-                logger.error("Could not find game window for death detection")
-                genome.fitness = 0
-                continue
-            logger.info(f"Found game window with handle: {hwnd}")
-            
             # Clear position history
             position_history.clear()
             logger.info("Cleared position history")
             
             # Initialize timing variables
             start_time = time.time()
-            last_jump_time = 0
-            
-            # Initialize frame comparison variables
-            prev_frame = None
-            similar_frames_count = 0
-            similarity_threshold = 0.999
+            holding = False
+            last_frame = None
             
             logger.info("Starting main game loop...")
             # Main game loop
@@ -481,12 +418,29 @@ def evaluate_genomes(genomes, config):
                 if elapsed > TIMEOUT_SECONDS:
                     logger.info(f"Timeout reached for genome {genome_id} after {elapsed:.2f} seconds")
                     break
+
+                # The game says when the attempt is over, resets are just the level starting
+                event = next_episode_event()
+                if event is not None and event['type'] == EVENT_DEATH:
+                    max_x = max(max_x, event['x'])
+                    logger.info(f"Player died at x={event['x']:.2f} ({event['percentage']:.1f}%) on tick {event['tick']}")
+                    break
+                if event is not None and event['type'] == EVENT_COMPLETE:
+                    max_x = max(max_x, event['x'])
+                    logger.info(f"Level completed on tick {event['tick']}")
+                    break
                     
                 # Get player position
                 position = get_player_position()
                 if position is None:
-                    time.sleep(0.05)
+                    event_wake.wait(0.05)
+                    continue
+
+                # nothing new since the last decision, the game publishes once every ACTION_REPEAT ticks
+                if position['frame'] == last_frame:
+                    time.sleep(0.001)
                     continue
+                last_frame = position['frame']
                     
                 # Update history
                 update_position_history(position)
@@ -496,30 +450,6 @@ def evaluate_genomes(genomes, config):
                     logger.info(f"Player death detected from position data at x={position['x']:.2f}")
                     break
                 
-                # Capture current frame for death detection
-                current_frame = capture_window_image(hwnd)
-                if current_frame is not None and prev_frame is not None:
-                    # Convert to grayscale for simpler comparison
-                    prev_gray = cv2.cvtColor(prev_frame, cv2.COLOR_BGR2GRAY)
-                    curr_gray = cv2.cvtColor(current_frame, cv2.COLOR_BGR2GRAY)
-                    
-                    # Calculate similarity (normalized cross-correlation)
-                    result = cv2.matchTemplate(prev_gray, curr_gray, cv2.TM_CCORR_NORMED)
-                    similarity = result[0][0]
-                    
-                    # Check for frozen frames (indicating death)
-                    if similarity >= similarity_threshold:
-                        similar_frames_count += 1
-                        if similar_frames_count >= 8:  # 8 consecutive similar frames
-                            logger.info(f"Death detected - screen frozen for {similar_frames_count} frames (similarity: {similarity:.6f})")
-                            break
-                    else:
-                        # Reset counter if frames are different
-                        similar_frames_count = 0
-                
-                # Update previous frame
-                prev_frame = current_frame
-                
                 # Update max_x for fitness
                 if position['x'] > max_x:
                     max_x = position['x']
@@ -535,16 +465,15 @@ def evaluate_genomes(genomes, config):
                 # Decide whether to jump
                 should_jump = output[0] > 0.5
                 
-                # Execute jump if needed (with cooldown to prevent spam)
-                if should_jump and current_time - last_jump_time > 0.2:
-                    win32api.keybd_event(win32con.VK_SPACE, 0, 0, 0)  # Space down
-                    time.sleep(0.05)
-                    win32api.keybd_event(win32con.VK_SPACE, 0, win32con.KEYEVENTF_KEYUP, 0)  # Space up
-                    jumps += 1
-                    last_jump_time = current_time
-                    logger.debug(f"Jump executed at x={position['x']:.2f}, y={position['y']:.2f}")
+                # Hold the button for as long as the network wants to jump, applied on the
+                # tick right after the one it saw
+                if should_jump != holding and send_button(should_jump, position['frame']):
+                    holding = should_jump
+                    if should_jump:
+                        jumps += 1
+                        logger.debug(f"Jump executed at x={position['x']:.2f}, y={position['y']:.2f}")
                 
-                time.sleep(0.05)  # Small delay to prevent CPU overuse
+                event_wake.wait(0.05)  # Small delay to prevent CPU overuse, cut short by a death
                 
         except Exception as e:
             logger.error(f"Error during evaluation of genome {genome_id}: {e}")
@@ -559,7 +488,7 @@ def evaluate_genomes(genomes, config):
                     logger.info(f"Terminating game process with PID: {game_process.pid if hasattr(game_process, 'pid') else 'unknown'}")
                     game_process.terminate()
                     logger.info("Game process terminate() called")
-                    time.sleep(1)
+                    time.sleep(0.05 if FORK_SERVER_SOCKET else 1)
                     
                     # Check if process is still running
                     if hasattr(game_process, 'poll'):
@@ -571,14 +500,25 @@ def evaluate_genomes(genomes, config):
                         else:
                             logger.info(f"Game process terminated with exit code: {exit_code}")
                 
-                # Then make sure all OpenGD processes are terminated
-                logger.info("Ensuring all OpenGD processes are terminated...")
-                terminate_all_game_processes()
+                # Then make sure all OpenGD processes are terminated, except the fork server
+                if not FORK_SERVER_SOCKET:
+                    logger.info("Ensuring all OpenGD processes are terminated...")
+                    terminate_all_game_processes()
             except Exception as e:
                 logger.error(f"Error terminating game processes: {e}")
                 import traceback
                 logger.error(f"Traceback: {traceback.format_exc()}")
         
+        # The game's own record of the attempt is exact, the sampled positions can miss the last ticks
+        summaries, _ = read_summaries(SUMMARY_FILE, summary_offset)
+        if summaries:
+            summary = summaries[0]
+            max_x = max(max_x, summary['max_x'])
+            jumps = summary['jumps']
+            logger.info(f"  - Episode: {summary['ticks']} ticks, {summary['percentage']:.1f}%, "
+                        f"{summary['orb_activations']} orbs, {summary['pad_activations']} pads, "
+                        f"killed by object {summary['death_object_id']}")
+
         # Calculate fitness
         fitness = max_x
         
@@ -657,6 +597,9 @@ def run_neat():
         # Also save a copy in the main directory
         with open("best_ai.pkl", "wb") as f:
             pickle.dump(winner, f)
+
+        # and in the form the game's native evaluator loads (--genome)
+        export_genome(winner, config.genome_config, "best_ai.json")
             
         logger.info(f"Training complete! Best genome saved to {winner_file}")
         
@@ -672,70 +615,6 @@ def run_neat():
         logger.error(f"Error during NEAT evolution: {e}")
         raise
 
-def click_play():
-    """Click the play button in the middle of the OpenGD window"""
-    try:
-        # Find the OpenGD window
-        hwnd = win32gui.FindWindow(None, "OpenGD")
-        if hwnd == 0:
-            logger.error("OpenGD window not found")
-            return False
-            
-        # Get window dimensions
-        rect = win32gui.GetWindowRect(hwnd)
-        width = rect[2] - rect[0]
-        height = rect[3] - rect[1]
-        
-        # Calculate center position
-        center_x = rect[0] + width // 2
-        center_y = rect[1] + height // 2
-        
-        # Click at center (play button)
-        win32api.SetCursorPos((center_x, center_y))
-        win32api.mouse_event(win32con.MOUSEEVENTF_LEFTDOWN, 0, 0, 0, 0)
-        time.sleep(0.1)
-        win32api.mouse_event(win32con.MOUSEEVENTF_LEFTUP, 0, 0, 0, 0)
-        
-        logger.info(f"Clicked play button at ({center_x}, {center_y})")
-        time.sleep(1)  # Wait for menu transition
-        
-    except Exception as e:
-        logger.error(f"Failed to click play button: {e}")
-        return False
-    return True
-
-def click_level(level_number=1):
-    """Click the level button in the middle-top area of the OpenGD window"""
-    try:
-        # Find the OpenGD window
-        hwnd = win32gui.FindWindow(None, "OpenGD")
-        if hwnd == 0:
-            logger.error("OpenGD window not found")
-            return False
-            
-        # Get window dimensions
-        rect = win32gui.GetWindowRect(hwnd)
-        width = rect[2] - rect[0]
-        height = rect[3] - rect[1]
-        
-        # Calculate position (center horizontally, 40% from top vertically)
-        level_x = rect[0] + width // 2
-        level_y = rect[1] + int(height * 0.4)  # Slightly above center
-        
-        # Click at level position
-        win32api.SetCursorPos((level_x, level_y))
-        win32api.mouse_event(win32con.MOUSEEVENTF_LEFTDOWN, 0, 0, 0, 0)
-        time.sleep(0.1)
-        win32api.mouse_event(win32con.MOUSEEVENTF_LEFTUP, 0, 0, 0, 0)
-        
-        logger.info(f"Clicked level {level_number} at ({level_x}, {level_y})")
-        time.sleep(2)  # Wait for level to load
-        
-    except Exception as e:
-        logger.error(f"Failed to click level: {e}")
-        return False
-    return True
-
 if __name__ == "__main__":
     logger.info("=" * 50)
     logger.info("STARTING OPENGD AI TRAINING")
@@ -23,6 +23,10 @@
  ****************************************************************************/
 
 #include "AppDelegate.h"
+#include "Training/EnvServer.h"
+#include "Training/ForkServer.h"
+#include "Training/ReplayVerifier.h"
+#include "Training/TrainingOptions.h"
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -33,6 +37,17 @@ USING_NS_AX;
 
 int main(int argc, char** argv)
 {
+    auto options = TrainingOptions::getInstance();
+    options->parseCommandLine(argc, argv);
+
+    // headless, no window or director is ever created
+    if (!options->_forkServer.empty())
+        return ForkServer::run(options->_forkServer, options->_levelID);
+    if (!options->_envServer.empty())
+        return EnvServer::run(options->_envServer, options->_levelID);
+    if (!options->_verifyReplays.empty())
+        return ReplayVerifier::run(options->_verifyReplays);
+
     // create the application instance
     AppDelegate app;
     return Application::getInstance()->run();
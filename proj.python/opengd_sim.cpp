@@ -0,0 +1,468 @@
+/*************************************************************************
+    OpenGD - Open source Geometry Dash.
+    Copyright (C) 2023  OpenGD Team
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License    
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*************************************************************************/
+
+// opengd_sim: the simulation core as a Python extension. A Simulator is a SimVecEnv, its
+// observations, rewards, dones and grids are exposed through the buffer protocol straight from the
+// native vectors, so numpy.asarray() on them aliases the memory every step writes into.
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Simulation/ObjectData.h"
+#include "Simulation/SimLevel.h"
+#include "Simulation/SimVecEnv.h"
+#include "Training/NeatController.h"
+
+namespace
+{
+struct SimulatorObject
+{
+	PyObject_HEAD
+	SimVecEnv* _env;
+	std::unordered_map<int, GameObjectType>* _objectTypes;
+	// a reset or step is running with the GIL released, only changed with the GIL held
+	bool _busy;
+};
+
+// one of a Simulator's output arrays, keeps the simulator alive as long as anything views it
+struct ArrayObject
+{
+	PyObject_HEAD
+	SimulatorObject* _owner;
+	void* _data;
+	const char* _format;
+	Py_ssize_t _itemSize;
+	int _ndim;
+	Py_ssize_t _shape[3];
+	Py_ssize_t _strides[3];
+};
+
+PyTypeObject ArrayType = {PyVarObject_HEAD_INIT(nullptr, 0)};
+PyTypeObject SimulatorType = {PyVarObject_HEAD_INIT(nullptr, 0)};
+
+int arrayGetBuffer(PyObject* self, Py_buffer* view, int flags)
+{
+	auto array = reinterpret_cast<ArrayObject*>(self);
+
+	view->obj = Py_NewRef(self);
+	view->buf = array->_data;
+	view->itemsize = array->_itemSize;
+	view->len = array->_strides[0] * array->_shape[0];
+	view->readonly = 0;
+	view->ndim = array->_ndim;
+	view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>(array->_format) : nullptr;
+	view->shape = (flags & PyBUF_ND) ? array->_shape : nullptr;
+	view->strides = (flags & PyBUF_STRIDES) ? array->_strides : nullptr;
+	view->suboffsets = nullptr;
+	view->internal = nullptr;
+	return 0;
+}
+
+void arrayDealloc(PyObject* self)
+{
+	Py_XDECREF(reinterpret_cast<ArrayObject*>(self)->_owner);
+	Py_TYPE(self)->tp_free(self);
+}
+
+PyBufferProcs arrayBufferProcs = {arrayGetBuffer, nullptr};
+
+// C ordered, up to three dimensions
+PyObject* makeArray(SimulatorObject* owner, void* data, const char* format, Py_ssize_t itemSize,
+					std::initializer_list<Py_ssize_t> shape)
+{
+	auto array = PyObject_New(ArrayObject, &ArrayType);
+	if (!array)
+		return nullptr;
+
+	array->_owner = owner;
+	Py_INCREF(owner);
+	array->_data = data;
+	array->_format = format;
+	array->_itemSize = itemSize;
+	array->_ndim = static_cast<int>(shape.size());
+	std::copy(shape.begin(), shape.end(), array->_shape);
+
+	Py_ssize_t stride = itemSize;
+	for (int i = array->_ndim - 1; i >= 0; i--)
+	{
+		array->_strides[i] = stride;
+		stride *= array->_shape[i];
+	}
+	return reinterpret_cast<PyObject*>(array);
+}
+
+bool getText(PyObject* object, std::string_view& text)
+{
+	if (PyUnicode_Check(object))
+	{
+		Py_ssize_t size;
+		const char* data = PyUnicode_AsUTF8AndSize(object, &size);
+		if (!data)
+			return false;
+		text = {data, (size_t)size};
+		return true;
+	}
+
+	char* data;
+	Py_ssize_t size;
+	if (PyBytes_AsStringAndSize(object, &data, &size) < 0)
+		return false;
+	text = {data, (size_t)size};
+	return true;
+}
+
+int simulatorInit(PyObject* self, PyObject* args, PyObject* kwargs)
+{
+	auto simulator = reinterpret_cast<SimulatorObject*>(self);
+	static const char* keywords[] = {"objects", "count", "threads", "action_repeat", "max_ticks", "grids", nullptr};
+
+	// Arrays handed out earlier point into the env, it lives as long as the Simulator does
+	if (simulator->_env)
+	{
+		PyErr_SetString(PyExc_RuntimeError, "Simulator is already initialised, create a new one instead");
+		return -1;
+	}
+
+	PyObject* objects;
+	int count;
+	unsigned threads = 0;
+	int actionRepeat = 1;
+	unsigned long long maxTicks = 0;
+	int grids = 0;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Oi|IiKp", const_cast<char**>(keywords), &objects, &count, &threads,
+									 &actionRepeat, &maxTicks, &grids))
+		return -1;
+
+	std::string_view objectJson;
+	if (!getText(objects, objectJson))
+		return -1;
+	if (count < 1)
+	{
+		PyErr_SetString(PyExc_ValueError, "count has to be at least 1");
+		return -1;
+	}
+
+	auto objectTypes = ObjectData::parseObjectTypes(objectJson);
+	if (objectTypes.empty())
+	{
+		PyErr_SetString(PyExc_ValueError, "objects is not an object.json with object types");
+		return -1;
+	}
+
+	simulator->_env = new SimVecEnv(count, threads, actionRepeat, maxTicks, grids);
+	simulator->_objectTypes = new std::unordered_map<int, GameObjectType>(std::move(objectTypes));
+	return 0;
+}
+
+void simulatorDealloc(PyObject* self)
+{
+	auto simulator = reinterpret_cast<SimulatorObject*>(self);
+	delete simulator->_env;
+	delete simulator->_objectTypes;
+	Py_TYPE(self)->tp_free(self);
+}
+
+bool checkInit(SimulatorObject* simulator)
+{
+	if (simulator->_env)
+		return true;
+	PyErr_SetString(PyExc_RuntimeError, "Simulator.__init__ was not called");
+	return false;
+}
+
+// reset and step release the GIL, a second thread calling either on the same Simulator meanwhile
+// would race on its worlds. Taken and given back with the GIL held
+bool beginCall(SimulatorObject* simulator)
+{
+	if (!checkInit(simulator))
+		return false;
+	if (simulator->_busy)
+	{
+		PyErr_SetString(PyExc_RuntimeError, "Simulator is in use by another thread");
+		return false;
+	}
+	simulator->_busy = true;
+	return true;
+}
+
+PyObject* simulatorReset(PyObject* self, PyObject* args, PyObject* kwargs)
+{
+	auto simulator = reinterpret_cast<SimulatorObject*>(self);
+	static const char* keywords[] = {"seed", "level", nullptr};
+
+	unsigned long long seed = 0;
+	PyObject* levelObject = Py_None;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|KO", const_cast<char**>(keywords), &seed, &levelObject))
+		return nullptr;
+
+	const bool hasLevel = levelObject != Py_None;
+	std::string_view levelString;
+	if (hasLevel && !getText(levelObject, levelString))
+		return nullptr;
+	if (!beginCall(simulator))
+		return nullptr;
+	if (!hasLevel && !simulator->_env->hasLevel())
+	{
+		simulator->_busy = false;
+		PyErr_SetString(PyExc_ValueError, "the first reset needs a level");
+		return nullptr;
+	}
+
+	SimVecEnv* env = simulator->_env;
+	const auto& objectTypes = *simulator->_objectTypes;
+	Py_BEGIN_ALLOW_THREADS
+	std::shared_ptr<const SimLevel> level;
+	if (hasLevel)
+		level = SimLevel::createFromString(levelString, objectTypes);
+	env->reset(seed, std::move(level));
+	Py_END_ALLOW_THREADS
+
+	simulator->_busy = false;
+	Py_RETURN_NONE;
+}
+
+PyObject* simulatorStep(PyObject* self, PyObject* actions)
+{
+	auto simulator = reinterpret_cast<SimulatorObject*>(self);
+	if (!checkInit(simulator))
+		return nullptr;
+	if (!simulator->_env->hasLevel())
+	{
+		PyErr_SetString(PyExc_RuntimeError, "reset with a level before stepping");
+		return nullptr;
+	}
+
+	Py_buffer view;
+	if (PyObject_GetBuffer(actions, &view, PyBUF_C_CONTIGUOUS) < 0)
+		return nullptr;
+	if (view.len != simulator->_env->size())
+	{
+		PyBuffer_Release(&view);
+		PyErr_Format(PyExc_ValueError, "expected %d one byte actions, got %zd bytes", simulator->_env->size(),
+					 view.len);
+		return nullptr;
+	}
+	if (!beginCall(simulator))
+	{
+		PyBuffer_Release(&view);
+		return nullptr;
+	}
+
+	SimVecEnv* env = simulator->_env;
+	const auto buttons = static_cast<const uint8_t*>(view.buf);
+	Py_BEGIN_ALLOW_THREADS
+	env->step(buttons);
+	Py_END_ALLOW_THREADS
+
+	simulator->_busy = false;
+	PyBuffer_Release(&view);
+	Py_RETURN_NONE;
+}
+
+PyObject* simulatorObservations(PyObject* self, void*)
+{
+	auto simulator = reinterpret_cast<SimulatorObject*>(self);
+	if (!checkInit(simulator))
+		return nullptr;
+	SimVecEnv* env = simulator->_env;
+	return makeArray(simulator, env->getObservations(), "f", sizeof(float), {env->size(), env->getObservationSize()});
+}
+
+PyObject* simulatorRewards(PyObject* self, void*)
+{
+	auto simulator = reinterpret_cast<SimulatorObject*>(self);
+	if (!checkInit(simulator))
+		return nullptr;
+	return makeArray(simulator, simulator->_env->getRewards(), "f", sizeof(float), {simulator->_env->size()});
+}
+
+PyObject* simulatorDones(PyObject* self, void*)
+{
+	auto simulator = reinterpret_cast<SimulatorObject*>(self);
+	if (!checkInit(simulator))
+		return nullptr;
+	return makeArray(simulator, simulator->_env->getDones(), "?", 1, {simulator->_env->size()});
+}
+
+PyObject* simulatorGrids(PyObject* self, void*)
+{
+	auto simulator = reinterpret_cast<SimulatorObject*>(self);
+	if (!checkInit(simulator))
+		return nullptr;
+	SimVecEnv* env = simulator->_env;
+	if (!env->getGrids())
+		Py_RETURN_NONE;
+	return makeArray(simulator, env->getGrids(), "B", 1, {env->size(), env->getGridHeight(), env->getGridWidth()});
+}
+
+PyObject* simulatorSize(PyObject* self, void*)
+{
+	auto simulator = reinterpret_cast<SimulatorObject*>(self);
+	if (!checkInit(simulator))
+		return nullptr;
+	return PyLong_FromLong(simulator->_env->size());
+}
+
+PyMethodDef simulatorMethods[] = {
+	{"reset", (PyCFunction)(void (*)(void))simulatorReset, METH_VARARGS | METH_KEYWORDS,
+	 "reset(seed=0, level=None)\n\nStart every world over, world i seeded from seed and i. level is an "
+	 "uncompressed level string and replaces the current level, the first reset needs one."},
+	{"step", simulatorStep, METH_O,
+	 "step(actions)\n\nOne byte per world, non zero holds the button. Runs action_repeat ticks with the GIL "
+	 "released, worlds done after the previous step start over first."},
+	{nullptr, nullptr, 0, nullptr},
+};
+
+PyGetSetDef simulatorGetSet[] = {
+	{"observations", simulatorObservations, nullptr,
+	 "float32 [count, observation size]: x, y, y velocity, on ground, dead, gamemode, then the rays", nullptr},
+	{"rewards", simulatorRewards, nullptr, "float32 [count]: x gained during the last step", nullptr},
+	{"dones", simulatorDones, nullptr, "bool [count]: died, completed or ran out of ticks", nullptr},
+	{"grids", simulatorGrids, nullptr,
+	 "uint8 [count, height, width]: occupancy around player 1, bottom row first, 0 empty, 1 solid, 2 hazard, "
+	 "3 pad, ring or portal. None unless made with grids=True",
+	 nullptr},
+	{"count", simulatorSize, nullptr, "number of worlds", nullptr},
+	{nullptr, nullptr, nullptr, nullptr, nullptr},
+};
+
+PyObject* moduleEvaluate(PyObject*, PyObject* args, PyObject* kwargs)
+{
+	static const char* keywords[] = {"objects", "level", "genomes", "max_ticks", "threads", "action_repeat", nullptr};
+
+	PyObject* objects;
+	PyObject* levelObject;
+	PyObject* genomes;
+	int maxTicks;
+	unsigned threads = 0;
+	int actionRepeat = 1;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOOi|Ii", const_cast<char**>(keywords), &objects, &levelObject,
+									 &genomes, &maxTicks, &threads, &actionRepeat))
+		return nullptr;
+
+	std::string_view objectJson, levelString;
+	if (!getText(objects, objectJson) || !getText(levelObject, levelString))
+		return nullptr;
+
+	PyObject* sequence = PySequence_Fast(genomes, "genomes has to be a sequence of genome json");
+	if (!sequence)
+		return nullptr;
+
+	// the texts stay alive in the sequence while the GIL is released
+	Py_ssize_t count = PySequence_Fast_GET_SIZE(sequence);
+	std::vector<std::string_view> genomeJson(count);
+	for (Py_ssize_t i = 0; i < count; i++)
+	{
+		if (!getText(PySequence_Fast_GET_ITEM(sequence, i), genomeJson[i]))
+		{
+			Py_DECREF(sequence);
+			return nullptr;
+		}
+	}
+
+	auto objectTypes = ObjectData::parseObjectTypes(objectJson);
+	if (objectTypes.empty())
+	{
+		Py_DECREF(sequence);
+		PyErr_SetString(PyExc_ValueError, "objects is not an object.json with object types");
+		return nullptr;
+	}
+
+	std::vector<float> fitness;
+	bool loaded = true;
+	Py_BEGIN_ALLOW_THREADS
+	std::vector<NeatNetwork> networks(count);
+	for (Py_ssize_t i = 0; i < count && loaded; i++)
+		loaded = networks[i].loadFromJson(genomeJson[i]);
+	if (loaded && count > 0)
+		fitness = NeatController::evaluate(SimLevel::createFromString(levelString, objectTypes), std::move(networks),
+										   maxTicks, threads, actionRepeat);
+	Py_END_ALLOW_THREADS
+	Py_DECREF(sequence);
+
+	if (!loaded)
+	{
+		PyErr_SetString(PyExc_ValueError, "a genome is not an exported genome, see ai_source/genome_export.py");
+		return nullptr;
+	}
+
+	PyObject* list = PyList_New(count);
+	if (!list)
+		return nullptr;
+	for (Py_ssize_t i = 0; i < count; i++)
+		PyList_SET_ITEM(list, i, PyFloat_FromDouble(fitness[i]));
+	return list;
+}
+
+PyMethodDef moduleMethods[] = {
+	{"evaluate", (PyCFunction)(void (*)(void))moduleEvaluate, METH_VARARGS | METH_KEYWORDS,
+	 "evaluate(objects, level, genomes, max_ticks, threads=0, action_repeat=1)\n\nOne attempt per genome at an "
+	 "uncompressed level, each genome the json genome_export.genome_to_json makes. Returns the furthest x every "
+	 "one reached, 0 for genomes that don't take NeatController's inputs. Runs with the GIL released."},
+	{nullptr, nullptr, 0, nullptr},
+};
+
+PyModuleDef moduleDef = {
+	PyModuleDef_HEAD_INIT, "opengd_sim", "OpenGD's simulation core, many level attempts stepped in parallel", -1,
+	moduleMethods,
+};
+} // namespace
+
+PyMODINIT_FUNC PyInit_opengd_sim()
+{
+	ArrayType.tp_name = "opengd_sim.Array";
+	ArrayType.tp_basicsize = sizeof(ArrayObject);
+	ArrayType.tp_flags = Py_TPFLAGS_DEFAULT;
+	ArrayType.tp_doc = "A Simulator output, use numpy.asarray() on it";
+	ArrayType.tp_dealloc = arrayDealloc;
+	ArrayType.tp_as_buffer = &arrayBufferProcs;
+
+	SimulatorType.tp_name = "opengd_sim.Simulator";
+	SimulatorType.tp_basicsize = sizeof(SimulatorObject);
+	SimulatorType.tp_flags = Py_TPFLAGS_DEFAULT;
+	SimulatorType.tp_doc = "Simulator(objects, count, threads=0, action_repeat=1, max_ticks=0, grids=False)\n\n"
+						   "count worlds playing one level. objects is the text of Content/Custom/object.json. "
+						   "Not for more than one thread at a time, a call while another runs raises RuntimeError";
+	SimulatorType.tp_new = PyType_GenericNew;
+	SimulatorType.tp_init = simulatorInit;
+	SimulatorType.tp_dealloc = simulatorDealloc;
+	SimulatorType.tp_methods = simulatorMethods;
+	SimulatorType.tp_getset = simulatorGetSet;
+
+	if (PyType_Ready(&ArrayType) < 0 || PyType_Ready(&SimulatorType) < 0)
+		return nullptr;
+
+	PyObject* module = PyModule_Create(&moduleDef);
+	if (!module)
+		return nullptr;
+
+	if (PyModule_AddObjectRef(module, "Simulator", reinterpret_cast<PyObject*>(&SimulatorType)) < 0)
+	{
+		Py_DECREF(module);
+		return nullptr;
+	}
+	return module;
+}
@@ -24,6 +24,8 @@
 
 #include "main.h"
 #include "AppDelegate.h"
+#include "Training/ReplayVerifier.h"
+#include "Training/TrainingOptions.h"
 #include "axmol.h"
 
 USING_NS_AX;
@@ -42,11 +44,24 @@ int WINAPI _tWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPTSTR lpCmdL
     freopen("CONOUT$", "w", stderr);
 #endif
 
-    // create the application instance
-    AppDelegate app;
-    int ret = Application::getInstance()->run();
+    // the CRT only fills __argv for narrow builds
+    auto options = TrainingOptions::getInstance();
+    if (__argv)
+        options->parseCommandLine(__argc, __argv);
+
+    // create the application instance, unless only replays are checked
+    int ret;
+    if (!options->_verifyReplays.empty())
+        ret = ReplayVerifier::run(options->_verifyReplays);
+    else
+    {
+        AppDelegate app;
+        ret = Application::getInstance()->run();
+    }
 
 #ifdef USE_WIN32_CONSOLE
     FreeConsole();
 #endif
+
+    return ret;
 }